@@ -0,0 +1,326 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/apriltag/AprilTagPipeline.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "wpi/util/condition_variable.hpp"
+#include "wpi/util/mutex.hpp"
+
+using namespace wpi::apriltag;
+
+// A fixed set of threads that run the iterations of a loop in parallel. The
+// calling thread runs iterations too, as worker 0.
+class AprilTagPipeline::WorkerPool {
+ public:
+  explicit WorkerPool(int numThreads) {
+    for (int i = 1; i < numThreads; ++i) {
+      m_threads.emplace_back([this, i] { ThreadMain(i); });
+    }
+  }
+
+  ~WorkerPool() {
+    {
+      std::scoped_lock lock(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto&& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Calls func(worker, index) for each index in [0, count) and waits for all
+  // of the calls to finish. Calls with the same worker number are never run
+  // concurrently.
+  void Run(int count, std::function<void(int, int)> func) {
+    if (m_threads.empty() || count <= 1) {
+      for (int i = 0; i < count; ++i) {
+        func(0, i);
+      }
+      return;
+    }
+
+    {
+      std::scoped_lock lock(m_mutex);
+      m_func = &func;
+      m_count = count;
+      m_next = 0;
+      m_busy = m_threads.size();
+      ++m_generation;
+    }
+    m_wake.notify_all();
+
+    Work(0);
+
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [&] { return m_busy == 0; });
+    m_func = nullptr;
+  }
+
+ private:
+  void ThreadMain(int worker) {
+    uint64_t generation = 0;
+    std::unique_lock lock(m_mutex);
+    for (;;) {
+      m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+      generation = m_generation;
+      lock.unlock();
+      Work(worker);
+      lock.lock();
+      if (--m_busy == 0) {
+        m_done.notify_one();
+      }
+    }
+  }
+
+  void Work(int worker) {
+    for (int i = m_next++; i < m_count; i = m_next++) {
+      (*m_func)(worker, i);
+    }
+  }
+
+  wpi::util::mutex m_mutex;
+  wpi::util::condition_variable m_wake;
+  wpi::util::condition_variable m_done;
+  std::vector<std::thread> m_threads;
+
+  // Protected by m_mutex; only read by workers between a wakeup and
+  // decrementing m_busy, during which they're not changed
+  std::function<void(int, int)>* m_func = nullptr;
+  int m_count = 0;
+  size_t m_busy = 0;
+  uint64_t m_generation = 0;
+  bool m_stop = false;
+
+  std::atomic_int m_next{0};
+};
+
+AprilTagPipeline::AprilTagPipeline() : AprilTagPipeline{Config{}} {}
+
+AprilTagPipeline::AprilTagPipeline(const Config& config)
+    : m_config{config},
+      m_pool{std::make_unique<WorkerPool>(std::max(config.numThreads, 1))} {
+  if (config.poseEstimator) {
+    m_poseEstimator.emplace(*config.poseEstimator);
+  }
+
+  int numThreads = std::max(config.numThreads, 1);
+  auto detectorConfig = config.detector;
+  detectorConfig.numThreads = 1;
+  m_detectors.reserve(numThreads);
+  for (int i = 0; i < numThreads; ++i) {
+    auto& detector = m_detectors.emplace_back();
+    detector.SetConfig(detectorConfig);
+    detector.SetQuadThresholdParameters(config.quadThresholdParameters);
+  }
+
+  detectorConfig.numThreads = numThreads;
+  detectorConfig.quadDecimate = config.fullFrameDecimate;
+  m_fullFrameDetector.SetConfig(detectorConfig);
+  m_fullFrameDetector.SetQuadThresholdParameters(
+      config.quadThresholdParameters);
+}
+
+AprilTagPipeline::~AprilTagPipeline() = default;
+
+bool AprilTagPipeline::AddFamily(std::string_view fam, int bitsCorrected) {
+  if (!m_fullFrameDetector.AddFamily(fam, bitsCorrected)) {
+    return false;
+  }
+  for (auto&& detector : m_detectors) {
+    detector.AddFamily(fam, bitsCorrected);
+  }
+  return true;
+}
+
+void AprilTagPipeline::RemoveFamily(std::string_view fam) {
+  m_fullFrameDetector.RemoveFamily(fam);
+  for (auto&& detector : m_detectors) {
+    detector.RemoveFamily(fam);
+  }
+  // results may refer to the family name
+  m_results.clear();
+}
+
+void AprilTagPipeline::ClearFamilies() {
+  m_fullFrameDetector.ClearFamilies();
+  for (auto&& detector : m_detectors) {
+    detector.ClearFamilies();
+  }
+  m_results.clear();
+}
+
+void AprilTagPipeline::Reset() {
+  m_rois.clear();
+  m_results.clear();
+  m_framesSinceFullFrame = 0;
+}
+
+std::span<const AprilTagPipeline::Result> AprilTagPipeline::Detect(
+    int width, int height, int stride, uint8_t* buf) {
+  size_t numTracked = m_results.size();
+  m_results.clear();
+
+  // Search around the tags found in the last frame unless it's time for a
+  // full-frame pass, falling back to one if any of the tags were lost
+  bool fullFrame =
+      m_rois.empty() || (m_config.fullFrameInterval > 0 &&
+                         m_framesSinceFullFrame + 1 >=
+                             m_config.fullFrameInterval);
+  if (!fullFrame) {
+    DetectRois(stride, buf);
+    if (m_results.size() < numTracked) {
+      m_results.clear();
+      fullFrame = true;
+    }
+  }
+
+  if (fullFrame) {
+    auto results = m_fullFrameDetector.Detect(width, height, stride, buf);
+    for (auto&& detection : results) {
+      m_results.emplace_back(MakeResult(*detection, 0, 0));
+    }
+    m_framesSinceFullFrame = 0;
+  } else {
+    ++m_framesSinceFullFrame;
+  }
+
+  if (m_poseEstimator) {
+    m_pool->Run(m_results.size(), [&](int, int i) {
+      auto& result = m_results[i];
+      result.pose = m_poseEstimator->EstimateOrthogonalIteration(
+          result.homography, result.corners, m_config.poseIterations);
+    });
+  }
+
+  UpdateRois(width, height);
+  return m_results;
+}
+
+void AprilTagPipeline::DetectRois(int stride, uint8_t* buf) {
+  if (m_roiResults.size() < m_rois.size()) {
+    m_roiResults.resize(m_rois.size());
+  }
+
+  // Regions don't overlap, so a tag can't be found in more than one
+  m_pool->Run(m_rois.size(), [&](int worker, int i) {
+    const auto& roi = m_rois[i];
+    auto& roiResults = m_roiResults[i];
+    roiResults.clear();
+    auto results = m_detectors[worker].Detect(
+        roi.width, roi.height, stride, buf + roi.y * stride + roi.x);
+    for (auto&& detection : results) {
+      roiResults.emplace_back(MakeResult(*detection, roi.x, roi.y));
+    }
+  });
+
+  for (size_t i = 0; i < m_rois.size(); ++i) {
+    m_results.insert(m_results.end(), m_roiResults[i].begin(),
+                     m_roiResults[i].end());
+  }
+}
+
+AprilTagPipeline::Result AprilTagPipeline::MakeResult(
+    const AprilTagDetection& detection, int x, int y) {
+  Result result;
+  result.family = detection.GetFamily();
+  result.id = detection.GetId();
+  result.hamming = detection.GetHamming();
+  result.decisionMargin = detection.GetDecisionMargin();
+
+  // Translate from region to image coordinates. For the homography, this is
+  // premultiplying by the translation matrix.
+  auto homography = detection.GetHomography();
+  std::copy(homography.begin(), homography.end(), result.homography.begin());
+  for (int col = 0; col < 3; ++col) {
+    result.homography[col] += x * homography[6 + col];
+    result.homography[3 + col] += y * homography[6 + col];
+  }
+
+  result.center = detection.GetCenter();
+  result.center.x += x;
+  result.center.y += y;
+
+  detection.GetCorners(result.corners);
+  for (int i = 0; i < 4; ++i) {
+    result.corners[i * 2] += x;
+    result.corners[i * 2 + 1] += y;
+  }
+  return result;
+}
+
+void AprilTagPipeline::UpdateRois(int width, int height) {
+  m_rois.clear();
+  for (auto&& result : m_results) {
+    double minX = result.corners[0];
+    double maxX = minX;
+    double minY = result.corners[1];
+    double maxY = minY;
+    for (int i = 1; i < 4; ++i) {
+      minX = std::min(minX, result.corners[i * 2]);
+      maxX = std::max(maxX, result.corners[i * 2]);
+      minY = std::min(minY, result.corners[i * 2 + 1]);
+      maxY = std::max(maxY, result.corners[i * 2 + 1]);
+    }
+
+    double margin = m_config.roiMargin * std::max(maxX - minX, maxY - minY);
+    double centerX = (minX + maxX) / 2;
+    double centerY = (minY + maxY) / 2;
+    double halfWidth =
+        std::max((maxX - minX) / 2 + margin, m_config.minRoiSize / 2.0);
+    double halfHeight =
+        std::max((maxY - minY) / 2 + margin, m_config.minRoiSize / 2.0);
+
+    int x0 = std::clamp(static_cast<int>(std::floor(centerX - halfWidth)), 0,
+                        width);
+    int y0 = std::clamp(static_cast<int>(std::floor(centerY - halfHeight)), 0,
+                        height);
+    int x1 = std::clamp(static_cast<int>(std::ceil(centerX + halfWidth)), 0,
+                        width);
+    int y1 = std::clamp(static_cast<int>(std::ceil(centerY + halfHeight)), 0,
+                        height);
+    if (x1 > x0 && y1 > y0) {
+      m_rois.push_back({x0, y0, x1 - x0, y1 - y0});
+    }
+  }
+
+  // Merge overlapping regions into their bounding box until none overlap
+  for (bool merged = true; merged;) {
+    merged = false;
+    for (size_t i = 0; i < m_rois.size() && !merged; ++i) {
+      for (size_t j = i + 1; j < m_rois.size(); ++j) {
+        auto& a = m_rois[i];
+        auto& b = m_rois[j];
+        if (a.x < b.x + b.width && b.x < a.x + a.width &&
+            a.y < b.y + b.height && b.y < a.y + a.height) {
+          int x0 = std::min(a.x, b.x);
+          int y0 = std::min(a.y, b.y);
+          int x1 = std::max(a.x + a.width, b.x + b.width);
+          int y1 = std::max(a.y + a.height, b.y + b.height);
+          a = {x0, y0, x1 - x0, y1 - y0};
+          m_rois.erase(m_rois.begin() + j);
+          merged = true;
+          break;
+        }
+      }
+    }
+  }
+}
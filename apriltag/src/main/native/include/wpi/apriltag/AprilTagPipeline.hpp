@@ -0,0 +1,238 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "wpi/apriltag/AprilTagDetection.hpp"
+#include "wpi/apriltag/AprilTagDetector.hpp"
+#include "wpi/apriltag/AprilTagPoseEstimate.hpp"
+#include "wpi/apriltag/AprilTagPoseEstimator.hpp"
+#include "wpi/util/SymbolExports.hpp"
+
+namespace wpi::apriltag {
+
+/**
+ * A detection pipeline for a single camera built on AprilTagDetector.
+ *
+ * Tags found in one frame are tracked into the next: regions of interest
+ * around the previous frame's detections are searched first, in parallel
+ * across a pool of worker threads, which is much cheaper than searching the
+ * whole image. A decimated full-frame pass is done instead when nothing is
+ * being tracked, when a tracked tag is lost, and periodically to pick up new
+ * tags. Pose estimates for the detections are then computed on the same
+ * worker pool.
+ *
+ * Use one pipeline per camera, as the regions of interest are only meaningful
+ * for consecutive frames from the same camera.
+ */
+class WPILIB_DLLEXPORT AprilTagPipeline {
+ public:
+  /** Pipeline configuration. */
+  struct Config {
+    bool operator==(const Config&) const = default;
+
+    /**
+     * How many threads should be used for computation, including the thread
+     * calling Detect(). Default is single-threaded operation (1 thread).
+     */
+    int numThreads = 1;
+
+    /**
+     * Detector configuration used when searching regions of interest. As the
+     * regions are small, a quad decimation of 1 (no decimation) is often
+     * affordable and improves pose accuracy. The number of threads is ignored;
+     * each region is searched by a single thread.
+     */
+    AprilTagDetector::Config detector{};
+
+    /** Quad threshold parameters. */
+    AprilTagDetector::QuadThresholdParameters quadThresholdParameters{};
+
+    /**
+     * Quad decimation used for full-frame passes. Default is 2.0.
+     */
+    float fullFrameDecimate = 2.0f;
+
+    /**
+     * A full-frame pass is done at least once every this many frames so new
+     * tags are found. Zero means only do full-frame passes when nothing is
+     * being tracked or a tracked tag is lost. Default is 10.
+     */
+    int fullFrameInterval = 10;
+
+    /**
+     * Margin added on each side of a tag's bounding box to form the region of
+     * interest for the next frame, as a fraction of the bounding box size.
+     * This needs to cover how far a tag moves between frames. Default is 0.5.
+     */
+    double roiMargin = 0.5;
+
+    /**
+     * Minimum region of interest width and height, in pixels. Default is 64.
+     */
+    int minRoiSize = 64;
+
+    /**
+     * Pose estimator configuration. If set, a pose estimate is computed for
+     * each detection. Default is unset (no pose estimation).
+     */
+    std::optional<AprilTagPoseEstimator::Config> poseEstimator{};
+
+    /**
+     * Number of orthogonal iterations used for pose estimation. Default is 50.
+     */
+    int poseIterations = 50;
+  };
+
+  /**
+   * A tag detection. Unlike AprilTagDetection, this is a copy of the detection
+   * data, with all coordinates in full image pixel coordinates.
+   */
+  struct Result {
+    /**
+     * Decoded family name. Valid as long as the family is registered with the
+     * pipeline.
+     */
+    std::string_view family;
+
+    /** Decoded ID of the tag. */
+    int id;
+
+    /** Number of error bits corrected. */
+    int hamming;
+
+    /** Decision margin; see AprilTagDetection::GetDecisionMargin(). */
+    float decisionMargin;
+
+    /** Homography 3x3 matrix data, in row-major order. */
+    std::array<double, 9> homography;
+
+    /** Center of the detection. */
+    AprilTagDetection::Point center;
+
+    /**
+     * Corner point array (X and Y for each corner in order); see
+     * AprilTagDetection::GetCorners().
+     */
+    std::array<double, 8> corners;
+
+    /** Pose estimate, if pose estimation is enabled. */
+    std::optional<AprilTagPoseEstimate> pose;
+  };
+
+  /**
+   * Creates a pipeline with the default configuration.
+   */
+  AprilTagPipeline();
+
+  /**
+   * Creates a pipeline.
+   *
+   * @param config Configuration
+   */
+  explicit AprilTagPipeline(const Config& config);
+  ~AprilTagPipeline();
+  AprilTagPipeline(const AprilTagPipeline&) = delete;
+  AprilTagPipeline& operator=(const AprilTagPipeline&) = delete;
+
+  /**
+   * Gets pipeline configuration.
+   *
+   * @return Configuration
+   */
+  const Config& GetConfig() const { return m_config; }
+
+  /**
+   * Adds a family of tags to be detected.
+   *
+   * @param fam Family name, e.g. "tag16h5"
+   * @param bitsCorrected Maximum number of bits to correct
+   * @return False if family can't be found
+   */
+  bool AddFamily(std::string_view fam, int bitsCorrected = 2);
+
+  /**
+   * Removes a family of tags from the pipeline.
+   *
+   * @param fam Family name, e.g. "tag16h5"
+   */
+  void RemoveFamily(std::string_view fam);
+
+  /**
+   * Unregister all families.
+   */
+  void ClearFamilies();
+
+  /**
+   * Forgets the tracked regions of interest, so the next frame gets a
+   * full-frame pass. Call this if the next frame isn't a continuation of the
+   * previous one (e.g. the camera was switched).
+   */
+  void Reset();
+
+  /**
+   * Detect tags from an 8-bit grayscale image.
+   *
+   * @param width width of the image
+   * @param height height of the image
+   * @param stride number of bytes between image rows (often the same as width)
+   * @param buf image buffer
+   * @return Detections; valid until the next call to Detect()
+   */
+  std::span<const Result> Detect(int width, int height, int stride,
+                                 uint8_t* buf);
+
+  /**
+   * Detect tags from an 8-bit grayscale image.
+   *
+   * @param width width of the image
+   * @param height height of the image
+   * @param buf image buffer
+   * @return Detections; valid until the next call to Detect()
+   */
+  std::span<const Result> Detect(int width, int height, uint8_t* buf) {
+    return Detect(width, height, width, buf);
+  }
+
+ private:
+  struct Roi {
+    int x;
+    int y;
+    int width;
+    int height;
+  };
+
+  class WorkerPool;
+
+  static Result MakeResult(const AprilTagDetection& detection, int x, int y);
+  void DetectRois(int stride, uint8_t* buf);
+  void UpdateRois(int width, int height);
+
+  Config m_config;
+  std::optional<AprilTagPoseEstimator> m_poseEstimator;
+
+  // Region of interest detectors, one per thread, are single-threaded; the
+  // full-frame detector is separate so its thread count never changes, as
+  // changing it recreates the detector's thread pool.
+  std::vector<AprilTagDetector> m_detectors;
+  AprilTagDetector m_fullFrameDetector;
+  std::unique_ptr<WorkerPool> m_pool;
+
+  std::vector<Roi> m_rois;
+  // Per region of interest, so regions can be searched in parallel
+  std::vector<std::vector<Result>> m_roiResults;
+  std::vector<Result> m_results;
+  int m_framesSinceFullFrame = 0;
+};
+
+}  // namespace wpi::apriltag
@@ -0,0 +1,149 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/apriltag/AprilTagPipeline.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "wpi/apriltag/AprilTagImageGenerator.hpp"
+#include "wpi/units/length.hpp"
+#include "wpi/util/RawFrame.hpp"
+
+using namespace wpi::apriltag;
+
+namespace {
+
+constexpr int kWidth = 640;
+constexpr int kHeight = 480;
+constexpr int kScale = 16;
+
+// A white image with 36h11 tags drawn at the given top left corners
+class TagImage {
+ public:
+  TagImage() : m_buf(kWidth * kHeight, 255) {}
+
+  void Draw(int id, int x, int y) {
+    wpi::util::RawFrame frame;
+    REQUIRE(Generate36h11AprilTagImage(&frame, id));
+    for (int row = 0; row < frame.height * kScale; ++row) {
+      for (int col = 0; col < frame.width * kScale; ++col) {
+        m_buf[(y + row) * kWidth + x + col] = static_cast<uint8_t>(
+            frame.data[(row / kScale) * frame.stride + col / kScale]);
+      }
+    }
+  }
+
+  uint8_t* data() { return m_buf.data(); }
+
+ private:
+  std::vector<uint8_t> m_buf;
+};
+
+std::vector<int> Ids(std::span<const AprilTagPipeline::Result> results) {
+  std::vector<int> ids;
+  for (auto&& result : results) {
+    ids.push_back(result.id);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+}  // namespace
+
+TEST_CASE("AprilTagPipelineTest TracksTags", "[apriltag][pipeline]") {
+  AprilTagPipeline pipeline{{.numThreads = 2, .fullFrameInterval = 0}};
+  REQUIRE(pipeline.AddFamily("tag36h11"));
+
+  TagImage image;
+  image.Draw(1, 40, 40);
+  image.Draw(2, 400, 280);
+
+  auto results = pipeline.Detect(kWidth, kHeight, image.data());
+  REQUIRE(Ids(results) == std::vector<int>{1, 2});
+  std::vector<AprilTagPipeline::Result> fullFrame{results.begin(),
+                                                  results.end()};
+
+  // The second frame is searched in the regions of interest only, and the
+  // results are in full image coordinates
+  results = pipeline.Detect(kWidth, kHeight, image.data());
+  REQUIRE(Ids(results) == std::vector<int>{1, 2});
+  for (auto&& result : results) {
+    auto it = std::find_if(fullFrame.begin(), fullFrame.end(),
+                           [&](auto& r) { return r.id == result.id; });
+    CHECK(result.family == "tag36h11");
+    CHECK(result.center.x == Catch::Approx(it->center.x).margin(1.0));
+    CHECK(result.center.y == Catch::Approx(it->center.y).margin(1.0));
+    for (int i = 0; i < 8; ++i) {
+      CHECK(result.corners[i] == Catch::Approx(it->corners[i]).margin(1.0));
+    }
+  }
+}
+
+TEST_CASE("AprilTagPipelineTest FindsNewTags", "[apriltag][pipeline]") {
+  AprilTagPipeline pipeline{{.fullFrameInterval = 2}};
+  REQUIRE(pipeline.AddFamily("tag36h11"));
+
+  TagImage image;
+  image.Draw(1, 40, 40);
+  REQUIRE(Ids(pipeline.Detect(kWidth, kHeight, image.data())) ==
+          std::vector<int>{1});
+
+  // A new tag outside the tracked region is only found by the next
+  // full-frame pass
+  image.Draw(2, 400, 280);
+  REQUIRE(Ids(pipeline.Detect(kWidth, kHeight, image.data())) ==
+          std::vector<int>{1});
+  REQUIRE(Ids(pipeline.Detect(kWidth, kHeight, image.data())) ==
+          std::vector<int>{1, 2});
+}
+
+TEST_CASE("AprilTagPipelineTest LostTagFallsBack", "[apriltag][pipeline]") {
+  AprilTagPipeline pipeline{{.fullFrameInterval = 0}};
+  REQUIRE(pipeline.AddFamily("tag36h11"));
+
+  TagImage image;
+  image.Draw(1, 40, 40);
+  REQUIRE(Ids(pipeline.Detect(kWidth, kHeight, image.data())) ==
+          std::vector<int>{1});
+
+  // Moving the tag out of its region falls back to a full-frame pass
+  TagImage moved;
+  moved.Draw(1, 400, 280);
+  auto results = pipeline.Detect(kWidth, kHeight, moved.data());
+  REQUIRE(Ids(results) == std::vector<int>{1});
+  CHECK(results[0].center.x > 400);
+}
+
+TEST_CASE("AprilTagPipelineTest EstimatesPoses", "[apriltag][pipeline]") {
+  AprilTagPoseEstimator::Config estimatorConfig{
+      .tagSize = 0.1651_m, .fx = 500, .fy = 500, .cx = 320, .cy = 240};
+  AprilTagPipeline pipeline{{.numThreads = 2,
+                             .fullFrameInterval = 0,
+                             .poseEstimator = estimatorConfig}};
+  REQUIRE(pipeline.AddFamily("tag36h11"));
+
+  TagImage image;
+  image.Draw(1, 40, 40);
+  image.Draw(2, 400, 280);
+
+  AprilTagPoseEstimator estimator{estimatorConfig};
+  // Full-frame pass, then regions of interest
+  for (int frame = 0; frame < 2; ++frame) {
+    auto results = pipeline.Detect(kWidth, kHeight, image.data());
+    REQUIRE(results.size() == 2);
+    for (auto&& result : results) {
+      REQUIRE(result.pose);
+      auto expected = estimator.EstimateOrthogonalIteration(
+          result.homography, result.corners, 50);
+      CHECK(result.pose->pose1 == expected.pose1);
+      CHECK(result.pose->error1 == expected.error1);
+    }
+  }
+}
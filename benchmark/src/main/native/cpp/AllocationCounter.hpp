@@ -0,0 +1,34 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <benchmark/benchmark.h>
+
+#include "wpi/util/AllocationCounter.hpp"
+
+/**
+ * Counts the heap allocations made during a benchmark and reports them as an
+ * "allocations" counter averaged over the iterations.
+ */
+class AllocationCounter {
+ public:
+  explicit AllocationCounter(benchmark::State& state)
+      : m_state{state}, m_start{wpi::util::GetAllocationCount()} {}
+
+  ~AllocationCounter() {
+    m_state.counters["allocations"] = benchmark::Counter(
+        static_cast<double>(wpi::util::GetAllocationCount() - m_start),
+        benchmark::Counter::kAvgIterations);
+  }
+
+  AllocationCounter(const AllocationCounter&) = delete;
+  AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+ private:
+  benchmark::State& m_state;
+  size_t m_start;
+};
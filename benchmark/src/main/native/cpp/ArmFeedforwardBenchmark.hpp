@@ -0,0 +1,29 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.hpp"
+#include "wpi/math/controller/ArmFeedforward.hpp"
+#include "wpi/units/angle.hpp"
+#include "wpi/units/angular_acceleration.hpp"
+#include "wpi/units/angular_velocity.hpp"
+#include "wpi/units/time.hpp"
+#include "wpi/units/voltage.hpp"
+
+inline void BM_ArmFeedforward_Calculate(benchmark::State& state) {
+  wpi::math::ArmFeedforward armFF{0.5_V, 1_V, 1.5_V / 1_rad_per_s,
+                                  2_V / 1_rad_per_s_sq, 1_ms};
+  auto angle = 1_rad;
+  auto velocity = 1_rad_per_s;
+
+  AllocationCounter allocations{state};
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        armFF.Calculate(angle, velocity, velocity + 0.05_rad_per_s));
+  }
+}
@@ -4,10 +4,37 @@
 
 #include <benchmark/benchmark.h>
 
+#include "ArmFeedforwardBenchmark.hpp"
 #include "CartPoleBenchmark.hpp"
+#include "SplineParameterizerBenchmark.hpp"
+#include "SynchronizationBenchmark.hpp"
+#include "TelemetryTableBenchmark.hpp"
+#include "TimeInterpolatableBufferBenchmark.hpp"
 #include "TravelingSalesmanBenchmark.hpp"
+#include "UnscentedKalmanFilterBenchmark.hpp"
 
+BENCHMARK(BM_ArmFeedforward_Calculate);
 BENCHMARK(BM_CartPole);
+BENCHMARK(BM_MerweUKF);
+BENCHMARK(BM_MerweUKF_Batched);
+BENCHMARK(BM_S3UKF);
+BENCHMARK(BM_S3UKF_Batched);
+BENCHMARK(BM_SplineParameterizer_Full);
+BENCHMARK(BM_SplineParameterizer_Incremental);
+BENCHMARK(BM_Synchronization_DisjointSetWait)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK(BM_Synchronization_DisjointPingPong)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK(BM_TelemetryTable_LogByName);
+BENCHMARK(BM_TelemetryTable_LogByKey);
+BENCHMARK(BM_TimeInterpolatableBuffer_AddSample);
+BENCHMARK(BM_TimeInterpolatableBuffer_Sample);
+BENCHMARK(BM_TravelingSalesman_Parallel)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
 BENCHMARK(BM_TravelingSalesman_Transform);
 BENCHMARK(BM_TravelingSalesman_Twist);
 
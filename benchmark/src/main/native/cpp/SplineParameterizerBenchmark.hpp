@@ -0,0 +1,57 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "wpi/math/geometry/Pose2d.hpp"
+#include "wpi/math/spline/IncrementalSplineParameterizer.hpp"
+#include "wpi/math/spline/SplineHelper.hpp"
+#include "wpi/math/trajectory/DrivetrainSplineTrajectoryGenerator.hpp"
+#include "wpi/units/angle.hpp"
+#include "wpi/units/length.hpp"
+
+// A path across the field where only the last waypoint moves between
+// regenerations, like a path to a target that's tracked during teleop.
+inline std::vector<wpi::math::Pose2d> SplineParameterizerWaypoints(
+    int iteration) {
+  return {wpi::math::Pose2d{0_m, 0_m, 0_deg},
+          wpi::math::Pose2d{2_m, 1_m, 45_deg},
+          wpi::math::Pose2d{4_m, 3_m, 0_deg},
+          wpi::math::Pose2d{6_m, 3_m, 0_deg},
+          wpi::math::Pose2d{8_m, 2_m, -45_deg},
+          wpi::math::Pose2d{10_m, 0_m, 0_deg},
+          wpi::math::Pose2d{12_m, 0_m + (iteration % 2) * 0.1_m, 0_deg}};
+}
+
+inline void BM_SplineParameterizer_Full(benchmark::State& state) {
+  int iteration = 0;
+
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    auto splines = wpi::math::SplineHelper::QuinticSplinesFromWaypoints(
+        SplineParameterizerWaypoints(iteration++));
+    auto points =
+        wpi::math::DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(
+            splines);
+    benchmark::DoNotOptimize(points);
+  }
+}
+
+inline void BM_SplineParameterizer_Incremental(benchmark::State& state) {
+  wpi::math::IncrementalSplineParameterizer<5> parameterizer;
+  std::vector<wpi::math::SplineParameterizer::PoseWithCurvature> points;
+  int iteration = 0;
+
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    auto splines = wpi::math::SplineHelper::QuinticSplinesFromWaypoints(
+        SplineParameterizerWaypoints(iteration++));
+    parameterizer.SplinePointsFromSplines(splines, points);
+    benchmark::DoNotOptimize(points);
+  }
+}
@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "wpi/util/Synchronization.hpp"
+
+// Each thread signals and waits on its own event, as independent listener
+// pollers and notifiers do. The handles are disjoint, so any slowdown as
+// threads are added is contention inside the synchronization implementation.
+inline void BM_Synchronization_DisjointSetWait(benchmark::State& state) {
+  auto event = wpi::util::MakeEvent();
+
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    wpi::util::SetEvent(event);
+    benchmark::DoNotOptimize(wpi::util::WaitForObject(event));
+  }
+
+  wpi::util::DestroyEvent(event);
+}
+
+// Each thread wakes a partner thread blocked on its own event and waits to be
+// woken back, so every iteration goes through a blocking wait and a wakeup.
+inline void BM_Synchronization_DisjointPingPong(benchmark::State& state) {
+  auto ping = wpi::util::MakeEvent();
+  auto pong = wpi::util::MakeEvent();
+  // waiting fails once ping is destroyed
+  std::thread partner{[&] {
+    while (wpi::util::WaitForObject(ping)) {
+      wpi::util::SetEvent(pong);
+    }
+  }};
+
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    wpi::util::SetEvent(ping);
+    wpi::util::WaitForObject(pong);
+  }
+
+  wpi::util::DestroyEvent(ping);
+  partner.join();
+  wpi::util::DestroyEvent(pong);
+}
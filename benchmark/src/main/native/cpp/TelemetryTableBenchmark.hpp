@@ -0,0 +1,45 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "wpi/telemetry/DiscardTelemetryBackend.hpp"
+#include "wpi/telemetry/TelemetryRegistry.hpp"
+#include "wpi/telemetry/TelemetryTable.hpp"
+
+// A discard backend keeps the backend cost constant, so these measure the
+// per-call overhead of finding the entry for a name.
+inline wpi::telemetry::TelemetryTable& SetupTelemetryTableBenchmark() {
+  wpi::telemetry::TelemetryRegistry::Reset();
+  wpi::telemetry::TelemetryRegistry::RegisterBackend(
+      "", std::make_shared<wpi::telemetry::DiscardTelemetryBackend>());
+  return wpi::telemetry::TelemetryRegistry::GetTable("/benchmark/");
+}
+
+inline void BM_TelemetryTable_LogByName(benchmark::State& state) {
+  auto& table = SetupTelemetryTableBenchmark();
+  double value = 0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    table.Log("drivetrain/leftVelocity", value);
+    value += 1;
+  }
+  wpi::telemetry::TelemetryRegistry::Reset();
+}
+
+inline void BM_TelemetryTable_LogByKey(benchmark::State& state) {
+  auto& table = SetupTelemetryTableBenchmark();
+  wpi::telemetry::TelemetryTable::Key key{"drivetrain/leftVelocity"};
+  double value = 0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    table.Log(key, value);
+    value += 1;
+  }
+  wpi::telemetry::TelemetryRegistry::Reset();
+}
@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "wpi/math/geometry/Pose2d.hpp"
+#include "wpi/math/interpolation/TimeInterpolatableBuffer.hpp"
+#include "wpi/units/time.hpp"
+
+// Matches how the pose estimators use the buffer: odometry updates at 250 Hz
+// with a 1.5 s history window.
+inline constexpr wpi::units::second_t kTimeInterpolatableBufferHistory = 1.5_s;
+inline constexpr wpi::units::second_t kTimeInterpolatableBufferPeriod = 4_ms;
+
+inline void BM_TimeInterpolatableBuffer_AddSample(benchmark::State& state) {
+  wpi::math::TimeInterpolatableBuffer<wpi::math::Pose2d> buffer{
+      kTimeInterpolatableBufferHistory};
+  wpi::units::second_t time = 0_s;
+  wpi::math::Pose2d pose;
+
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    buffer.AddSample(time, pose);
+    time += kTimeInterpolatableBufferPeriod;
+  }
+}
+
+inline void BM_TimeInterpolatableBuffer_Sample(benchmark::State& state) {
+  wpi::math::TimeInterpolatableBuffer<wpi::math::Pose2d> buffer{
+      kTimeInterpolatableBufferHistory};
+  wpi::units::second_t time = 0_s;
+  for (; time < 2 * kTimeInterpolatableBufferHistory;
+       time += kTimeInterpolatableBufferPeriod) {
+    buffer.AddSample(time, wpi::math::Pose2d{time.value() * 1_m, 0_m, 0_rad});
+  }
+
+  // Sample between stored timestamps, as a latency-compensated vision
+  // measurement would
+  wpi::units::second_t sampleTime = time -
+                                    kTimeInterpolatableBufferHistory / 2 -
+                                    kTimeInterpolatableBufferPeriod / 2;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buffer.Sample(sampleTime));
+  }
+}
@@ -40,3 +40,20 @@ inline void BM_TravelingSalesman_Twist(benchmark::State& state) {
     traveler.Solve(poses, iterations);
   }
 }
+
+// Runs state.range(0) independent chains, so the wall time shows how well the
+// chains spread across cores.
+inline void BM_TravelingSalesman_Parallel(benchmark::State& state) {
+  wpi::math::TravelingSalesman traveler{[](auto pose1, auto pose2) {
+    auto transform = pose2 - pose1;
+    return wpi::units::math::hypot(transform.X(), transform.Y()).value();
+  }};
+  int chains = static_cast<int>(state.range(0));
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    traveler.Solve(poses, iterations, chains, 0);
+  }
+  state.counters["chains/s"] =
+      benchmark::Counter{static_cast<double>(chains),
+                         benchmark::Counter::kIsIterationInvariantRate};
+}
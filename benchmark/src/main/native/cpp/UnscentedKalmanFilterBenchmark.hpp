@@ -0,0 +1,106 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "wpi/math/estimator/MerweUKF.hpp"
+#include "wpi/math/estimator/S3UKF.hpp"
+#include "wpi/math/linalg/EigenCore.hpp"
+#include "wpi/math/util/StateSpaceUtil.hpp"
+#include "wpi/units/time.hpp"
+
+// Differential drive with states [x, y, heading, left velocity, right
+// velocity] and inputs [left voltage, right voltage]. Each column of x is a
+// separate state, so one call covers every sigma point.
+template <int Cols>
+void UKFDriveDynamicsBatch(const wpi::math::Matrixd<5, Cols>& x,
+                           const wpi::math::Vectord<2>& u,
+                           wpi::math::Matrixd<5, Cols>& xdot) {
+  constexpr double trackwidth = 0.7;  // m
+  constexpr double A1 = -1.5;
+  constexpr double A2 = 0.25;
+  constexpr double B1 = 0.6;
+  constexpr double B2 = -0.1;
+
+  auto heading = x.row(2).array();
+  auto vl = x.row(3).array();
+  auto vr = x.row(4).array();
+  auto v = 0.5 * (vl + vr);
+
+  xdot.row(0) = v * heading.cos();
+  xdot.row(1) = v * heading.sin();
+  xdot.row(2) = (vr - vl) / trackwidth;
+  xdot.row(3) = A1 * vl + A2 * vr + B1 * u(0) + B2 * u(1);
+  xdot.row(4) = A2 * vl + A1 * vr + B2 * u(0) + B1 * u(1);
+}
+
+// Measures [heading, left velocity, right velocity]
+template <int Cols>
+void UKFDriveMeasurementBatch(const wpi::math::Matrixd<5, Cols>& x,
+                              [[maybe_unused]] const wpi::math::Vectord<2>& u,
+                              wpi::math::Matrixd<3, Cols>& y) {
+  y = x.template bottomRows<3>();
+}
+
+inline wpi::math::Vectord<5> UKFDriveDynamics(const wpi::math::Vectord<5>& x,
+                                              const wpi::math::Vectord<2>& u) {
+  wpi::math::Vectord<5> xdot;
+  UKFDriveDynamicsBatch<1>(x, u, xdot);
+  return xdot;
+}
+
+inline wpi::math::Vectord<3> UKFDriveMeasurement(
+    const wpi::math::Vectord<5>& x, const wpi::math::Vectord<2>& u) {
+  wpi::math::Vectord<3> y;
+  UKFDriveMeasurementBatch<1>(x, u, y);
+  return y;
+}
+
+// Runs one Predict() and Correct() per iteration, evaluating the models one
+// sigma point at a time or with every sigma point at once.
+template <typename Observer, bool Batched>
+void UnscentedKalmanFilterBenchmark(benchmark::State& state) {
+  constexpr wpi::units::second_t dt = 5_ms;
+  constexpr int NumSigmas = Observer::NumSigmas;
+
+  Observer observer{UKFDriveDynamics, UKFDriveMeasurement,
+                    wpi::util::array{0.5, 0.5, 10.0, 1.0, 1.0},
+                    wpi::util::array{0.0001, 0.01, 0.01}, dt};
+  observer.SetP(wpi::math::Vectord<5>{0.01, 0.01, 0.01, 0.1, 0.1}.asDiagonal());
+
+  wpi::math::Vectord<2> u{12.0, 11.0};
+  wpi::math::Vectord<3> y{0.1, 1.0, 1.1};
+  auto R = wpi::math::CovarianceMatrix(0.0001, 0.01, 0.01);
+
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    if constexpr (Batched) {
+      observer.Predict(u, dt, UKFDriveDynamicsBatch<NumSigmas>);
+      observer.template Correct<3>(u, y, UKFDriveMeasurementBatch<NumSigmas>,
+                                   R);
+    } else {
+      observer.Predict(u, dt);
+      observer.template Correct<3>(u, y, UKFDriveMeasurement, R);
+    }
+    benchmark::DoNotOptimize(observer);
+  }
+}
+
+inline void BM_S3UKF(benchmark::State& state) {
+  UnscentedKalmanFilterBenchmark<wpi::math::S3UKF<5, 2, 3>, false>(state);
+}
+
+inline void BM_S3UKF_Batched(benchmark::State& state) {
+  UnscentedKalmanFilterBenchmark<wpi::math::S3UKF<5, 2, 3>, true>(state);
+}
+
+inline void BM_MerweUKF(benchmark::State& state) {
+  UnscentedKalmanFilterBenchmark<wpi::math::MerweUKF<5, 2, 3>, false>(state);
+}
+
+inline void BM_MerweUKF_Batched(benchmark::State& state) {
+  UnscentedKalmanFilterBenchmark<wpi::math::MerweUKF<5, 2, 3>, true>(state);
+}
@@ -882,7 +882,13 @@ public class CameraServerJNI {
     /** kSourceBytesReceived. */
     kSourceBytesReceived(1),
     /** kSourceFramesReceived. */
-    kSourceFramesReceived(2);
+    kSourceFramesReceived(2),
+    /** kSourcePoolHits. */
+    kSourcePoolHits(3),
+    /** kSourcePoolMisses. */
+    kSourcePoolMisses(4),
+    /** kSourcePoolBytes. */
+    kSourcePoolBytes(5);
 
     private final int value;
 
@@ -12,6 +12,7 @@
 #include <opencv2/imgproc/imgproc.hpp>
 
 #include "Instance.hpp"
+#include "PixelConvert.hpp"
 #include "SourceImpl.hpp"
 #include "wpi/util/PixelFormat.hpp"
 
@@ -463,7 +464,9 @@ Image* Frame::ConvertYUYVToGray(Image* image) {
                                 image->height, image->width * image->height);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_YUV2GRAY_YUYV);
+  ConvertYUV422ToGray(reinterpret_cast<const uint8_t*>(image->data()),
+                      reinterpret_cast<uint8_t*>(newImage->data()),
+                      image->width, image->height, 0);
 
   // Save the result
   Image* rv = newImage.release();
@@ -507,7 +510,9 @@ Image* Frame::ConvertUYVYToGray(Image* image) {
                                 image->height, image->width * image->height);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_YUV2GRAY_UYVY);
+  ConvertYUV422ToGray(reinterpret_cast<const uint8_t*>(image->data()),
+                      reinterpret_cast<uint8_t*>(newImage->data()),
+                      image->width, image->height, 1);
 
   // Save the result
   Image* rv = newImage.release();
@@ -767,6 +772,13 @@ Image* Frame::GetImageImpl(int width, int height,
     cur = ConvertMJPEGToBGR(cur);
   }
 
+  // Packed YUV at half resolution is converted and downscaled in one pass
+  // instead of resizing and then converting the full frame
+  if (Image* half = ConvertYUV422HalfImpl(cur, width, height, pixelFormat)) {
+    return ConvertImpl(half, pixelFormat, requiredJpegQuality,
+                       defaultJpegQuality);
+  }
+
   // Resize
   if (!cur->Is(width, height)) {
     // Allocate an image.
@@ -787,6 +799,58 @@ Image* Frame::GetImageImpl(int width, int height,
   return ConvertImpl(cur, pixelFormat, requiredJpegQuality, defaultJpegQuality);
 }
 
+Image* Frame::ConvertYUV422HalfImpl(Image* image, int width, int height,
+                                    wpi::util::PixelFormat pixelFormat) {
+  int yOffset;
+  if (image->pixelFormat == wpi::util::PixelFormat::YUYV) {
+    yOffset = 0;
+  } else if (image->pixelFormat == wpi::util::PixelFormat::UYVY) {
+    yOffset = 1;
+  } else {
+    return nullptr;
+  }
+  if (width * 2 != image->width || height * 2 != image->height) {
+    return nullptr;
+  }
+
+  // Grayscale outputs only need the luma; every other output is converted
+  // from BGR
+  bool gray;
+  switch (pixelFormat) {
+    case wpi::util::PixelFormat::GRAY:
+    case wpi::util::PixelFormat::Y16:
+      gray = true;
+      break;
+    case wpi::util::PixelFormat::BGR:
+    case wpi::util::PixelFormat::BGRA:
+    case wpi::util::PixelFormat::RGB565:
+    case wpi::util::PixelFormat::MJPEG:
+      gray = false;
+      break;
+    default:
+      return nullptr;  // Unsupported
+  }
+
+  auto src = reinterpret_cast<const uint8_t*>(image->data());
+  std::unique_ptr<Image> newImage;
+  if (gray) {
+    newImage = m_impl->source.AllocImage(wpi::util::PixelFormat::GRAY, width,
+                                         height, width * height);
+    ConvertYUV422ToGrayHalf(src, reinterpret_cast<uint8_t*>(newImage->data()),
+                            image->width, image->height, yOffset);
+  } else {
+    newImage = m_impl->source.AllocImage(wpi::util::PixelFormat::BGR, width,
+                                         height, width * height * 3);
+    ConvertYUV422ToBGRHalf(src, reinterpret_cast<uint8_t*>(newImage->data()),
+                           image->width, image->height, yOffset);
+  }
+
+  // Save the result
+  Image* rv = newImage.release();
+  m_impl->images.push_back(rv);
+  return rv;
+}
+
 bool Frame::GetCv(cv::Mat& image, int width, int height,
                   wpi::util::PixelFormat pixelFormat) {
   Image* rawImage = GetImage(width, height, pixelFormat);
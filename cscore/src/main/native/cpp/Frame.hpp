@@ -240,6 +240,8 @@ class Frame {
                      int requiredJpegQuality, int defaultJpegQuality);
   Image* GetImageImpl(int width, int height, wpi::util::PixelFormat pixelFormat,
                       int requiredJpegQuality, int defaultJpegQuality);
+  Image* ConvertYUV422HalfImpl(Image* image, int width, int height,
+                               wpi::util::PixelFormat pixelFormat);
   void DecRef() {
     if (m_impl && --(m_impl->refcount) == 0) {
       ReleaseFrame();
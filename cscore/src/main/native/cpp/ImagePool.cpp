@@ -0,0 +1,128 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ImagePool.hpp"
+
+#include <bit>
+#include <memory>
+#include <utility>
+
+using namespace wpi::cs;
+
+ImagePool::~ImagePool() {
+  Clear();
+}
+
+size_t ImagePool::ClassSize(int sizeClass) {
+  if (sizeClass == 0) {
+    return size_t{1} << kMinClassShift;
+  }
+  int shift = kMinClassShift + (sizeClass - 1) / kStepsPerShift;
+  size_t step = (size_t{1} << shift) / kStepsPerShift;
+  return (size_t{1} << shift) + ((sizeClass - 1) % kStepsPerShift + 1) * step;
+}
+
+int ImagePool::AllocClass(size_t size) {
+  if (size <= (size_t{1} << kMinClassShift)) {
+    return 0;
+  }
+  // 2^shift < size <= 2^(shift + 1)
+  int shift = std::bit_width(size - 1) - 1;
+  size_t step = (size_t{1} << shift) / kStepsPerShift;
+  size_t steps = ((size - (size_t{1} << shift)) + step - 1) / step;
+  int sizeClass =
+      (shift - kMinClassShift) * kStepsPerShift + static_cast<int>(steps);
+  return sizeClass < kNumClasses ? sizeClass : -1;
+}
+
+int ImagePool::ReleaseClass(size_t capacity) {
+  if (capacity < (size_t{1} << kMinClassShift)) {
+    return -1;
+  }
+  // 2^shift <= capacity < 2^(shift + 1)
+  int shift = std::bit_width(capacity) - 1;
+  size_t step = (size_t{1} << shift) / kStepsPerShift;
+  size_t steps = (capacity - (size_t{1} << shift)) / step;
+  int sizeClass =
+      (shift - kMinClassShift) * kStepsPerShift + static_cast<int>(steps);
+  return sizeClass < kNumClasses ? sizeClass : -1;
+}
+
+std::unique_ptr<Image> ImagePool::TryTake(int sizeClass) {
+  for (auto& slot : m_slots[sizeClass]) {
+    // cheap check first to avoid dirtying the cache line of empty slots
+    if (slot.load(std::memory_order_relaxed) == nullptr) {
+      continue;
+    }
+    if (Image* image = slot.exchange(nullptr, std::memory_order_acquire)) {
+      m_bytesPooled.fetch_sub(image->capacity(), std::memory_order_relaxed);
+      return std::unique_ptr<Image>{image};
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<Image> ImagePool::Alloc(size_t size) {
+  int sizeClass = AllocClass(size);
+  if (sizeClass < 0) {
+    // too large to pool
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return std::make_unique<Image>(size);
+  }
+
+  // Look in the next class up too, so a slightly larger image can be reused
+  // rather than allocating
+  for (int i = sizeClass; i < kNumClasses && i <= sizeClass + 1; ++i) {
+    if (auto image = TryTake(i)) {
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+      return image;
+    }
+  }
+
+  // Round the capacity up to the class size so the image is reusable for any
+  // size in its class once it's released
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+  return std::make_unique<Image>(ClassSize(sizeClass));
+}
+
+void ImagePool::Release(std::unique_ptr<Image> image) {
+  int sizeClass = ReleaseClass(image->capacity());
+  if (sizeClass < 0) {
+    return;
+  }
+
+  size_t capacity = image->capacity();
+  Image* expected = nullptr;
+  for (auto& slot : m_slots[sizeClass]) {
+    if (slot.load(std::memory_order_relaxed) != nullptr) {
+      continue;
+    }
+    if (slot.compare_exchange_strong(expected, image.get(),
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+      image.release();
+      m_bytesPooled.fetch_add(capacity, std::memory_order_relaxed);
+      return;
+    }
+    expected = nullptr;
+  }
+  // class is full; let the image be freed
+}
+
+void ImagePool::Clear() {
+  for (auto& slots : m_slots) {
+    for (auto& slot : slots) {
+      if (Image* image = slot.exchange(nullptr, std::memory_order_acquire)) {
+        m_bytesPooled.fetch_sub(image->capacity(), std::memory_order_relaxed);
+        delete image;
+      }
+    }
+  }
+}
+
+ImagePool::Stats ImagePool::TakeStats() {
+  return {m_hits.exchange(0, std::memory_order_relaxed),
+          m_misses.exchange(0, std::memory_order_relaxed),
+          m_bytesPooled.load(std::memory_order_relaxed)};
+}
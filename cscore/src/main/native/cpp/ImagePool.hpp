@@ -0,0 +1,76 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "Image.hpp"
+
+namespace wpi::cs {
+
+// Pool of image buffers bucketed into size classes.  Each size class holds a
+// fixed number of slots that are claimed and filled with atomic exchanges, so
+// allocating and releasing images never blocks; sink threads releasing frames
+// don't contend with the source thread allocating them.
+class ImagePool {
+ public:
+  // Counters since the last call to TakeStats(), except for bytesPooled, which
+  // is the total capacity of the images currently in the pool.
+  struct Stats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t bytesPooled = 0;
+  };
+
+  ImagePool() = default;
+  ~ImagePool();
+
+  ImagePool(const ImagePool&) = delete;
+  ImagePool& operator=(const ImagePool&) = delete;
+
+  // Gets an image with a capacity of at least the given size from the pool,
+  // or allocates one if none is available.  The image's size is not set.
+  std::unique_ptr<Image> Alloc(size_t size);
+
+  // Returns an image to the pool.  The image is freed if its size class is
+  // full or it's too small or too large to pool.
+  void Release(std::unique_ptr<Image> image);
+
+  // Frees every image in the pool.
+  void Clear();
+
+  Stats TakeStats();
+
+ private:
+  // Sizes are rounded up to one of four steps per power of two, so at most a
+  // quarter of a pooled buffer goes unused.
+  static constexpr int kMinClassShift = 12;
+  static constexpr int kStepsPerShift = 4;
+  static constexpr int kNumClasses = 64;
+  static constexpr int kSlotsPerClass = 4;
+
+  static size_t ClassSize(int sizeClass);
+  // Smallest class whose images can hold the given size, or -1 if none
+  static int AllocClass(size_t size);
+  // Largest class whose size is no more than the given capacity, or -1 if the
+  // capacity is too small or too large to pool
+  static int ReleaseClass(size_t capacity);
+
+  std::unique_ptr<Image> TryTake(int sizeClass);
+
+  std::array<std::array<std::atomic<Image*>, kSlotsPerClass>, kNumClasses>
+      m_slots{};
+
+  std::atomic<int64_t> m_hits{0};
+  std::atomic<int64_t> m_misses{0};
+  std::atomic<int64_t> m_bytesPooled{0};
+};
+
+}  // namespace wpi::cs
@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "MjpegPart.hpp"
+
+#include <string>
+#include <string_view>
+
+#include "Image.hpp"
+#include "JpegUtil.hpp"
+#include "wpi/util/fmt/raw_ostream.hpp"
+#include "wpi/util/raw_ostream.hpp"
+
+using namespace wpi::cs;
+
+bool wpi::cs::BuildMjpegPart(std::string_view boundary, const Image& image,
+                             double timestamp, MjpegPart* part) {
+  if (image.pixelFormat != wpi::util::PixelFormat::MJPEG) {
+    return false;
+  }
+
+  const char* data = image.data();
+  size_t size = image.size();
+  size_t locSOF = size;
+  // Determine if we need to add DHT to it; size is updated to include it
+  bool addDHT = JpegNeedsDHT(data, &size, &locSOF);
+
+  // print the individual mimetype and the length
+  // sending the content-length fixes random stream disruption observed
+  // with firefox
+  part->prefix.clear();
+  wpi::util::raw_string_ostream oss{part->prefix};
+  oss << "\r\n--" << boundary << "\r\n" << "Content-Type: image/jpeg\r\n";
+  wpi::util::print(oss, "Content-Length: {}\r\n", size);
+  wpi::util::print(oss, "X-Timestamp: {}\r\n", timestamp);
+  oss << "\r\n";
+  if (addDHT) {
+    // Insert DHT data immediately before SOF
+    oss << std::string_view(data, locSOF);
+    oss << JpegGetDHT();
+    part->body = std::string_view(data + locSOF, image.size() - locSOF);
+  } else {
+    part->body = image.str();
+  }
+  oss.flush();
+  return true;
+}
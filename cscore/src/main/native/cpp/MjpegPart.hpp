@@ -0,0 +1,31 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace wpi::cs {
+
+class Image;
+
+// A part of an MJPEG stream, split so the JPEG data isn't copied.  Sending the
+// prefix followed by the body sends the boundary, the part headers, and the
+// image with a DHT inserted if it's missing one.
+struct MjpegPart {
+  // Boundary, part headers, and if a DHT was inserted, the image data before
+  // the SOF followed by the DHT
+  std::string prefix;
+  // The rest of the image data; points into the image, so is only valid as
+  // long as the image is
+  std::string_view body;
+};
+
+// Builds the stream part for an MJPEG image.  The timestamp is in seconds.
+// Returns false if the image isn't MJPEG.
+bool BuildMjpegPart(std::string_view boundary, const Image& image,
+                    double timestamp, MjpegPart* part);
+
+}  // namespace wpi::cs
@@ -8,11 +8,13 @@
 #include <format>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "Instance.hpp"
-#include "JpegUtil.hpp"
 #include "Log.hpp"
+#include "MjpegPart.hpp"
 #include "Notifier.hpp"
 #include "SourceImpl.hpp"
 #include "c_util.hpp"
@@ -24,6 +26,7 @@
 #include "wpi/util/SmallString.hpp"
 #include "wpi/util/StringExtras.hpp"
 #include "wpi/util/fmt/raw_ostream.hpp"
+#include "wpi/util/mutex.hpp"
 #include "wpi/util/string.hpp"
 
 using namespace wpi::cs;
@@ -75,10 +78,90 @@ static const char* startRootPage =
     "<div class=\"settings\">\n";
 static const char* endRootPage = "</div></body></html>";
 
+// Stream parts shared between connection threads.  The JPEG encode itself is
+// already shared through the frame's image cache; this makes the rest of the
+// per-frame work (the DHT scan and formatting the part headers) happen once for
+// all clients streaming the same frame at the same resolution and quality.
+// Only the part prefix is cached; the body points into the frame's image, so
+// each client sends the prefix and the image data with a single write.
+class MjpegServerImpl::PartCache {
+ public:
+  // Gets the stream part for an MJPEG image of the frame, building it if this
+  // is the first request for that image.  Returns nullptr if the image isn't
+  // MJPEG.  The part's body is only valid while the caller holds the frame.
+  std::shared_ptr<const MjpegPart> GetPart(
+      const std::shared_ptr<SourceImpl>& source, const Frame& frame,
+      Image* image);
+
+  void Clear();
+
+ private:
+  struct Entry {
+    // Declared before the frame so the frame is released first
+    std::shared_ptr<SourceImpl> source;
+    // Holding the frame keeps the image from being reused by another frame,
+    // so the image pointer identifies the entry
+    Frame frame;
+    Image* image;
+    std::shared_ptr<const MjpegPart> part;
+  };
+
+  wpi::util::mutex m_mutex;
+  std::vector<Entry> m_entries;
+};
+
+std::shared_ptr<const MjpegPart> MjpegServerImpl::PartCache::GetPart(
+    const std::shared_ptr<SourceImpl>& source, const Frame& frame,
+    Image* image) {
+  // Releasing a frame may return its images to the source's pool, so evicted
+  // entries are destroyed after the lock is released
+  std::vector<Entry> evicted;
+  std::scoped_lock lock(m_mutex);
+  for (auto&& entry : m_entries) {
+    if (entry.image == image) {
+      return entry.part;
+    }
+  }
+
+  auto part = std::make_shared<MjpegPart>();
+  if (!BuildMjpegPart(BOUNDARY, *image, frame.GetTime() / 1000000.0,
+                      part.get())) {
+    return nullptr;
+  }
+
+  // Replace the previous frame's entry for this resolution and quality, and
+  // drop entries for other sources or no longer being streamed
+  auto time = frame.GetTime();
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if (it->source != source ||
+        (it->image->width == image->width &&
+         it->image->height == image->height &&
+         it->image->jpegQuality == image->jpegQuality) ||
+        it->frame.GetTime() + 1000000 < time) {
+      evicted.emplace_back(std::move(*it));
+      it = m_entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  m_entries.push_back(Entry{source, frame, image, part});
+  return part;
+}
+
+void MjpegServerImpl::PartCache::Clear() {
+  std::vector<Entry> entries;
+  {
+    std::scoped_lock lock(m_mutex);
+    entries.swap(m_entries);
+  }
+  // release the frames outside the lock
+}
+
 class MjpegServerImpl::ConnThread : public wpi::util::SafeThread {
  public:
-  explicit ConnThread(std::string_view name, wpi::util::Logger& logger)
-      : m_name(name), m_logger(logger) {}
+  ConnThread(std::string_view name, wpi::util::Logger& logger,
+             std::shared_ptr<PartCache> partCache)
+      : m_name(name), m_logger(logger), m_partCache(std::move(partCache)) {}
 
   void Main() override;
 
@@ -103,6 +186,7 @@ class MjpegServerImpl::ConnThread : public wpi::util::SafeThread {
  private:
   std::string m_name;
   wpi::util::Logger& m_logger;
+  std::shared_ptr<PartCache> m_partCache;
 
   std::string_view GetName() { return m_name; }
 
@@ -607,7 +691,8 @@ MjpegServerImpl::MjpegServerImpl(
     : SinkImpl{name, logger, notifier, telemetry},
       m_listenAddress(listenAddress),
       m_port(port),
-      m_acceptor{std::move(acceptor)} {
+      m_acceptor{std::move(acceptor)},
+      m_partCache{std::make_shared<PartCache>()} {
   m_active = true;
 
   SetDescription(std::format("HTTP Server on port {}", port));
@@ -663,6 +748,8 @@ void MjpegServerImpl::Stop() {
   if (auto source = GetSource()) {
     source->Wakeup();
   }
+
+  m_partCache->Clear();
 }
 
 // Send HTTP response and a stream of JPG-frames
@@ -748,47 +835,19 @@ void MjpegServerImpl::ConnThread::SendStream(wpi::net::raw_socket_ostream& os) {
       continue;
     }
 
-    const char* data = image->data();
-    size_t size = image->size();
-    bool addDHT = false;
-    size_t locSOF = size;
-    switch (image->pixelFormat) {
-      case wpi::util::PixelFormat::MJPEG:
-        // Determine if we need to add DHT to it, and allocate enough space
-        // for adding it if required.
-        addDHT = JpegNeedsDHT(data, &size, &locSOF);
-        break;
-      case wpi::util::PixelFormat::UYVY:
-      case wpi::util::PixelFormat::RGB565:
-      case wpi::util::PixelFormat::YUYV:
-      case wpi::util::PixelFormat::Y16:
-      default:
-        // Bad frame; sleep for 10 ms so we don't consume all processor time.
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        continue;
+    auto part = m_partCache->GetPart(source, frame, image);
+    if (!part) {
+      // Bad frame; sleep for 10 ms so we don't consume all processor time.
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      continue;
     }
 
-    SDEBUG4("sending frame size={} addDHT={}", size, addDHT);
+    SDEBUG4("sending frame size={}", part->prefix.size() + part->body.size());
 
-    // print the individual mimetype and the length
-    // sending the content-length fixes random stream disruption observed
-    // with firefox
     lastFrameTime = thisFrameTime;
-    double timestamp = lastFrameTime / 1000000.0;
-    header.clear();
-    oss << "\r\n--" BOUNDARY "\r\n" << "Content-Type: image/jpeg\r\n";
-    wpi::util::print(oss, "Content-Length: {}\r\n", size);
-    wpi::util::print(oss, "X-Timestamp: {}\r\n", timestamp);
-    oss << "\r\n";
-    os << oss.str();
-    if (addDHT) {
-      // Insert DHT data immediately before SOF
-      os << std::string_view(data, locSOF);
-      os << JpegGetDHT();
-      os << std::string_view(data + locSOF, image->size() - locSOF);
-    } else {
-      os << std::string_view(data, size);
-    }
+    // frame is still held, so the part's body remains valid
+    std::string_view bufs[] = {part->prefix, part->body};
+    os.writev(bufs);
     // os.flush();
   }
   StopStream();
@@ -978,7 +1037,7 @@ void MjpegServerImpl::ServerThreadMain() {
     }
 
     // Start it if not already started
-    it->Start(GetName(), m_logger);
+    it->Start(GetName(), m_logger, m_partCache);
 
     auto nstreams =
         std::count_if(m_connThreads.begin(), m_connThreads.end(),
@@ -1019,6 +1078,7 @@ void MjpegServerImpl::SetSourceImpl(std::shared_ptr<SourceImpl> source) {
       }
     }
   }
+  m_partCache->Clear();
 }
 
 namespace wpi::cs {
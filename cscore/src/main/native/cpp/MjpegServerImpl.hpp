@@ -37,6 +37,7 @@ class MjpegServerImpl : public SinkImpl {
   void ServerThreadMain();
 
   class ConnThread;
+  class PartCache;
 
   // Never changed, so not protected by mutex
   std::string m_listenAddress;
@@ -48,6 +49,9 @@ class MjpegServerImpl : public SinkImpl {
 
   std::vector<wpi::util::SafeThreadOwner<ConnThread>> m_connThreads;
 
+  // Shared with the connection threads, which may outlive the server
+  std::shared_ptr<PartCache> m_partCache;
+
   // property indices
   int m_widthProp;
   int m_heightProp;
@@ -0,0 +1,348 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "PixelConvert.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    (defined(__i386__) && defined(__SSE2__))
+#define CS_PIXEL_SSE2
+#include <emmintrin.h>
+// AVX2 is picked at runtime, which needs the target attribute
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CS_PIXEL_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON)
+#define CS_PIXEL_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace wpi::cs;
+
+namespace {
+
+// Each kernel converts a prefix of the row that's a multiple of its vector
+// width and returns the number of output pixels done; the scalar loop finishes
+// the rest.
+
+#ifdef CS_PIXEL_AVX2
+__attribute__((target("avx2"))) int ToGrayAVX2(const uint8_t* src,
+                                               uint8_t* dst, int count,
+                                               int yOffset) {
+  const __m256i mask = _mm256_set1_epi16(0x00ff);
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+    if (yOffset == 0) {
+      a = _mm256_and_si256(a, mask);
+      b = _mm256_and_si256(b, mask);
+    } else {
+      a = _mm256_srli_epi16(a, 8);
+      b = _mm256_srli_epi16(b, 8);
+    }
+    // packus works within 128-bit lanes, so put the halves back in order
+    __m256i y = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), y);
+    src += 64;
+    dst += 32;
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) __m256i AverageLumaAVX2(const uint8_t* row0,
+                                                        const uint8_t* row1,
+                                                        int yOffset) {
+  const __m256i mask = _mm256_set1_epi32(0xff);
+  __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0));
+  __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1));
+  if (yOffset != 0) {
+    a = _mm256_srli_epi32(a, 8);
+    b = _mm256_srli_epi32(b, 8);
+  }
+  __m256i sum = _mm256_add_epi32(
+      _mm256_and_si256(a, mask),
+      _mm256_and_si256(_mm256_srli_epi32(a, 16), mask));
+  sum = _mm256_add_epi32(sum, _mm256_and_si256(b, mask));
+  sum = _mm256_add_epi32(sum,
+                         _mm256_and_si256(_mm256_srli_epi32(b, 16), mask));
+  return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(2)), 2);
+}
+
+__attribute__((target("avx2"))) int ToGrayHalfAVX2(const uint8_t* row0,
+                                                   const uint8_t* row1,
+                                                   uint8_t* dst, int count,
+                                                   int yOffset) {
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i s0 = AverageLumaAVX2(row0, row1, yOffset);
+    __m256i s1 = AverageLumaAVX2(row0 + 32, row1 + 32, yOffset);
+    __m256i s2 = AverageLumaAVX2(row0 + 64, row1 + 64, yOffset);
+    __m256i s3 = AverageLumaAVX2(row0 + 96, row1 + 96, yOffset);
+    __m256i y = _mm256_packus_epi16(_mm256_packs_epi32(s0, s1),
+                                    _mm256_packs_epi32(s2, s3));
+    y = _mm256_permutevar8x32_epi32(y, order);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), y);
+    row0 += 128;
+    row1 += 128;
+    dst += 32;
+  }
+  return i;
+}
+
+bool HasAVX2() {
+  static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+  return hasAVX2;
+}
+#endif
+
+#ifdef CS_PIXEL_SSE2
+int ToGraySSE2(const uint8_t* src, uint8_t* dst, int count, int yOffset) {
+  const __m128i mask = _mm_set1_epi16(0x00ff);
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+    if (yOffset == 0) {
+      a = _mm_and_si128(a, mask);
+      b = _mm_and_si128(b, mask);
+    } else {
+      a = _mm_srli_epi16(a, 8);
+      b = _mm_srli_epi16(b, 8);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(a, b));
+    src += 32;
+    dst += 16;
+  }
+  return i;
+}
+
+// Returns the rounded average luma of each macropixel's 2x2 block, one per
+// 32-bit lane
+__m128i AverageLumaSSE2(const uint8_t* row0, const uint8_t* row1,
+                        int yOffset) {
+  const __m128i mask = _mm_set1_epi32(0xff);
+  __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0));
+  __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1));
+  if (yOffset != 0) {
+    a = _mm_srli_epi32(a, 8);
+    b = _mm_srli_epi32(b, 8);
+  }
+  __m128i sum = _mm_add_epi32(_mm_and_si128(a, mask),
+                              _mm_and_si128(_mm_srli_epi32(a, 16), mask));
+  sum = _mm_add_epi32(sum, _mm_and_si128(b, mask));
+  sum = _mm_add_epi32(sum, _mm_and_si128(_mm_srli_epi32(b, 16), mask));
+  return _mm_srli_epi32(_mm_add_epi32(sum, _mm_set1_epi32(2)), 2);
+}
+
+int ToGrayHalfSSE2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst,
+                   int count, int yOffset) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i s0 = AverageLumaSSE2(row0, row1, yOffset);
+    __m128i s1 = AverageLumaSSE2(row0 + 16, row1 + 16, yOffset);
+    __m128i s2 = AverageLumaSSE2(row0 + 32, row1 + 32, yOffset);
+    __m128i s3 = AverageLumaSSE2(row0 + 48, row1 + 48, yOffset);
+    __m128i y = _mm_packus_epi16(_mm_packs_epi32(s0, s1),
+                                 _mm_packs_epi32(s2, s3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), y);
+    row0 += 64;
+    row1 += 64;
+    dst += 16;
+  }
+  return i;
+}
+#endif
+
+#ifdef CS_PIXEL_NEON
+int ToGrayNEON(const uint8_t* src, uint8_t* dst, int count, int yOffset) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint8x16x2_t yuv = vld2q_u8(src);
+    vst1q_u8(dst, yOffset == 0 ? yuv.val[0] : yuv.val[1]);
+    src += 32;
+    dst += 16;
+  }
+  return i;
+}
+
+int ToGrayHalfNEON(const uint8_t* row0, const uint8_t* row1, uint8_t* dst,
+                   int count, int yOffset) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    // Deinterleave 16 macropixels into their two luma and two chroma bytes
+    uint8x16x4_t a = vld4q_u8(row0);
+    uint8x16x4_t b = vld4q_u8(row1);
+    uint8x16_t a0 = yOffset == 0 ? a.val[0] : a.val[1];
+    uint8x16_t a1 = yOffset == 0 ? a.val[2] : a.val[3];
+    uint8x16_t b0 = yOffset == 0 ? b.val[0] : b.val[1];
+    uint8x16_t b1 = yOffset == 0 ? b.val[2] : b.val[3];
+    uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(a0), vget_low_u8(a1)),
+                              vaddl_u8(vget_low_u8(b0), vget_low_u8(b1)));
+    uint16x8_t hi = vaddq_u16(vaddl_u8(vget_high_u8(a0), vget_high_u8(a1)),
+                              vaddl_u8(vget_high_u8(b0), vget_high_u8(b1)));
+    // rounding shift gives (sum + 2) >> 2
+    vst1q_u8(dst, vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2)));
+    row0 += 64;
+    row1 += 64;
+    dst += 16;
+  }
+  return i;
+}
+#endif
+
+PixelConvertImpl DefaultImpl() {
+#ifdef CS_PIXEL_AVX2
+  if (HasAVX2()) {
+    return PixelConvertImpl::kAVX2;
+  }
+#endif
+#if defined(CS_PIXEL_SSE2)
+  return PixelConvertImpl::kSSE2;
+#elif defined(CS_PIXEL_NEON)
+  return PixelConvertImpl::kNEON;
+#else
+  return PixelConvertImpl::kScalar;
+#endif
+}
+
+std::atomic<PixelConvertImpl>& CurrentImpl() {
+  static std::atomic<PixelConvertImpl> impl{DefaultImpl()};
+  return impl;
+}
+
+int ToGrayVector(const uint8_t* src, uint8_t* dst, int count, int yOffset) {
+  switch (CurrentImpl().load(std::memory_order_relaxed)) {
+#ifdef CS_PIXEL_AVX2
+    case PixelConvertImpl::kAVX2:
+      return ToGrayAVX2(src, dst, count, yOffset);
+#endif
+#ifdef CS_PIXEL_SSE2
+    case PixelConvertImpl::kSSE2:
+      return ToGraySSE2(src, dst, count, yOffset);
+#endif
+#ifdef CS_PIXEL_NEON
+    case PixelConvertImpl::kNEON:
+      return ToGrayNEON(src, dst, count, yOffset);
+#endif
+    default:
+      return 0;
+  }
+}
+
+int ToGrayHalfVector(const uint8_t* row0, const uint8_t* row1, uint8_t* dst,
+                     int count, int yOffset) {
+  switch (CurrentImpl().load(std::memory_order_relaxed)) {
+#ifdef CS_PIXEL_AVX2
+    case PixelConvertImpl::kAVX2:
+      return ToGrayHalfAVX2(row0, row1, dst, count, yOffset);
+#endif
+#ifdef CS_PIXEL_SSE2
+    case PixelConvertImpl::kSSE2:
+      return ToGrayHalfSSE2(row0, row1, dst, count, yOffset);
+#endif
+#ifdef CS_PIXEL_NEON
+    case PixelConvertImpl::kNEON:
+      return ToGrayHalfNEON(row0, row1, dst, count, yOffset);
+#endif
+    default:
+      return 0;
+  }
+}
+
+uint8_t Saturate(int value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+}  // namespace
+
+bool wpi::cs::IsPixelConvertImplSupported(PixelConvertImpl impl) {
+  switch (impl) {
+    case PixelConvertImpl::kScalar:
+      return true;
+#ifdef CS_PIXEL_AVX2
+    case PixelConvertImpl::kAVX2:
+      return HasAVX2();
+#endif
+#ifdef CS_PIXEL_SSE2
+    case PixelConvertImpl::kSSE2:
+      return true;
+#endif
+#ifdef CS_PIXEL_NEON
+    case PixelConvertImpl::kNEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+void wpi::cs::SetPixelConvertImpl(PixelConvertImpl impl) {
+  CurrentImpl().store(impl, std::memory_order_relaxed);
+}
+
+void wpi::cs::ConvertYUV422ToGray(const uint8_t* src, uint8_t* dst, int width,
+                                  int height, int yOffset) {
+  // The image is tightly packed, so treat it as one long row
+  int count = width * height;
+  for (int i = ToGrayVector(src, dst, count, yOffset); i < count; ++i) {
+    dst[i] = src[2 * i + yOffset];
+  }
+}
+
+void wpi::cs::ConvertYUV422ToGrayHalf(const uint8_t* src, uint8_t* dst,
+                                      int width, int height, int yOffset) {
+  int srcStride = width * 2;
+  int dstWidth = width / 2;
+  for (int y = 0; y < height / 2; ++y) {
+    const uint8_t* row0 = src + 2 * y * srcStride;
+    const uint8_t* row1 = row0 + srcStride;
+    uint8_t* out = dst + y * dstWidth;
+    for (int x = ToGrayHalfVector(row0, row1, out, dstWidth, yOffset);
+         x < dstWidth; ++x) {
+      const uint8_t* p0 = row0 + 4 * x + yOffset;
+      const uint8_t* p1 = row1 + 4 * x + yOffset;
+      out[x] = (p0[0] + p0[2] + p1[0] + p1[2] + 2) >> 2;
+    }
+  }
+}
+
+void wpi::cs::ConvertYUV422ToBGRHalf(const uint8_t* src, uint8_t* dst,
+                                     int width, int height, int yOffset) {
+  // Fixed-point BT.601 coefficients, matching OpenCV's cvtColor
+  constexpr int kShift = 20;
+  constexpr int kCY = 1220542;
+  constexpr int kCUB = 2116026;
+  constexpr int kCUG = -409993;
+  constexpr int kCVG = -852492;
+  constexpr int kCVR = 1673527;
+  constexpr int kHalf = 1 << (kShift - 1);
+
+  int uOffset = 1 - yOffset;
+  int vOffset = uOffset + 2;
+  int srcStride = width * 2;
+  int dstWidth = width / 2;
+  for (int y = 0; y < height / 2; ++y) {
+    const uint8_t* row0 = src + 2 * y * srcStride;
+    const uint8_t* row1 = row0 + srcStride;
+    uint8_t* out = dst + y * dstWidth * 3;
+    for (int x = 0; x < dstWidth; ++x) {
+      const uint8_t* p0 = row0 + 4 * x;
+      const uint8_t* p1 = row1 + 4 * x;
+      int luma = (p0[yOffset] + p0[yOffset + 2] + p1[yOffset] +
+                  p1[yOffset + 2] + 2) >>
+                 2;
+      int u = ((p0[uOffset] + p1[uOffset] + 1) >> 1) - 128;
+      int v = ((p0[vOffset] + p1[vOffset] + 1) >> 1) - 128;
+      int yy = std::max(0, luma - 16) * kCY;
+      out[3 * x] = Saturate((yy + kHalf + kCUB * u) >> kShift);
+      out[3 * x + 1] = Saturate((yy + kHalf + kCVG * v + kCUG * u) >> kShift);
+      out[3 * x + 2] = Saturate((yy + kHalf + kCVR * v) >> kShift);
+    }
+  }
+}
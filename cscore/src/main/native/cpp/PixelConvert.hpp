@@ -0,0 +1,43 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace wpi::cs {
+
+// Conversions from packed 4:2:2 YUV (YUYV or UYVY) that OpenCV can't fuse with
+// a resize.  Images are tightly packed; width is the source width in pixels
+// and must be even.  yOffset is the byte offset of the first luma sample in
+// each macropixel: 0 for YUYV and 1 for UYVY.
+
+// Instruction sets the conversions can use.  The best one the CPU supports is
+// used by default.
+enum class PixelConvertImpl { kScalar, kSSE2, kAVX2, kNEON };
+
+// Returns true if the instruction set is built in and supported by the CPU.
+bool IsPixelConvertImplSupported(PixelConvertImpl impl);
+
+// Makes the conversions use the given instruction set, which must be
+// supported.  Only intended for testing the vector code against the scalar
+// code.
+void SetPixelConvertImpl(PixelConvertImpl impl);
+
+// Extracts the luma plane into a grayscale image of the same size.
+void ConvertYUV422ToGray(const uint8_t* src, uint8_t* dst, int width,
+                         int height, int yOffset);
+
+// Converts to a grayscale image of half the width and height, averaging the
+// luma of each 2x2 block.  Height must be even.
+void ConvertYUV422ToGrayHalf(const uint8_t* src, uint8_t* dst, int width,
+                             int height, int yOffset);
+
+// Converts to a BGR image of half the width and height, averaging the luma and
+// chroma of each 2x2 block.  Uses the same BT.601 video range coefficients as
+// OpenCV.  Height must be even.
+void ConvertYUV422ToBGRHalf(const uint8_t* src, uint8_t* dst, int width,
+                            int height, int yOffset);
+
+}  // namespace wpi::cs
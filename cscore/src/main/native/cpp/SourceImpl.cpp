@@ -4,7 +4,6 @@
 
 #include "SourceImpl.hpp"
 
-#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -21,8 +20,6 @@
 
 using namespace wpi::cs;
 
-static constexpr size_t kMaxImagesAvail = 32;
-
 SourceImpl::SourceImpl(std::string_view name, wpi::util::Logger& logger,
                        Notifier& notifier, Telemetry& telemetry)
     : m_logger(logger),
@@ -40,7 +37,10 @@ SourceImpl::~SourceImpl() {
   // Put in a block so we destroy before the destructor ends.
   {
     m_destroyFrames = true;
-    auto frames = std::move(m_framesAvail);
+    for (auto& slot : m_framesAvail) {
+      std::unique_ptr<Frame::Impl> frame{slot.exchange(nullptr)};
+    }
+    m_imagePool.Clear();
   }
   // Everything else can clean up itself.
 }
@@ -425,30 +425,7 @@ std::vector<VideoMode> SourceImpl::EnumerateVideoModes(
 
 std::unique_ptr<Image> SourceImpl::AllocImage(
     wpi::util::PixelFormat pixelFormat, int width, int height, size_t size) {
-  std::unique_ptr<Image> image;
-  {
-    std::scoped_lock lock{m_poolMutex};
-    // find the smallest existing frame that is at least big enough.
-    int found = -1;
-    for (size_t i = 0; i < m_imagesAvail.size(); ++i) {
-      // is it big enough?
-      if (m_imagesAvail[i] && m_imagesAvail[i]->capacity() >= size) {
-        // is it smaller than the last found?
-        if (found < 0 ||
-            m_imagesAvail[i]->capacity() < m_imagesAvail[found]->capacity()) {
-          // yes, update
-          found = i;
-        }
-      }
-    }
-
-    // if nothing found, allocate a new buffer
-    if (found < 0) {
-      image = std::make_unique<Image>(size);
-    } else {
-      image = std::move(m_imagesAvail[found]);
-    }
-  }
+  auto image = m_imagePool.Alloc(size);
 
   // Initialize image
   image->SetSize(size);
@@ -487,6 +464,9 @@ void SourceImpl::PutFrame(std::unique_ptr<Image> image, Frame::Time time,
   // Update telemetry
   m_telemetry.RecordSourceFrames(*this, 1);
   m_telemetry.RecordSourceBytes(*this, static_cast<int>(image->size()));
+  auto poolStats = m_imagePool.TakeStats();
+  m_telemetry.RecordSourcePool(*this, poolStats.hits, poolStats.misses,
+                               poolStats.bytesPooled);
 
   // Update frame
   {
@@ -543,47 +523,38 @@ void SourceImpl::UpdatePropertyValue(int property, bool setString, int value,
 }
 
 void SourceImpl::ReleaseImage(std::unique_ptr<Image> image) {
-  std::scoped_lock lock{m_poolMutex};
   if (m_destroyFrames) {
     return;
   }
-  // Return the frame to the pool.  First try to find an empty slot, otherwise
-  // add it to the end.
-  auto it = std::find(m_imagesAvail.begin(), m_imagesAvail.end(), nullptr);
-  if (it != m_imagesAvail.end()) {
-    *it = std::move(image);
-  } else if (m_imagesAvail.size() > kMaxImagesAvail) {
-    // Replace smallest buffer; don't need to check for null because the above
-    // find would have found it.
-    auto it2 = std::min_element(
-        m_imagesAvail.begin(), m_imagesAvail.end(),
-        [](const std::unique_ptr<Image>& a, const std::unique_ptr<Image>& b) {
-          return a->capacity() < b->capacity();
-        });
-    if ((*it2)->capacity() < image->capacity()) {
-      *it2 = std::move(image);
-    }
-  } else {
-    m_imagesAvail.emplace_back(std::move(image));
-  }
+  m_imagePool.Release(std::move(image));
 }
 
 std::unique_ptr<Frame::Impl> SourceImpl::AllocFrameImpl() {
-  std::scoped_lock lock{m_poolMutex};
-
-  if (m_framesAvail.empty()) {
-    return std::make_unique<Frame::Impl>(*this);
+  for (auto& slot : m_framesAvail) {
+    if (slot.load(std::memory_order_relaxed) == nullptr) {
+      continue;
+    }
+    if (Frame::Impl* impl = slot.exchange(nullptr, std::memory_order_acquire)) {
+      return std::unique_ptr<Frame::Impl>{impl};
+    }
   }
-
-  auto impl = std::move(m_framesAvail.back());
-  m_framesAvail.pop_back();
-  return impl;
+  return std::make_unique<Frame::Impl>(*this);
 }
 
 void SourceImpl::ReleaseFrameImpl(std::unique_ptr<Frame::Impl> impl) {
-  std::scoped_lock lock{m_poolMutex};
   if (m_destroyFrames) {
     return;
   }
-  m_framesAvail.push_back(std::move(impl));
+  // Put the frame in the first empty slot; if there's none, let it be freed
+  Frame::Impl* expected = nullptr;
+  for (auto& slot : m_framesAvail) {
+    if (slot.load(std::memory_order_relaxed) == nullptr &&
+        slot.compare_exchange_strong(expected, impl.get(),
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+      impl.release();
+      return;
+    }
+    expected = nullptr;
+  }
 }
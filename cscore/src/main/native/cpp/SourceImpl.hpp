@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <memory>
@@ -13,6 +14,7 @@
 
 #include "Frame.hpp"
 #include "Image.hpp"
+#include "ImagePool.hpp"
 #include "PropertyContainer.hpp"
 #include "wpi/cs/VideoMode.hpp"
 #include "wpi/cs/cscore_c.h"
@@ -180,19 +182,20 @@ class SourceImpl : public PropertyContainer {
   wpi::util::mutex m_frameMutex;
   wpi::util::condition_variable m_frameCv;
 
-  bool m_destroyFrames{false};
+  std::atomic_bool m_destroyFrames{false};
 
-  // Pool of frames/images to reduce malloc traffic.
-  wpi::util::mutex m_poolMutex;
-  std::vector<std::unique_ptr<Frame::Impl>> m_framesAvail;
-  std::vector<std::unique_ptr<Image>> m_imagesAvail;
+  // Pool of frames/images to reduce malloc traffic.  Both are lock-free, as
+  // they're released from every sink thread.
+  static constexpr size_t kMaxFramesAvail = 16;
+  std::array<std::atomic<Frame::Impl*>, kMaxFramesAvail> m_framesAvail{};
+  ImagePool m_imagePool;
 
   std::atomic_bool m_connected{false};
 
   // Most recent frame (returned to callers of GetNextFrame)
   // Access protected by m_frameMutex.
-  // MUST be located below m_poolMutex as the Frame destructor calls back
-  // into SourceImpl::ReleaseImage, which locks m_poolMutex.
+  // MUST be located below the pools as the Frame destructor calls back
+  // into SourceImpl::ReleaseImage, which returns images to m_imagePool.
   Frame m_frame;
 };
 
@@ -40,6 +40,12 @@ int64_t Telemetry::Thread::GetValue(CS_Handle handle, CS_TelemetryKind kind,
   return it->getSecond();
 }
 
+// Level kinds hold the latest value rather than a count accumulated over the
+// period, so they're carried over to the next period and never averaged
+static bool IsLevel(int kind) {
+  return kind == CS_SOURCE_POOL_BYTES;
+}
+
 Telemetry::~Telemetry() = default;
 
 void Telemetry::Start() {
@@ -75,6 +81,11 @@ void Telemetry::Thread::Main() {
     // move to user and clear current, as we don't keep around old values
     m_user = std::move(m_current);
     m_current.clear();
+    for (auto&& kv : m_user) {
+      if (IsLevel(kv.getFirst().second)) {
+        m_current.try_emplace(kv.getFirst(), kv.getSecond());
+      }
+    }
     auto curTime = std::chrono::steady_clock::now();
     m_elapsed = std::chrono::duration<double>(curTime - prevTime).count();
     prevTime = curTime;
@@ -122,6 +133,9 @@ double Telemetry::GetAverageValue(CS_Handle handle, CS_TelemetryKind kind,
     *status = CS_TELEMETRY_NOT_ENABLED;
     return 0;
   }
+  if (IsLevel(kind)) {
+    return thr->GetValue(handle, kind, status);
+  }
   if (thr->m_elapsed == 0) {
     return 0.0;
   }
@@ -149,3 +163,20 @@ void Telemetry::RecordSourceFrames(const SourceImpl& source, int quantity) {
                            static_cast<int>(CS_SOURCE_FRAMES_RECEIVED)}] +=
       quantity;
 }
+
+void Telemetry::RecordSourcePool(const SourceImpl& source, int64_t hits,
+                                 int64_t misses, int64_t bytesPooled) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    return;
+  }
+  Handle handle{Instance::GetInstance().FindSource(source).first,
+                Handle::SOURCE};
+  thr->m_current[std::pair{handle, static_cast<int>(CS_SOURCE_POOL_HITS)}] +=
+      hits;
+  thr->m_current[std::pair{handle, static_cast<int>(CS_SOURCE_POOL_MISSES)}] +=
+      misses;
+  // pooled bytes is a level, so keep the latest value
+  thr->m_current[std::pair{handle, static_cast<int>(CS_SOURCE_POOL_BYTES)}] =
+      bytesPooled;
+}
@@ -32,6 +32,8 @@ class Telemetry {
   // Telemetry events
   void RecordSourceBytes(const SourceImpl& source, int quantity);
   void RecordSourceFrames(const SourceImpl& source, int quantity);
+  void RecordSourcePool(const SourceImpl& source, int64_t hits,
+                        int64_t misses, int64_t bytesPooled);
 
  private:
   Notifier& m_notifier;
@@ -164,7 +164,16 @@ enum CS_EventKind {
  */
 enum CS_TelemetryKind {
   CS_SOURCE_BYTES_RECEIVED = 1,
-  CS_SOURCE_FRAMES_RECEIVED = 2
+  CS_SOURCE_FRAMES_RECEIVED = 2,
+  /** Number of image allocations served from the source's buffer pool */
+  CS_SOURCE_POOL_HITS = 3,
+  /** Number of image allocations that weren't served from the pool */
+  CS_SOURCE_POOL_MISSES = 4,
+  /**
+   * Bytes held in the source's buffer pool. This is a level rather than a
+   * count, so the average value is the latest value.
+   */
+  CS_SOURCE_POOL_BYTES = 5
 };
 
 /** Connection strategy */
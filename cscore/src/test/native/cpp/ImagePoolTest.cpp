@@ -0,0 +1,103 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ImagePool.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace wpi::cs {
+
+TEST_CASE("ImagePoolTest SizeClasses", "[cscore][image-pool]") {
+  ImagePool pool;
+  CHECK(pool.Alloc(1)->capacity() == 4096u);
+  CHECK(pool.Alloc(4096)->capacity() == 4096u);
+  CHECK(pool.Alloc(4097)->capacity() == 5120u);
+  CHECK(pool.Alloc(5120)->capacity() == 5120u);
+  CHECK(pool.Alloc(5121)->capacity() == 6144u);
+  CHECK(pool.Alloc(8192)->capacity() == 8192u);
+  CHECK(pool.Alloc(8193)->capacity() == 10240u);
+  CHECK(pool.Alloc(640 * 480 * 3)->capacity() == 1048576u);
+
+  // at most a quarter of the capacity goes unused
+  for (size_t size = 4097; size < (1u << 24); size = size * 9 / 8 + 1) {
+    size_t capacity = pool.Alloc(size)->capacity();
+    CHECK(capacity >= size);
+    CHECK(capacity <= size + size / 4);
+  }
+}
+
+TEST_CASE("ImagePoolTest Reuse", "[cscore][image-pool]") {
+  ImagePool pool;
+  auto image = pool.Alloc(5000);
+  Image* ptr = image.get();
+  pool.Release(std::move(image));
+  auto stats = pool.TakeStats();
+  CHECK(stats.hits == 0);
+  CHECK(stats.misses == 1);
+  CHECK(stats.bytesPooled == 5120);
+
+  // any size in the class gets the same image back
+  image = pool.Alloc(4097);
+  CHECK(image.get() == ptr);
+  stats = pool.TakeStats();
+  CHECK(stats.hits == 1);
+  CHECK(stats.misses == 0);
+  CHECK(stats.bytesPooled == 0);
+
+  // so does a size in the class below
+  pool.Release(std::move(image));
+  CHECK(pool.Alloc(4096).get() == ptr);
+
+  // but not a size in the class above
+  pool.Release(std::make_unique<Image>(4096));
+  CHECK(pool.Alloc(4097)->capacity() == 5120u);
+  stats = pool.TakeStats();
+  CHECK(stats.hits == 1);
+  CHECK(stats.misses == 1);
+  CHECK(stats.bytesPooled == 4096);
+}
+
+TEST_CASE("ImagePoolTest ReleaseClass", "[cscore][image-pool]") {
+  ImagePool pool;
+
+  // too small to pool
+  pool.Release(std::make_unique<Image>(4095));
+  CHECK(pool.TakeStats().bytesPooled == 0);
+
+  // pooled in the largest class it can fill
+  auto image = std::make_unique<Image>(6000);
+  Image* ptr = image.get();
+  pool.Release(std::move(image));
+  CHECK(pool.TakeStats().bytesPooled == 6000);
+  CHECK(pool.Alloc(6144).get() != ptr);
+  CHECK(pool.Alloc(5120).get() == ptr);
+}
+
+TEST_CASE("ImagePoolTest FullClass", "[cscore][image-pool]") {
+  ImagePool pool;
+  std::vector<std::unique_ptr<Image>> images;
+  for (int i = 0; i < 5; ++i) {
+    images.emplace_back(pool.Alloc(8192));
+  }
+  for (auto&& image : images) {
+    pool.Release(std::move(image));
+  }
+  // only four slots per class; the last image is freed
+  auto stats = pool.TakeStats();
+  CHECK(stats.misses == 5);
+  CHECK(stats.bytesPooled == 4 * 8192);
+
+  pool.Clear();
+  CHECK(pool.TakeStats().bytesPooled == 0);
+  pool.Alloc(8192);
+  stats = pool.TakeStats();
+  CHECK(stats.hits == 0);
+  CHECK(stats.misses == 1);
+}
+
+}  // namespace wpi::cs
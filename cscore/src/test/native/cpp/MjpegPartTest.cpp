@@ -0,0 +1,76 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "MjpegPart.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Image.hpp"
+#include "JpegUtil.hpp"
+
+namespace wpi::cs {
+
+namespace {
+
+// SOI, APP0, SOF0, SOS, scan data, and EOI, with no DHT
+constexpr std::string_view kBeforeSOF{"\xff\xd8\xff\xe0\x00\x04\xaa\xbb", 8};
+constexpr std::string_view kFromSOF{
+    "\xff\xc0\x00\x05\x01\x02\x03\xff\xda\x00\x04\x11\x22\x33\x44\xff\xd9",
+    17};
+constexpr std::string_view kDHT{"\xff\xc4\x00\x03\x55", 5};
+
+void SetImage(Image& image, std::string_view data) {
+  image.SetSize(data.size());
+  std::copy(data.begin(), data.end(), image.data());
+  image.pixelFormat = wpi::util::PixelFormat::MJPEG;
+}
+
+std::string Headers(size_t size) {
+  return "\r\n--boundary\r\nContent-Type: image/jpeg\r\nContent-Length: " +
+         std::to_string(size) + "\r\nX-Timestamp: 1.5\r\n\r\n";
+}
+
+}  // namespace
+
+TEST_CASE("MjpegPartTest InsertDHT", "[cscore][mjpeg-part]") {
+  std::string jpeg = std::string{kBeforeSOF} + std::string{kFromSOF};
+  Image image{jpeg.size()};
+  SetImage(image, jpeg);
+
+  MjpegPart part;
+  REQUIRE(BuildMjpegPart("boundary", image, 1.5, &part));
+  auto dht = JpegGetDHT();
+  CHECK(part.prefix == Headers(jpeg.size() + dht.size()) +
+                           std::string{kBeforeSOF} + std::string{dht});
+  // the rest of the image isn't copied
+  CHECK(part.body.data() == image.data() + kBeforeSOF.size());
+  CHECK(part.body == kFromSOF);
+}
+
+TEST_CASE("MjpegPartTest HasDHT", "[cscore][mjpeg-part]") {
+  std::string jpeg =
+      std::string{kBeforeSOF} + std::string{kDHT} + std::string{kFromSOF};
+  Image image{jpeg.size()};
+  SetImage(image, jpeg);
+
+  MjpegPart part;
+  REQUIRE(BuildMjpegPart("boundary", image, 1.5, &part));
+  CHECK(part.prefix == Headers(jpeg.size()));
+  CHECK(part.body.data() == image.data());
+  CHECK(part.body == jpeg);
+}
+
+TEST_CASE("MjpegPartTest NotMjpeg", "[cscore][mjpeg-part]") {
+  Image image{16};
+  image.SetSize(16);
+  image.pixelFormat = wpi::util::PixelFormat::BGR;
+  MjpegPart part;
+  CHECK_FALSE(BuildMjpegPart("boundary", image, 1.5, &part));
+}
+
+}  // namespace wpi::cs
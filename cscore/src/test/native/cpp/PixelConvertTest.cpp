@@ -0,0 +1,180 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "PixelConvert.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_adapters.hpp>
+
+namespace wpi::cs {
+
+namespace {
+
+// Guard bytes after the output to catch overruns
+constexpr int kGuard = 64;
+constexpr uint8_t kGuardValue = 0xa5;
+
+// Restores the default instruction set when a test ends
+class ImplSetter {
+ public:
+  explicit ImplSetter(PixelConvertImpl impl) { SetPixelConvertImpl(impl); }
+  ~ImplSetter() { SetPixelConvertImpl(kDefault); }
+
+ private:
+  static inline const PixelConvertImpl kDefault = [] {
+    for (auto impl : {PixelConvertImpl::kAVX2, PixelConvertImpl::kSSE2,
+                      PixelConvertImpl::kNEON}) {
+      if (IsPixelConvertImplSupported(impl)) {
+        return impl;
+      }
+    }
+    return PixelConvertImpl::kScalar;
+  }();
+};
+
+// Returns a source buffer; the image starts at the given byte offset so the
+// vector loads aren't aligned
+std::vector<uint8_t> MakeSource(int width, int height, int offset) {
+  std::mt19937 gen(width * 31 + height);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> src(offset + width * height * 2);
+  for (auto& b : src) {
+    b = dist(gen);
+  }
+  return src;
+}
+
+// Converts with the given instruction set into a buffer with guard bytes
+// after the output, which are checked and removed
+template <typename F>
+std::vector<uint8_t> Convert(F&& convert, const uint8_t* src, int outSize,
+                             int offset) {
+  std::vector<uint8_t> dst(offset + outSize + kGuard, kGuardValue);
+  convert(src, dst.data() + offset);
+  for (int i = 0; i < offset; ++i) {
+    REQUIRE(dst[i] == kGuardValue);
+  }
+  for (int i = 0; i < kGuard; ++i) {
+    REQUIRE(dst[offset + outSize + i] == kGuardValue);
+  }
+  return {dst.begin() + offset, dst.begin() + offset + outSize};
+}
+
+uint8_t ReferenceLuma(const uint8_t* src, int width, int x, int y,
+                      int yOffset) {
+  const uint8_t* p0 = src + 2 * y * width * 2 + 4 * x + yOffset;
+  const uint8_t* p1 = p0 + width * 2;
+  return (p0[0] + p0[2] + p1[0] + p1[2] + 2) / 4;
+}
+
+PixelConvertImpl GetImpl() {
+  return GENERATE(Catch::Generators::filter(
+      [](PixelConvertImpl impl) { return IsPixelConvertImplSupported(impl); },
+      Catch::Generators::values(
+          {PixelConvertImpl::kScalar, PixelConvertImpl::kSSE2,
+           PixelConvertImpl::kAVX2, PixelConvertImpl::kNEON})));
+}
+
+}  // namespace
+
+TEST_CASE("PixelConvertTest Gray", "[cscore][pixel-convert]") {
+  auto impl = GetImpl();
+  auto yOffset = GENERATE(0, 1);
+  auto offset = GENERATE(0, 1, 3);
+  ImplSetter setter{impl};
+
+  // covers every tail length of the 16 and 32 pixel kernels
+  for (int height : {1, 3}) {
+    for (int width = 2; width <= 2 * 70; width += 2) {
+      auto src = MakeSource(width, height, offset);
+      const uint8_t* image = src.data() + offset;
+      auto dst = Convert(
+          [&](const uint8_t* s, uint8_t* d) {
+            ConvertYUV422ToGray(s, d, width, height, yOffset);
+          },
+          image, width * height, offset);
+      for (int i = 0; i < width * height; ++i) {
+        INFO("width " << width << " height " << height << " pixel " << i);
+        REQUIRE(dst[i] == image[2 * i + yOffset]);
+      }
+    }
+  }
+}
+
+TEST_CASE("PixelConvertTest GrayHalf", "[cscore][pixel-convert]") {
+  auto impl = GetImpl();
+  auto yOffset = GENERATE(0, 1);
+  auto offset = GENERATE(0, 1, 3);
+  ImplSetter setter{impl};
+
+  // Output widths up to 70 cover every tail length, both odd and even, and
+  // make rows start at addresses that aren't a multiple of the vector width
+  for (int height : {2, 6}) {
+    for (int width = 2; width <= 2 * 70; width += 2) {
+      auto src = MakeSource(width, height, offset);
+      const uint8_t* image = src.data() + offset;
+      int dstWidth = width / 2;
+      auto dst = Convert(
+          [&](const uint8_t* s, uint8_t* d) {
+            ConvertYUV422ToGrayHalf(s, d, width, height, yOffset);
+          },
+          image, dstWidth * height / 2, offset);
+      for (int y = 0; y < height / 2; ++y) {
+        for (int x = 0; x < dstWidth; ++x) {
+          INFO("width " << width << " x " << x << " y " << y);
+          REQUIRE(dst[y * dstWidth + x] ==
+                  ReferenceLuma(image, width, x, y, yOffset));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("PixelConvertTest BGRHalf", "[cscore][pixel-convert]") {
+  auto yOffset = GENERATE(0, 1);
+  auto offset = GENERATE(0, 1, 3);
+  int uOffset = 1 - yOffset;
+  int vOffset = uOffset + 2;
+
+  for (int height : {2, 6}) {
+    for (int width : {2, 6, 34, 66, 130}) {
+      auto src = MakeSource(width, height, offset);
+      const uint8_t* image = src.data() + offset;
+      int dstWidth = width / 2;
+      auto dst = Convert(
+          [&](const uint8_t* s, uint8_t* d) {
+            ConvertYUV422ToBGRHalf(s, d, width, height, yOffset);
+          },
+          image, dstWidth * height / 2 * 3, offset);
+      for (int y = 0; y < height / 2; ++y) {
+        for (int x = 0; x < dstWidth; ++x) {
+          INFO("width " << width << " x " << x << " y " << y);
+          const uint8_t* p0 = image + 2 * y * width * 2 + 4 * x;
+          const uint8_t* p1 = p0 + width * 2;
+          double luma = ReferenceLuma(image, width, x, y, yOffset);
+          double u = (p0[uOffset] + p1[uOffset] + 1) / 2 - 128;
+          double v = (p0[vOffset] + p1[vOffset] + 1) / 2 - 128;
+          double yy = 1.164 * std::max(0.0, luma - 16);
+          double expected[3] = {yy + 2.018 * u, yy - 0.813 * v - 0.391 * u,
+                                yy + 1.596 * v};
+          const uint8_t* out = &dst[(y * dstWidth + x) * 3];
+          for (int c = 0; c < 3; ++c) {
+            double clamped = std::clamp(expected[c], 0.0, 255.0);
+            REQUIRE(std::abs(out[c] - clamped) <= 1.0);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace wpi::cs
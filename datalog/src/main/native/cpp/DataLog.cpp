@@ -9,7 +9,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -17,6 +19,7 @@
 #include "wpi/util/Logger.hpp"
 #include "wpi/util/SmallString.hpp"
 #include "wpi/util/print.hpp"
+#include "wpi/util/spinlock.hpp"
 #include "wpi/util/string.hpp"
 #include "wpi/util/timestamp.hpp"
 
@@ -35,6 +38,104 @@ static void DefaultLog(unsigned int level, const char* file, unsigned int line,
 
 wpi::util::Logger DataLog::s_defaultMessageLog{DefaultLog};
 
+static std::atomic<uint64_t> gNextInstance{1};
+
+// A chain of buffers private to a single appending thread.  Records are
+// tracked individually so they can be merged in timestamp order.
+struct DataLog::ThreadBuffer {
+  struct Record {
+    uint64_t timestamp;
+    size_t block;
+    size_t offset;
+    size_t size;
+  };
+
+  // buffers are taken from and returned to the log's shared free list
+  struct Chain {
+    std::vector<Buffer> bufs;
+    std::vector<Record> records;
+  };
+
+  explicit ThreadBuffer(std::thread::id id) : threadId{id} {}
+
+  std::thread::id threadId;
+  // only contended by MergeThreadBufs() and PruneThreadBufs()
+  wpi::util::spinlock mutex;
+  Chain active;
+  Chain merging;  // only accessed with DataLog::m_mutex held
+  // records were merged since the last flush; only accessed with
+  // DataLog::m_mutex held
+  bool mergedSinceFlush = false;
+  // set (with mutex held) when removed from the log's list of thread buffers;
+  // the owning thread must get a new buffer before appending again
+  std::atomic_bool retired = false;
+};
+
+// Holds the lock needed to append a data record: either the calling thread's
+// buffer lock (per-thread buffering) or the shared mutex.
+class DataLog::AppendScope {
+ public:
+  explicit AppendScope(DataLog& log) : m_log{log} {
+    if (log.m_threadLocal.load(std::memory_order_relaxed)) {
+      for (;;) {
+        tb = log.GetThreadBuffer();
+        tb->mutex.lock();
+        if (!tb->retired.load(std::memory_order_relaxed)) {
+          [[likely]] break;
+        }
+        // pruned between lookup and lock
+        tb->mutex.unlock();
+      }
+    } else {
+      log.m_mutex.lock();
+    }
+  }
+
+  ~AppendScope() {
+    if (tb) {
+      tb->mutex.unlock();
+    } else {
+      m_log.m_mutex.unlock();
+    }
+  }
+
+  AppendScope(const AppendScope&) = delete;
+  AppendScope& operator=(const AppendScope&) = delete;
+
+  ThreadBuffer* tb = nullptr;
+
+ private:
+  DataLog& m_log;
+};
+
+// Samples buffered for a "packed:int64" or "packed:double" entry; see
+// datalog.adoc for the payload format.  Samples are encoded as they are
+// appended, and the record is assembled when the entry is flushed.
+struct DataLog::PackedEntry {
+  static constexpr uint32_t kMaxSamples = 256;
+
+  void Add(uint64_t timestamp, uint64_t value);
+  void Clear();
+
+  bool isDouble = false;
+  uint32_t count = 0;
+  uint64_t firstTimestamp = 0;
+  uint64_t lastTimestamp = 0;
+  uint64_t lastDelta = 0;
+  uint64_t lastValue = 0;
+  // leading and trailing zero bits of the current XOR window (doubles only);
+  // leading is 64 when there is no window yet
+  unsigned int leading = 64;
+  unsigned int trailing = 0;
+  // number of bits used in the last byte of values (0 if it is full)
+  unsigned int bitPos = 0;
+  std::vector<uint8_t> timestamps;
+  std::vector<uint8_t> values;
+
+ private:
+  void WriteBits(uint64_t bits, unsigned int len);
+};
+
 template <typename T>
 static unsigned int WriteVarInt(uint8_t* buf, T val) {
   unsigned int len = 0;
@@ -56,14 +157,106 @@ static unsigned int WriteRecordHeader(uint8_t* buf, uint32_t entry,
   buf += entryLen;
   unsigned int payloadLen = WriteVarInt(buf, payloadSize);
   buf += payloadLen;
-  unsigned int timestampLen =
-      WriteVarInt(buf, timestamp == 0 ? wpi::util::Now() : timestamp);
+  unsigned int timestampLen = WriteVarInt(buf, timestamp);
   buf += timestampLen;
   *origbuf =
       ((timestampLen - 1) << 4) | ((payloadLen - 1) << 2) | (entryLen - 1);
   return buf - origbuf;
 }
 
+static uint64_t ZigZagEncode(uint64_t val) {
+  return (val << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(val) >> 63);
+}
+
+static unsigned int WriteLeb128(uint8_t* buf, uint64_t val) {
+  unsigned int len = 0;
+  while (val >= 0x80) {
+    buf[len++] = (val & 0x7f) | 0x80;
+    val >>= 7;
+  }
+  buf[len++] = val;
+  return len;
+}
+
+static void AppendLeb128(std::vector<uint8_t>& buf, uint64_t val) {
+  uint8_t tmp[10];
+  unsigned int len = WriteLeb128(tmp, val);
+  buf.insert(buf.end(), tmp, tmp + len);
+}
+
+void DataLog::PackedEntry::WriteBits(uint64_t bits, unsigned int len) {
+  while (len > 0) {
+    if (bitPos == 0) {
+      values.push_back(0);
+    }
+    unsigned int n = std::min(len, 8 - bitPos);
+    unsigned int chunk = (bits >> (len - n)) & ((1u << n) - 1);
+    values.back() |= chunk << (8 - bitPos - n);
+    bitPos = (bitPos + n) % 8;
+    len -= n;
+  }
+}
+
+void DataLog::PackedEntry::Add(uint64_t timestamp, uint64_t value) {
+  if (count == 0) {
+    firstTimestamp = timestamp;
+    if (isDouble) {
+      WriteBits(value, 64);
+    } else {
+      AppendLeb128(values, ZigZagEncode(value));
+    }
+  } else {
+    // unsigned arithmetic so differences wrap instead of overflowing
+    uint64_t delta = timestamp - lastTimestamp;
+    AppendLeb128(timestamps, ZigZagEncode(delta - lastDelta));
+    lastDelta = delta;
+    if (isDouble) {
+      uint64_t x = value ^ lastValue;
+      if (x == 0) {
+        WriteBits(0, 1);
+      } else {
+        unsigned int lz = std::min(std::countl_zero(x), 31);
+        unsigned int tz = std::countr_zero(x);
+        if (lz >= leading && tz >= trailing) {
+          // fits in the previous window
+          WriteBits(0b10, 2);
+          WriteBits(x >> trailing, 64 - leading - trailing);
+        } else {
+          unsigned int meaningful = 64 - lz - tz;
+          WriteBits(0b11, 2);
+          WriteBits(lz, 5);
+          WriteBits(meaningful - 1, 6);
+          WriteBits(x >> tz, meaningful);
+          leading = lz;
+          trailing = tz;
+        }
+      }
+    } else {
+      AppendLeb128(values, ZigZagEncode(value - lastValue));
+    }
+  }
+  lastTimestamp = timestamp;
+  lastValue = value;
+  ++count;
+}
+
+void DataLog::PackedEntry::Clear() {
+  count = 0;
+  lastDelta = 0;
+  leading = 64;
+  trailing = 0;
+  bitPos = 0;
+  timestamps.clear();
+  values.clear();
+}
+
+DataLog::DataLog(wpi::util::Logger& msglog, std::string_view extraHeader)
+    : m_msglog{msglog},
+      m_instance{gNextInstance++},
+      m_extraHeader{extraHeader} {}
+
+DataLog::~DataLog() = default;
+
 void DataLog::StartFile() {
   std::scoped_lock lock{m_mutex};
   if (m_active) {
@@ -113,13 +306,16 @@ void DataLog::StartFile() {
 
 void DataLog::FlushBufs(std::vector<Buffer>* writeBufs) {
   std::scoped_lock lock{m_mutex};
+  MergeThreadBufs();
+  PruneThreadBufs();
+  FlushAllPacked();
   writeBufs->swap(m_outgoing);
+  m_bufferCount.fetch_sub(writeBufs->size(), std::memory_order_relaxed);
   DoReleaseBufs(&m_outgoing);
   m_paused = m_manuallyPaused;
 }
 
 void DataLog::ReleaseBufs(std::vector<Buffer>* bufs) {
-  std::scoped_lock lock{m_mutex};
   DoReleaseBufs(bufs);
 }
 
@@ -140,6 +336,14 @@ void DataLog::Stop() {
   m_active = false;
 }
 
+void DataLog::SetThreadLocalBuffering(bool enable) {
+  std::scoped_lock lock{m_mutex};
+  m_threadLocal = enable;
+  if (!enable) {
+    MergeThreadBufs();
+  }
+}
+
 void DataLog::BufferHalfFull() {}
 
 bool DataLog::HasSchema(std::string_view name) const {
@@ -223,6 +427,7 @@ void DataLog::AppendStartRecord(int id, std::string_view name,
 }
 
 void DataLog::DoReleaseBufs(std::vector<Buffer>* bufs) {
+  std::scoped_lock lock{m_freeMutex};
   for (auto&& buf : *bufs) {
     buf.Clear();
     if (m_free.size() < kMaxFreeCount) {
@@ -232,6 +437,16 @@ void DataLog::DoReleaseBufs(std::vector<Buffer>* bufs) {
   bufs->resize(0);
 }
 
+DataLog::Buffer DataLog::GetFreeBuf() {
+  std::scoped_lock lock{m_freeMutex};
+  if (m_free.empty()) {
+    return Buffer{};
+  }
+  Buffer buf = std::move(m_free.back());
+  m_free.pop_back();
+  return buf;
+}
+
 void DataLog::Finish(int entry, int64_t timestamp) {
   if (entry <= 0) {
     return;
@@ -246,9 +461,15 @@ void DataLog::Finish(int entry, int64_t timestamp) {
     return;
   }
   m_entryIds.erase(entry);
+  if (auto it = m_packed.find(entry); it != m_packed.end()) {
+    FlushPacked(entry, *it->second);
+    m_packed.erase(it);
+  }
   if (!m_active) {
     [[unlikely]] return;
   }
+  // data records for this entry must precede the finish record
+  MergeThreadBufs();
   uint8_t* buf = StartRecord(0, timestamp, 5, 5);
   *buf++ = impl::kControlFinish;
   wpi::util::support::endian::write32le(buf, entry);
@@ -264,59 +485,184 @@ void DataLog::SetMetadata(int entry, std::string_view metadata,
   if (!m_active) {
     [[unlikely]] return;
   }
+  MergeThreadBufs();
   uint8_t* buf = StartRecord(0, timestamp, 5 + 4 + metadata.size(), 5);
   *buf++ = impl::kControlSetMetadata;
   wpi::util::support::endian::write32le(buf, entry);
   AppendStringImpl(metadata);
 }
 
-uint8_t* DataLog::Reserve(size_t size) {
+DataLog::ThreadBuffer* DataLog::GetThreadBuffer() {
+  // cache the last used buffer; instance numbers are never reused, so a stale
+  // cache entry from a destroyed log can never match.  The cache shares
+  // ownership so a pruned buffer stays valid until the thread notices.
+  static thread_local uint64_t cachedInstance = 0;
+  static thread_local std::shared_ptr<ThreadBuffer> cachedBuf;
+  if (cachedInstance == m_instance &&
+      !cachedBuf->retired.load(std::memory_order_relaxed)) {
+    [[likely]] return cachedBuf.get();
+  }
+
+  std::scoped_lock lock{m_mutex};
+  auto id = std::this_thread::get_id();
+  auto it = std::find_if(m_threadBufs.begin(), m_threadBufs.end(),
+                         [&](const auto& tb) { return tb->threadId == id; });
+  if (it == m_threadBufs.end()) {
+    it = m_threadBufs.emplace(m_threadBufs.end(),
+                              std::make_shared<ThreadBuffer>(id));
+  }
+  cachedInstance = m_instance;
+  cachedBuf = *it;
+  return cachedBuf.get();
+}
+
+void DataLog::MergeThreadBufs() {
+  if (m_threadBufs.empty()) {
+    return;
+  }
+
+  // grab the records appended so far by each thread; appending threads
+  // continue into their (previously emptied) alternate chain
+  struct MergeRecord {
+    const ThreadBuffer::Chain* chain;
+    const ThreadBuffer::Record* record;
+  };
+  std::vector<MergeRecord> records;
+  for (auto&& tb : m_threadBufs) {
+    {
+      std::scoped_lock lock{tb->mutex};
+      std::swap(tb->active, tb->merging);
+    }
+    if (!tb->merging.records.empty()) {
+      tb->mergedSinceFlush = true;
+    }
+    for (auto&& record : tb->merging.records) {
+      records.emplace_back(&tb->merging, &record);
+    }
+  }
+
+  // stable sort keeps the per-thread order for equal timestamps
+  std::stable_sort(records.begin(), records.end(),
+                   [](const auto& a, const auto& b) {
+                     return a.record->timestamp < b.record->timestamp;
+                   });
+
+  // records are contiguous in the concatenation of the chain's buffers
+  for (auto&& [chain, record] : records) {
+    size_t block = record->block;
+    size_t offset = record->offset;
+    size_t size = record->size;
+    while (size > 0) {
+      auto data = chain->bufs[block++].GetData().subspan(offset);
+      size_t len = std::min(size, data.size());
+      AppendImpl(data.subspan(0, len));
+      size -= len;
+      offset = 0;
+    }
+  }
+
+  for (auto&& tb : m_threadBufs) {
+    m_bufferCount.fetch_sub(tb->merging.bufs.size(),
+                            std::memory_order_relaxed);
+    DoReleaseBufs(&tb->merging.bufs);
+    tb->merging.records.clear();
+  }
+}
+
+void DataLog::PruneThreadBufs() {
+  // Buffers of threads that appended nothing since the last flush are
+  // dropped, so exited threads don't accumulate.  A thread that is still
+  // running gets a new buffer on its next append.
+  std::erase_if(m_threadBufs, [](const auto& tb) {
+    if (std::exchange(tb->mergedSinceFlush, false)) {
+      return false;
+    }
+    std::scoped_lock lock{tb->mutex};
+    if (!tb->active.records.empty()) {
+      return false;
+    }
+    tb->retired = true;
+    return true;
+  });
+}
+
+uint8_t* DataLog::Reserve(size_t size, ThreadBuffer* tb) {
   assert(size <= kBlockSize);
-  if (m_outgoing.empty() || size > m_outgoing.back().GetRemaining()) {
-    if (m_outgoing.size() == kMaxBufferCount / 2) {
-      [[unlikely]] BufferHalfFull();
-    }
-    if (m_free.empty()) {
-      if (m_outgoing.size() >= kMaxBufferCount) {
-        [[unlikely]]
-        if (BufferFull()) {
-          m_paused = true;
-        }
-      }
-      m_outgoing.emplace_back();
-    } else {
-      m_outgoing.emplace_back(std::move(m_free.back()));
-      m_free.pop_back();
+  if (tb) {
+    auto& chain = tb->active;
+    if (chain.bufs.empty() || size > chain.bufs.back().GetRemaining()) {
+      CountNewBuf();
+      chain.bufs.emplace_back(GetFreeBuf());
     }
+    return chain.bufs.back().Reserve(size);
+  }
+  if (m_outgoing.empty() || size > m_outgoing.back().GetRemaining()) {
+    CountNewBuf();
+    m_outgoing.emplace_back(GetFreeBuf());
   }
   return m_outgoing.back().Reserve(size);
 }
 
+void DataLog::CountNewBuf() {
+  // the limits apply to the shared and all per-thread chains together
+  size_t count = m_bufferCount.fetch_add(1, std::memory_order_relaxed);
+  if (count == kMaxBufferCount / 2) {
+    [[unlikely]] BufferHalfFull();
+  }
+  if (count >= kMaxBufferCount) {
+    [[unlikely]]
+    if (BufferFull()) {
+      m_paused = true;
+    }
+  }
+}
+
 uint8_t* DataLog::StartRecord(uint32_t entry, uint64_t timestamp,
-                              uint32_t payloadSize, size_t reserveSize) {
-  uint8_t* buf = Reserve(kRecordMaxHeaderSize + reserveSize);
+                              uint32_t payloadSize, size_t reserveSize,
+                              ThreadBuffer* tb) {
+  if (timestamp == 0) {
+    timestamp = wpi::util::Now();
+  }
+  uint8_t* buf = Reserve(kRecordMaxHeaderSize + reserveSize, tb);
   auto headerLen = WriteRecordHeader(buf, entry, timestamp, payloadSize);
-  m_outgoing.back().Unreserve(kRecordMaxHeaderSize - headerLen);
+  EndReserve(buf, kRecordMaxHeaderSize - headerLen, timestamp,
+             headerLen + payloadSize, tb);
   buf += headerLen;
   return buf;
 }
 
-void DataLog::AppendImpl(std::span<const uint8_t> data) {
+// Releases the unused end of the last Reserve(); for per-thread buffers, also
+// tracks the size bytes starting at start as one record for merging.
+void DataLog::EndReserve(uint8_t* start, size_t unused, uint64_t timestamp,
+                         size_t size, ThreadBuffer* tb) {
+  if (tb) {
+    auto& chain = tb->active;
+    auto& block = chain.bufs.back();
+    block.Unreserve(unused);
+    chain.records.emplace_back(ThreadBuffer::Record{
+        timestamp, chain.bufs.size() - 1,
+        static_cast<size_t>(start - block.GetData().data()), size});
+  } else {
+    m_outgoing.back().Unreserve(unused);
+  }
+}
+
+void DataLog::AppendImpl(std::span<const uint8_t> data, ThreadBuffer* tb) {
   while (data.size() > kBlockSize) {
-    uint8_t* buf = Reserve(kBlockSize);
+    uint8_t* buf = Reserve(kBlockSize, tb);
     std::memcpy(buf, data.data(), kBlockSize);
     data = data.subspan(kBlockSize);
   }
   if (!data.empty()) {
-    uint8_t* buf = Reserve(data.size());
+    uint8_t* buf = Reserve(data.size(), tb);
     std::memcpy(buf, data.data(), data.size());
   }
 }
 
-void DataLog::AppendStringImpl(std::string_view str) {
-  uint8_t* buf = Reserve(4);
+void DataLog::AppendStringImpl(std::string_view str, ThreadBuffer* tb) {
+  uint8_t* buf = Reserve(4, tb);
   wpi::util::support::endian::write32le(buf, str.size());
-  AppendImpl({reinterpret_cast<const uint8_t*>(str.data()), str.size()});
+  AppendImpl({reinterpret_cast<const uint8_t*>(str.data()), str.size()}, tb);
 }
 
 void DataLog::AppendRaw(int entry, std::span<const uint8_t> data,
@@ -324,12 +670,12 @@ void DataLog::AppendRaw(int entry, std::span<const uint8_t> data,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  StartRecord(entry, timestamp, data.size(), 0);
-  AppendImpl(data);
+  StartRecord(entry, timestamp, data.size(), 0, scope.tb);
+  AppendImpl(data, scope.tb);
 }
 
 void DataLog::AppendRaw2(int entry,
@@ -338,7 +684,7 @@ void DataLog::AppendRaw2(int entry,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
@@ -346,9 +692,9 @@ void DataLog::AppendRaw2(int entry,
   for (auto&& chunk : data) {
     size += chunk.size();
   }
-  StartRecord(entry, timestamp, size, 0);
+  StartRecord(entry, timestamp, size, 0, scope.tb);
   for (auto chunk : data) {
-    AppendImpl(chunk);
+    AppendImpl(chunk, scope.tb);
   }
 }
 
@@ -356,11 +702,11 @@ void DataLog::AppendBoolean(int entry, bool value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 1, 1);
+  uint8_t* buf = StartRecord(entry, timestamp, 1, 1, scope.tb);
   buf[0] = value ? 1 : 0;
 }
 
@@ -368,11 +714,11 @@ void DataLog::AppendInteger(int entry, int64_t value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 8, 8);
+  uint8_t* buf = StartRecord(entry, timestamp, 8, 8, scope.tb);
   wpi::util::support::endian::write64le(buf, value);
 }
 
@@ -380,11 +726,11 @@ void DataLog::AppendFloat(int entry, float value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 4, 4);
+  uint8_t* buf = StartRecord(entry, timestamp, 4, 4, scope.tb);
   if constexpr (std::endian::native == std::endian::little) {
     std::memcpy(buf, &value, 4);
   } else {
@@ -396,11 +742,11 @@ void DataLog::AppendDouble(int entry, double value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 8, 8);
+  uint8_t* buf = StartRecord(entry, timestamp, 8, 8, scope.tb);
   if constexpr (std::endian::native == std::endian::little) {
     std::memcpy(buf, &value, 8);
   } else {
@@ -408,6 +754,100 @@ void DataLog::AppendDouble(int entry, double value, int64_t timestamp) {
   }
 }
 
+void DataLog::AppendPackedInteger(int entry, int64_t value,
+                                  int64_t timestamp) {
+  AppendPacked(entry, value, false, timestamp);
+}
+
+void DataLog::AppendPackedDouble(int entry, double value, int64_t timestamp) {
+  AppendPacked(entry, std::bit_cast<uint64_t>(value), true, timestamp);
+}
+
+void DataLog::AppendPacked(int entry, uint64_t value, bool isDouble,
+                           int64_t timestamp) {
+  if (entry <= 0) {
+    return;
+  }
+  // samples are delta encoded, so the timestamp must be resolved now
+  if (timestamp == 0) {
+    timestamp = wpi::util::Now();
+  }
+  std::scoped_lock lock{m_mutex};
+  if (m_paused) {
+    [[unlikely]] return;
+  }
+  auto& packed = m_packed[entry];
+  if (!packed) {
+    [[unlikely]] packed = std::make_unique<PackedEntry>();
+  }
+  if (packed->count != 0 && packed->isDouble != isDouble) {
+    [[unlikely]] FlushPacked(entry, *packed);
+  }
+  packed->isDouble = isDouble;
+  packed->Add(timestamp, value);
+  if (packed->count >= PackedEntry::kMaxSamples) {
+    FlushPacked(entry, *packed);
+  }
+}
+
+void DataLog::FlushPacked(int entry, PackedEntry& packed) {
+  if (packed.count == 0) {
+    return;
+  }
+  uint8_t countBuf[10];
+  unsigned int countLen = WriteLeb128(countBuf, packed.count);
+  StartRecord(entry, packed.firstTimestamp,
+              countLen + packed.timestamps.size() + packed.values.size(), 0);
+  AppendImpl({countBuf, countLen});
+  AppendImpl(packed.timestamps);
+  AppendImpl(packed.values);
+  packed.Clear();
+}
+
+void DataLog::FlushAllPacked() {
+  for (auto&& [entry, packed] : m_packed) {
+    FlushPacked(entry, *packed);
+  }
+}
+
+void DataLog::AppendBatch(const DataLogBatch& batch, int64_t timestamp) {
+  if (batch.IsEmpty()) {
+    return;
+  }
+  // records share the timestamp, so resolve it once
+  if (timestamp == 0) {
+    timestamp = wpi::util::Now();
+  }
+  AppendScope scope{*this};
+  if (m_paused) {
+    [[unlikely]] return;
+  }
+  const uint8_t* data = batch.m_data.data();
+  size_t maxSize =
+      batch.m_records.size() * kRecordMaxHeaderSize + batch.m_data.size();
+  if (maxSize > kBlockSize) {
+    // too large to reserve at once; still only locked once
+    for (auto&& record : batch.m_records) {
+      StartRecord(record.entry, timestamp, record.size, 0, scope.tb);
+      AppendImpl({data, record.size}, scope.tb);
+      data += record.size;
+    }
+    return;
+  }
+  uint8_t* start = Reserve(maxSize, scope.tb);
+  uint8_t* buf = start;
+  for (auto&& record : batch.m_records) {
+    buf += WriteRecordHeader(buf, record.entry, timestamp, record.size);
+    if (record.size != 0) {
+      std::memcpy(buf, data, record.size);
+      buf += record.size;
+      data += record.size;
+    }
+  }
+  size_t size = buf - start;
+  EndReserve(start, maxSize - size, timestamp, size, scope.tb);
+}
+
 void DataLog::AppendString(int entry, std::string_view value,
                            int64_t timestamp) {
   AppendRaw(entry,
@@ -420,20 +860,20 @@ void DataLog::AppendBooleanArray(int entry, std::span<const bool> arr,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  StartRecord(entry, timestamp, arr.size(), 0);
+  StartRecord(entry, timestamp, arr.size(), 0, scope.tb);
   uint8_t* buf;
   while (arr.size() > kBlockSize) {
-    buf = Reserve(kBlockSize);
+    buf = Reserve(kBlockSize, scope.tb);
     for (auto val : arr.subspan(0, kBlockSize)) {
       *buf++ = val ? 1 : 0;
     }
     arr = arr.subspan(kBlockSize);
   }
-  buf = Reserve(arr.size());
+  buf = Reserve(arr.size(), scope.tb);
   for (auto val : arr) {
     *buf++ = val ? 1 : 0;
   }
@@ -444,20 +884,20 @@ void DataLog::AppendBooleanArray(int entry, std::span<const int> arr,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  StartRecord(entry, timestamp, arr.size(), 0);
+  StartRecord(entry, timestamp, arr.size(), 0, scope.tb);
   uint8_t* buf;
   while (arr.size() > kBlockSize) {
-    buf = Reserve(kBlockSize);
+    buf = Reserve(kBlockSize, scope.tb);
     for (auto val : arr.subspan(0, kBlockSize)) {
       *buf++ = val & 1;
     }
     arr = arr.subspan(kBlockSize);
   }
-  buf = Reserve(arr.size());
+  buf = Reserve(arr.size(), scope.tb);
   for (auto val : arr) {
     *buf++ = val & 1;
   }
@@ -478,21 +918,21 @@ void DataLog::AppendIntegerArray(int entry, std::span<const int64_t> arr,
     if (entry <= 0) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
+    AppendScope scope{*this};
     if (m_paused) {
       [[unlikely]] return;
     }
-    StartRecord(entry, timestamp, arr.size() * 8, 0);
+    StartRecord(entry, timestamp, arr.size() * 8, 0, scope.tb);
     uint8_t* buf;
     while ((arr.size() * 8) > kBlockSize) {
-      buf = Reserve(kBlockSize);
+      buf = Reserve(kBlockSize, scope.tb);
       for (auto val : arr.subspan(0, kBlockSize / 8)) {
         wpi::util::support::endian::write64le(buf, val);
         buf += 8;
       }
       arr = arr.subspan(kBlockSize / 8);
     }
-    buf = Reserve(arr.size() * 8);
+    buf = Reserve(arr.size() * 8, scope.tb);
     for (auto val : arr) {
       wpi::util::support::endian::write64le(buf, val);
       buf += 8;
@@ -510,14 +950,14 @@ void DataLog::AppendFloatArray(int entry, std::span<const float> arr,
     if (entry <= 0) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
+    AppendScope scope{*this};
     if (m_paused) {
       [[unlikely]] return;
     }
-    StartRecord(entry, timestamp, arr.size() * 4, 0);
+    StartRecord(entry, timestamp, arr.size() * 4, 0, scope.tb);
     uint8_t* buf;
     while ((arr.size() * 4) > kBlockSize) {
-      buf = Reserve(kBlockSize);
+      buf = Reserve(kBlockSize, scope.tb);
       for (auto val : arr.subspan(0, kBlockSize / 4)) {
         wpi::util::support::endian::write32le(buf,
                                               std::bit_cast<uint32_t>(val));
@@ -525,7 +965,7 @@ void DataLog::AppendFloatArray(int entry, std::span<const float> arr,
       }
       arr = arr.subspan(kBlockSize / 4);
     }
-    buf = Reserve(arr.size() * 4);
+    buf = Reserve(arr.size() * 4, scope.tb);
     for (auto val : arr) {
       wpi::util::support::endian::write32le(buf, std::bit_cast<uint32_t>(val));
       buf += 4;
@@ -543,14 +983,14 @@ void DataLog::AppendDoubleArray(int entry, std::span<const double> arr,
     if (entry <= 0) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
+    AppendScope scope{*this};
     if (m_paused) {
       [[unlikely]] return;
     }
-    StartRecord(entry, timestamp, arr.size() * 8, 0);
+    StartRecord(entry, timestamp, arr.size() * 8, 0, scope.tb);
     uint8_t* buf;
     while ((arr.size() * 8) > kBlockSize) {
-      buf = Reserve(kBlockSize);
+      buf = Reserve(kBlockSize, scope.tb);
       for (auto val : arr.subspan(0, kBlockSize / 8)) {
         wpi::util::support::endian::write64le(buf,
                                               std::bit_cast<uint64_t>(val));
@@ -558,7 +998,7 @@ void DataLog::AppendDoubleArray(int entry, std::span<const double> arr,
       }
       arr = arr.subspan(kBlockSize / 8);
     }
-    buf = Reserve(arr.size() * 8);
+    buf = Reserve(arr.size() * 8, scope.tb);
     for (auto val : arr) {
       wpi::util::support::endian::write64le(buf, std::bit_cast<uint64_t>(val));
       buf += 8;
@@ -577,14 +1017,14 @@ void DataLog::AppendStringArray(int entry, std::span<const std::string> arr,
   for (auto&& str : arr) {
     size += 4 + str.size();
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  uint8_t* buf = StartRecord(entry, timestamp, size, 4, scope.tb);
   wpi::util::support::endian::write32le(buf, arr.size());
   for (auto&& str : arr) {
-    AppendStringImpl(str);
+    AppendStringImpl(str, scope.tb);
   }
 }
 
@@ -600,14 +1040,14 @@ void DataLog::AppendStringArray(int entry,
   for (auto&& str : arr) {
     size += 4 + str.size();
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  uint8_t* buf = StartRecord(entry, timestamp, size, 4, scope.tb);
   wpi::util::support::endian::write32le(buf, arr.size());
   for (auto&& sv : arr) {
-    AppendStringImpl(sv);
+    AppendStringImpl(sv, scope.tb);
   }
 }
 
@@ -623,17 +1063,140 @@ void DataLog::AppendStringArray(int entry,
   for (auto&& str : arr) {
     size += 4 + str.len;
   }
-  std::scoped_lock lock{m_mutex};
+  AppendScope scope{*this};
   if (m_paused) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  uint8_t* buf = StartRecord(entry, timestamp, size, 4, scope.tb);
   wpi::util::support::endian::write32le(buf, arr.size());
   for (auto&& sv : arr) {
-    AppendStringImpl(sv.str);
+    AppendStringImpl(sv.str, scope.tb);
+  }
+}
+
+uint8_t* DataLogBatch::AddRecord(int entry, size_t size) {
+  if (entry <= 0 || size > UINT32_MAX) {
+    return nullptr;
+  }
+  m_records.emplace_back(Record{entry, static_cast<uint32_t>(size)});
+  size_t pos = m_data.size();
+  m_data.resize(pos + size);
+  return m_data.data() + pos;
+}
+
+void DataLogBatch::AppendRaw(int entry, std::span<const uint8_t> data) {
+  if (uint8_t* buf = AddRecord(entry, data.size()); buf && !data.empty()) {
+    std::memcpy(buf, data.data(), data.size());
+  }
+}
+
+void DataLogBatch::AppendBoolean(int entry, bool value) {
+  if (uint8_t* buf = AddRecord(entry, 1)) {
+    buf[0] = value ? 1 : 0;
+  }
+}
+
+void DataLogBatch::AppendInteger(int entry, int64_t value) {
+  if (uint8_t* buf = AddRecord(entry, 8)) {
+    wpi::util::support::endian::write64le(buf, value);
+  }
+}
+
+void DataLogBatch::AppendFloat(int entry, float value) {
+  if (uint8_t* buf = AddRecord(entry, 4)) {
+    wpi::util::support::endian::write32le(buf, std::bit_cast<uint32_t>(value));
+  }
+}
+
+void DataLogBatch::AppendDouble(int entry, double value) {
+  if (uint8_t* buf = AddRecord(entry, 8)) {
+    wpi::util::support::endian::write64le(buf, std::bit_cast<uint64_t>(value));
   }
 }
 
+void DataLogBatch::AppendString(int entry, std::string_view value) {
+  AppendRaw(entry,
+            {reinterpret_cast<const uint8_t*>(value.data()), value.size()});
+}
+
+void DataLogBatch::AppendBooleanArray(int entry, std::span<const bool> arr) {
+  if (uint8_t* buf = AddRecord(entry, arr.size())) {
+    for (auto val : arr) {
+      *buf++ = val ? 1 : 0;
+    }
+  }
+}
+
+void DataLogBatch::AppendBooleanArray(int entry, std::span<const int> arr) {
+  if (uint8_t* buf = AddRecord(entry, arr.size())) {
+    for (auto val : arr) {
+      *buf++ = val & 1;
+    }
+  }
+}
+
+void DataLogBatch::AppendBooleanArray(int entry, std::span<const uint8_t> arr) {
+  AppendRaw(entry, arr);
+}
+
+void DataLogBatch::AppendIntegerArray(int entry,
+                                      std::span<const int64_t> arr) {
+  if (uint8_t* buf = AddRecord(entry, arr.size() * 8)) {
+    for (auto val : arr) {
+      wpi::util::support::endian::write64le(buf, val);
+      buf += 8;
+    }
+  }
+}
+
+void DataLogBatch::AppendFloatArray(int entry, std::span<const float> arr) {
+  if (uint8_t* buf = AddRecord(entry, arr.size() * 4)) {
+    for (auto val : arr) {
+      wpi::util::support::endian::write32le(buf, std::bit_cast<uint32_t>(val));
+      buf += 4;
+    }
+  }
+}
+
+void DataLogBatch::AppendDoubleArray(int entry, std::span<const double> arr) {
+  if (uint8_t* buf = AddRecord(entry, arr.size() * 8)) {
+    for (auto val : arr) {
+      wpi::util::support::endian::write64le(buf, std::bit_cast<uint64_t>(val));
+      buf += 8;
+    }
+  }
+}
+
+template <typename T>
+void DataLogBatch::AppendStringArrayImpl(int entry, std::span<const T> arr) {
+  // storage: 4-byte array length, each string prefixed by 4-byte length
+  size_t size = 4;
+  for (auto&& str : arr) {
+    size += 4 + str.size();
+  }
+  uint8_t* buf = AddRecord(entry, size);
+  if (!buf) {
+    return;
+  }
+  wpi::util::support::endian::write32le(buf, arr.size());
+  buf += 4;
+  for (auto&& str : arr) {
+    wpi::util::support::endian::write32le(buf, str.size());
+    buf += 4;
+    buf = std::copy(str.begin(), str.end(), buf);
+  }
+}
+
+void DataLogBatch::AppendStringArray(int entry,
+                                     std::span<const std::string> arr) {
+  AppendStringArrayImpl(entry, arr);
+}
+
+void DataLogBatch::AppendStringArray(int entry,
+                                     std::span<const std::string_view> arr) {
+  AppendStringArrayImpl(entry, arr);
+}
+
 template <typename V1, typename V2>
 inline bool UpdateImpl(std::optional<std::vector<V1>>& lastValue,
                        std::span<const V2> data) {
@@ -8,6 +8,10 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -17,16 +21,23 @@
 
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <chrono>
 #include <format>
+#include <memory>
+#include <optional>
 #include <random>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "UringFile.hpp"
 #include "wpi/util/Logger.hpp"
 #include "wpi/util/fs.hpp"
 #include "wpi/util/string.hpp"
+#include "wpi/util/timestamp.h"
 
 using namespace wpi::log;
 
@@ -100,6 +111,17 @@ void DataLogBackgroundWriter::SetFilename(std::string_view filename) {
   m_cond.notify_one();
 }
 
+void DataLogBackgroundWriter::SetWriteOptions(const WriteOptions& options) {
+  std::scoped_lock lock{m_mutex};
+  m_options = options;
+}
+
+DataLogBackgroundWriter::WriteStats DataLogBackgroundWriter::GetWriteStats()
+    const {
+  std::scoped_lock lock{m_statsMutex};
+  return m_stats;
+}
+
 void DataLogBackgroundWriter::Flush() {
   {
     std::scoped_lock lock{m_mutex};
@@ -136,7 +158,7 @@ void DataLogBackgroundWriter::Stop() {
   m_cond.notify_one();
 }
 
-static void WriteToFile(fs::file_t f, std::span<const uint8_t> data,
+static bool WriteToFile(fs::file_t f, std::span<const uint8_t> data,
                         std::string_view filename, wpi::util::Logger& msglog) {
   do {
 #ifdef _WIN32
@@ -144,7 +166,7 @@ static void WriteToFile(fs::file_t f, std::span<const uint8_t> data,
     if (!WriteFile(f, data.data(), data.size(), &ret, nullptr)) {
       WPI_ERROR(msglog, "Error writing to log file '{}': {}", filename,
                 GetLastError());
-      break;
+      return false;
     }
 #else
     ssize_t ret = ::write(f, data.data(), data.size());
@@ -157,13 +179,52 @@ static void WriteToFile(fs::file_t f, std::span<const uint8_t> data,
       // Otherwise it's a non-recoverable error; quit trying
       WPI_ERROR(msglog, "Error writing to log file '{}': {}", filename,
                 std::strerror(errno));
-      break;
+      return false;
     }
 #endif
 
     // The write may have written some or all of the data
     data = data.subspan(ret);
   } while (data.size() > 0);
+  return true;
+}
+
+#ifdef __linux__
+static bool WriteToFileAt(int fd, std::span<const uint8_t> data,
+                          uint64_t offset, std::string_view filename,
+                          wpi::util::Logger& msglog) {
+  while (!data.empty()) {
+    ssize_t ret = ::pwrite(fd, data.data(), data.size(), offset);
+    if (ret < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+        continue;
+      }
+      WPI_ERROR(msglog, "Error writing to log file '{}': {}", filename,
+                std::strerror(errno));
+      return false;
+    }
+    data = data.subspan(ret);
+    offset += ret;
+  }
+  return true;
+}
+#endif
+
+static void SyncFile(fs::file_t f) {
+#if defined(__linux__)
+  ::fdatasync(f);
+#elif defined(__APPLE__)
+  ::fsync(f);
+#endif
+}
+
+static void AddLatency(
+    std::array<uint64_t,
+               DataLogBackgroundWriter::WriteStats::kNumLatencyBuckets>& hist,
+    uint64_t latency) {
+  // bucket 0 is < 32 us, each following bucket doubles the limit
+  size_t bucket = std::bit_width(latency >> 5);
+  hist[std::min(bucket, hist.size() - 1)]++;
 }
 
 static std::string MakeRandomFilename() {
@@ -188,10 +249,23 @@ struct DataLogBackgroundWriter::WriterThreadState {
   ~WriterThreadState() { Close(); }
 
   void Close() {
+    // wait for outstanding asynchronous writes before closing the file
+    ring.reset();
     if (f != WPI_INVALID_FILE) {
+#ifdef __linux__
+      // release preallocated space past the end of the data
+      if (allocated > offset) {
+        [[maybe_unused]] int rv = ::ftruncate(f, offset);
+      }
+#endif
       fs::CloseFile(f);
       f = WPI_INVALID_FILE;
     }
+    offset = 0;
+    allocated = 0;
+    syncCount = 0;
+    asyncFailed = false;
+    preallocateFailed = false;
   }
 
   void SetFilename(std::string_view fn) {
@@ -215,6 +289,33 @@ struct DataLogBackgroundWriter::WriterThreadState {
   fs::file_t f = WPI_INVALID_FILE;
   uintmax_t freeSpace = UINTMAX_MAX;
   int segmentCount = 1;
+
+  // write options in effect
+  WriteOptions options;
+  // file offset for the next write
+  uint64_t offset = 0;
+  // end of the preallocated file space
+  uint64_t allocated = 0;
+  // number of flushes since the last sync
+  int syncCount = 0;
+  bool preallocateFailed = false;
+
+  // asynchronous writes
+  struct PendingWrite {
+    uint64_t id;
+    // empty for syncs
+    std::optional<DataLog::Buffer> buf;
+    uint64_t offset;
+    uint64_t startTime;
+  };
+  std::unique_ptr<detail::UringFile> ring;
+  int ringDepth = 0;
+  uint64_t nextId = 0;
+  // set by the completion thread when an asynchronous write fails
+  std::atomic_bool asyncFailed = false;
+  wpi::util::mutex asyncMutex;
+  std::vector<PendingWrite> pending;  // protected by asyncMutex
+  std::vector<DataLog::Buffer> done;  // protected by asyncMutex
 };
 
 void DataLogBackgroundWriter::BufferHalfFull() {
@@ -283,6 +384,199 @@ void DataLogBackgroundWriter::StartLogFile(WriterThreadState& state) {
   }
 }
 
+void DataLogBackgroundWriter::ApplyWriteOptions(WriterThreadState& state) {
+  const auto& options = state.options;
+  bool async = options.asyncWrites && !state.asyncFailed;
+  if (state.ring && (!async || state.ringDepth != options.queueDepth)) {
+    state.ring.reset();
+#ifdef __linux__
+    // write() relies on append mode to continue after the last async write
+    ::fcntl(state.f, F_SETFL, ::fcntl(state.f, F_GETFL) | O_APPEND);
+#endif
+  }
+  if (async && !state.ring) {
+    std::error_code ec;
+    state.ring = detail::UringFile::Create(
+        state.f, std::max(options.queueDepth, 1),
+        [this, &state, filename = state.filename](uint64_t id, int result) {
+          WriteComplete(state, id, result, filename);
+        },
+        ec);
+    if (!state.ring) {
+      WPI_INFO(m_msglog, "Asynchronous log writes not available: {}",
+               ec.message());
+      state.asyncFailed = true;
+      return;
+    }
+    state.ringDepth = options.queueDepth;
+#ifdef __linux__
+    // async writes are made at explicit offsets, which append mode ignores
+    ::fcntl(state.f, F_SETFL, ::fcntl(state.f, F_GETFL) & ~O_APPEND);
+#endif
+  }
+}
+
+void DataLogBackgroundWriter::Preallocate(WriterThreadState& state,
+                                          uint64_t size) {
+#ifdef __linux__
+  uint64_t end = state.offset + size;
+  if (state.options.preallocateSize == 0 || state.preallocateFailed ||
+      end <= state.allocated) {
+    return;
+  }
+  uint64_t newAllocated = end + state.options.preallocateSize;
+  if (::fallocate(state.f, FALLOC_FL_KEEP_SIZE, state.allocated,
+                  newAllocated - state.allocated) == 0) {
+    state.allocated = newAllocated;
+  } else {
+    WPI_INFO(m_msglog, "Could not preallocate space for log file '{}': {}",
+             state.filename, std::strerror(errno));
+    state.preallocateFailed = true;
+  }
+#endif
+}
+
+void DataLogBackgroundWriter::WriteBufs(WriterThreadState& state,
+                                        std::vector<DataLog::Buffer>& bufs,
+                                        size_t count) {
+  bool sync = state.options.syncInterval > 0 &&
+              ++state.syncCount >= state.options.syncInterval;
+  if (sync) {
+    state.syncCount = 0;
+  }
+
+  if (state.ring) {
+    for (auto&& buf : std::span{bufs}.first(count)) {
+      uint64_t size = buf.GetData().size();
+      Preallocate(state, size);
+      uint64_t id = state.nextId++;
+      std::span<const uint8_t> data = buf.GetData();
+      {
+        std::scoped_lock lock{state.asyncMutex};
+        state.pending.emplace_back(id, std::move(buf), state.offset,
+                                   wpi::util::Now());
+      }
+      {
+        std::scoped_lock lock{m_statsMutex};
+        m_stats.maxQueueDepth =
+            std::max(m_stats.maxQueueDepth, ++m_stats.queueDepth);
+      }
+      state.ring->QueueWrite(data, state.offset, id);
+      state.offset += size;
+    }
+    bufs.erase(bufs.begin(), bufs.begin() + count);
+
+    if (sync) {
+      uint64_t id = state.nextId++;
+      {
+        std::scoped_lock lock{state.asyncMutex};
+        state.pending.emplace_back(id, std::nullopt, 0, wpi::util::Now());
+      }
+      {
+        std::scoped_lock lock{m_statsMutex};
+        m_stats.maxQueueDepth =
+            std::max(m_stats.maxQueueDepth, ++m_stats.queueDepth);
+      }
+      state.ring->QueueSync(id);
+    }
+
+    if (!state.ring->Submit()) {
+      // the unsubmitted writes were completed synchronously with the error
+      WPI_ERROR(m_msglog, "Error submitting writes to log file '{}': {}",
+                state.filename, std::strerror(errno));
+      state.asyncFailed = true;
+    }
+    return;
+  }
+
+  for (auto&& buf : std::span{bufs}.first(count)) {
+    auto data = buf.GetData();
+    Preallocate(state, data.size());
+    uint64_t start = wpi::util::Now();
+    bool ok = WriteToFile(state.f, data, state.filename, m_msglog);
+    uint64_t latency = wpi::util::Now() - start;
+    state.offset += data.size();
+    std::scoped_lock lock{m_statsMutex};
+    if (ok) {
+      ++m_stats.writes;
+      m_stats.bytesWritten += data.size();
+    } else {
+      ++m_stats.errors;
+    }
+    AddLatency(m_stats.writeLatency, latency);
+  }
+
+  // sync to storage
+  if (sync) {
+    uint64_t start = wpi::util::Now();
+    SyncFile(state.f);
+    uint64_t latency = wpi::util::Now() - start;
+    std::scoped_lock lock{m_statsMutex};
+    ++m_stats.syncs;
+    AddLatency(m_stats.syncLatency, latency);
+  }
+}
+
+void DataLogBackgroundWriter::WriteComplete(WriterThreadState& state,
+                                            uint64_t id, int result,
+                                            std::string_view filename) {
+  uint64_t now = wpi::util::Now();
+  std::optional<DataLog::Buffer> buf;
+  uint64_t offset = 0;
+  uint64_t startTime = now;
+  {
+    std::scoped_lock lock{state.asyncMutex};
+    auto it = std::find_if(state.pending.begin(), state.pending.end(),
+                           [&](const auto& write) { return write.id == id; });
+    if (it != state.pending.end()) {
+      buf = std::move(it->buf);
+      offset = it->offset;
+      startTime = it->startTime;
+      state.pending.erase(it);
+    }
+  }
+
+  bool ok = result >= 0;
+  if (!ok) {
+    WPI_ERROR(m_msglog, "Error {} log file '{}': {}",
+              buf ? "writing to" : "syncing", filename,
+              std::strerror(-result));
+    // fall back to write() for the rest of this file
+    state.asyncFailed = true;
+  }
+  size_t size = buf ? buf->GetData().size() : 0;
+  if (buf && static_cast<size_t>(std::max(result, 0)) < size) {
+    // finish a failed or short write synchronously
+#ifdef __linux__
+    size_t written = std::max(result, 0);
+    ok = WriteToFileAt(state.f, buf->GetData().subspan(written),
+                       offset + written, filename, m_msglog);
+#else
+    ok = false;
+#endif
+  }
+
+  {
+    std::scoped_lock lock{m_statsMutex};
+    --m_stats.queueDepth;
+    if (!ok) {
+      ++m_stats.errors;
+    } else if (buf) {
+      ++m_stats.writes;
+      m_stats.bytesWritten += size;
+    } else {
+      ++m_stats.syncs;
+    }
+    AddLatency(buf ? m_stats.writeLatency : m_stats.syncLatency,
+               now - startTime);
+  }
+
+  if (buf) {
+    std::scoped_lock lock{state.asyncMutex};
+    state.done.emplace_back(std::move(*buf));
+  }
+}
+
 void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
   std::chrono::duration<double> periodTime{m_period};
 
@@ -382,7 +676,9 @@ void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
       }
 
       if (state.f != WPI_INVALID_FILE && !blocked) {
+        state.options = m_options;
         lock.unlock();
+        ApplyWriteOptions(state);
 
         // update free space every 10 flushes (in case other things are writing)
         if (++freeSpaceCount >= 10) {
@@ -396,6 +692,7 @@ void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
         }
 
         // write buffers to file
+        size_t count = 0;
         for (auto&& buf : toWrite) {
           // stop writing when we go below the minimum free space
           state.freeSpace -= buf.GetData().size();
@@ -408,23 +705,25 @@ void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
             blocked = true;
             break;
           }
-          WriteToFile(state.f, buf.GetData(), state.filename, m_msglog);
+          ++count;
         }
-
-        // sync to storage
-#if defined(__linux__)
-        ::fdatasync(state.f);
-#elif defined(__APPLE__)
-        ::fsync(state.f);
-#endif
+        WriteBufs(state, toWrite, count);
         lock.lock();
         if (blocked) {
           [[unlikely]] m_state = kPaused;
         }
       }
 
-      // release buffers back to free list
+      // release buffers back to free list, including those from completed
+      // asynchronous writes
       lock.unlock();
+      {
+        std::scoped_lock asyncLock{state.asyncMutex};
+        for (auto&& buf : state.done) {
+          toWrite.emplace_back(std::move(buf));
+        }
+        state.done.clear();
+      }
       ReleaseBufs(&toWrite);
       lock.lock();
     }
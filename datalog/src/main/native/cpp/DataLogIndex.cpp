@@ -0,0 +1,348 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/datalog/DataLogIndex.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "wpi/datalog/DataLogReader.hpp"
+#include "wpi/util/Endian.hpp"
+#include "wpi/util/MemoryBuffer.hpp"
+#include "wpi/util/raw_ostream.hpp"
+
+using namespace wpi::log;
+
+// Sidecar file format (all values little endian):
+// 8-byte magic "WPILOGIX"
+// 2-byte version (0x0102)
+// 8-byte indexed log size
+// 8-byte log file size
+// 8-byte log hash
+// 8-byte total record count
+// 4-byte control record count, followed by 8-byte offset per record
+// 4-byte unfinished entry count, followed by 4-byte entry ID and 8-byte Start
+// record offset per entry
+// 4-byte entry count, followed by for each entry:
+//   4-byte entry ID
+//   8-byte Start record offset
+//   4-byte record count, followed by 8-byte timestamp and 8-byte offset per
+//   record
+static constexpr std::string_view kMagic = "WPILOGIX";
+static constexpr uint16_t kVersion = 0x0102;
+
+// Only the start of the log and the bytes just before the end of the indexed
+// records are hashed.  Together with the sizes, this is enough to detect the
+// index being used with a different log (or one with the same header, such as
+// a log of the same program) without reading the whole file.
+static constexpr size_t kHashSize = 4096;
+
+static uint64_t HashLog(std::span<const uint8_t> buf, size_t end) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  auto update = [&](std::span<const uint8_t> data) {
+    for (auto v : data) {
+      hash ^= v;
+      hash *= 1099511628211ull;
+    }
+  };
+  end = std::min(end, buf.size());
+  update(buf.subspan(0, std::min(end, kHashSize)));
+  if (end > kHashSize) {
+    size_t start = std::max(kHashSize, end - kHashSize);
+    update(buf.subspan(start, end - start));
+  }
+  return hash;
+}
+
+namespace {
+class IndexWriter {
+ public:
+  explicit IndexWriter(wpi::util::raw_ostream& os) : m_os{os} {}
+
+  void Write16(uint16_t val) {
+    uint8_t buf[2];
+    wpi::util::support::endian::write16le(buf, val);
+    m_os << std::span<const uint8_t>{buf};
+  }
+
+  void Write32(uint32_t val) {
+    uint8_t buf[4];
+    wpi::util::support::endian::write32le(buf, val);
+    m_os << std::span<const uint8_t>{buf};
+  }
+
+  void Write64(uint64_t val) {
+    uint8_t buf[8];
+    wpi::util::support::endian::write64le(buf, val);
+    m_os << std::span<const uint8_t>{buf};
+  }
+
+ private:
+  wpi::util::raw_ostream& m_os;
+};
+
+class IndexParser {
+ public:
+  explicit IndexParser(std::span<const uint8_t> buf) : m_buf{buf} {}
+
+  bool Read16(uint16_t* val) {
+    if (m_buf.size() < 2) {
+      return false;
+    }
+    *val = wpi::util::support::endian::read16le(m_buf.data());
+    m_buf = m_buf.subspan(2);
+    return true;
+  }
+
+  bool Read32(uint32_t* val) {
+    if (m_buf.size() < 4) {
+      return false;
+    }
+    *val = wpi::util::support::endian::read32le(m_buf.data());
+    m_buf = m_buf.subspan(4);
+    return true;
+  }
+
+  bool Read64(uint64_t* val) {
+    if (m_buf.size() < 8) {
+      return false;
+    }
+    *val = wpi::util::support::endian::read64le(m_buf.data());
+    m_buf = m_buf.subspan(8);
+    return true;
+  }
+
+  size_t GetRemaining() const { return m_buf.size(); }
+
+ private:
+  std::span<const uint8_t> m_buf;
+};
+}  // namespace
+
+DataLogIndex DataLogIndex::Build(const DataLogReader& reader) {
+  DataLogIndex index;
+  index.Update(reader);
+  return index;
+}
+
+std::optional<DataLogIndex> DataLogIndex::Load(std::string_view filename,
+                                               const DataLogReader& reader) {
+  auto fileBuffer = wpi::util::MemoryBuffer::GetFile(filename);
+  if (!fileBuffer) {
+    return std::nullopt;
+  }
+  auto buf = (*fileBuffer)->GetBuffer();
+  if (buf.size() < kMagic.size() ||
+      std::string_view{reinterpret_cast<const char*>(buf.data()),
+                       kMagic.size()} != kMagic) {
+    return std::nullopt;
+  }
+  IndexParser parser{buf.subspan(kMagic.size())};
+
+  DataLogIndex index;
+  uint16_t version;
+  uint64_t end, logSize, hash, numRecords;
+  uint32_t numControl;
+  if (!parser.Read16(&version) || version != kVersion ||
+      !parser.Read64(&end) || !parser.Read64(&logSize) ||
+      !parser.Read64(&hash) || !parser.Read64(&numRecords) ||
+      !parser.Read32(&numControl) ||
+      numControl > parser.GetRemaining() / 8) {
+    return std::nullopt;
+  }
+
+  // check against the log before reading the rest; logs only grow, so a
+  // smaller log is a different one
+  auto logBuf = reader.GetBuffer();
+  if (end > logSize || logSize > logBuf.size() ||
+      HashLog(logBuf, end) != hash) {
+    return std::nullopt;
+  }
+  index.m_end = end;
+  index.m_logSize = logSize;
+  index.m_hash = hash;
+  index.m_numRecords = numRecords;
+
+  index.m_control.reserve(numControl);
+  for (uint32_t i = 0; i < numControl; ++i) {
+    uint64_t offset;
+    parser.Read64(&offset);
+    index.m_control.emplace_back(offset);
+  }
+
+  uint32_t numLive;
+  if (!parser.Read32(&numLive) || numLive > parser.GetRemaining() / 12) {
+    return std::nullopt;
+  }
+  for (uint32_t i = 0; i < numLive; ++i) {
+    uint32_t entry;
+    uint64_t start;
+    parser.Read32(&entry);
+    parser.Read64(&start);
+    index.m_live[entry] = start;
+  }
+
+  uint32_t numEntries;
+  if (!parser.Read32(&numEntries)) {
+    return std::nullopt;
+  }
+  for (uint32_t i = 0; i < numEntries; ++i) {
+    uint32_t entry, count;
+    uint64_t start;
+    if (!parser.Read32(&entry) || !parser.Read64(&start) ||
+        !parser.Read32(&count) || count > parser.GetRemaining() / 16) {
+      return std::nullopt;
+    }
+    auto& records = index.m_records[{entry, start}];
+    records.reserve(count);
+    for (uint32_t j = 0; j < count; ++j) {
+      uint64_t timestamp, offset;
+      parser.Read64(&timestamp);
+      parser.Read64(&offset);
+      records.emplace_back(static_cast<int64_t>(timestamp), offset);
+    }
+  }
+
+  // pick up any records added since the index was saved
+  index.Update(reader);
+  return index;
+}
+
+DataLogIndex DataLogIndex::Open(std::string_view filename,
+                                const DataLogReader& reader) {
+  auto index = Load(filename, reader);
+  size_t savedEnd = index ? index->m_end : 0;
+  if (!index) {
+    index = Build(reader);
+  }
+  if (index->m_end != savedEnd) {
+    std::error_code ec;
+    index->Save(filename, ec);
+  }
+  return std::move(*index);
+}
+
+bool DataLogIndex::Save(std::string_view filename, std::error_code& ec) const {
+  wpi::util::raw_fd_ostream os{filename, ec};
+  if (ec) {
+    return false;
+  }
+  IndexWriter writer{os};
+  os << kMagic;
+  writer.Write16(kVersion);
+  writer.Write64(m_end);
+  writer.Write64(m_logSize);
+  writer.Write64(m_hash);
+  writer.Write64(m_numRecords);
+  writer.Write32(m_control.size());
+  for (auto offset : m_control) {
+    writer.Write64(offset);
+  }
+  writer.Write32(m_live.size());
+  for (auto&& [entry, start] : m_live) {
+    writer.Write32(entry);
+    writer.Write64(start);
+  }
+  writer.Write32(m_records.size());
+  for (auto&& [key, records] : m_records) {
+    writer.Write32(key.first);
+    writer.Write64(key.second);
+    writer.Write32(records.size());
+    for (auto&& record : records) {
+      writer.Write64(record.timestamp);
+      writer.Write64(record.offset);
+    }
+  }
+  os.close();
+  if (os.has_error()) {
+    ec = os.error();
+    os.clear_error();
+    return false;
+  }
+  return true;
+}
+
+bool DataLogIndex::Update(const DataLogReader& reader) {
+  auto buf = reader.GetBuffer();
+  if (m_logSize > buf.size() || HashLog(buf, m_end) != m_hash) {
+    *this = DataLogIndex{};
+  }
+
+  size_t numRecords = m_numRecords;
+  for (auto it = m_end == 0 ? reader.begin() : reader.At(m_end),
+            end = reader.end();
+       it != end; ++it) {
+    auto& record = *it;
+    if (record.GetEntry() < 0) {
+      break;  // incomplete trailing record
+    }
+    ++m_numRecords;
+    if (record.IsControl()) {
+      m_control.emplace_back(it.GetOffset());
+      StartRecordData startData;
+      int entry;
+      if (record.GetStartData(&startData)) {
+        m_live[startData.entry] = it.GetOffset();
+      } else if (record.GetFinishEntry(&entry)) {
+        m_live.erase(entry);
+      }
+    } else {
+      auto live = m_live.find(record.GetEntry());
+      size_t start = live == m_live.end() ? 0 : live->second;
+      m_records[{record.GetEntry(), start}].emplace_back(record.GetTimestamp(),
+                                                         it.GetOffset());
+    }
+    m_end = record.GetRaw().data() + record.GetSize() - buf.data();
+  }
+  m_logSize = buf.size();
+  m_hash = HashLog(buf, m_end);
+  if (numRecords == m_numRecords) {
+    return false;
+  }
+
+  // records are usually appended in timestamp order, but this isn't
+  // guaranteed
+  for (auto&& records : m_records) {
+    auto cmp = [](const Record& a, const Record& b) {
+      return a.timestamp < b.timestamp;
+    };
+    if (!std::is_sorted(records.second.begin(), records.second.end(), cmp)) {
+      std::stable_sort(records.second.begin(), records.second.end(), cmp);
+    }
+  }
+  return true;
+}
+
+std::vector<DataLogIndex::Entry> DataLogIndex::GetEntries() const {
+  std::vector<Entry> entries;
+  entries.reserve(m_records.size());
+  for (auto&& records : m_records) {
+    entries.emplace_back(records.first.first, records.first.second);
+  }
+  return entries;
+}
+
+std::span<const DataLogIndex::Record> DataLogIndex::GetRecords(
+    int entry, size_t start) const {
+  auto it = m_records.find({entry, start});
+  if (it == m_records.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::span<const DataLogIndex::Record> DataLogIndex::GetRecords(
+    int entry, size_t start, int64_t startTime, int64_t endTime) const {
+  auto records = GetRecords(entry, start);
+  auto first = std::lower_bound(
+      records.begin(), records.end(), startTime,
+      [](const Record& r, int64_t t) { return r.timestamp < t; });
+  auto last = std::lower_bound(
+      first, records.end(), endTime,
+      [](const Record& r, int64_t t) { return r.timestamp < t; });
+  return {first, last};
+}
@@ -4,9 +4,11 @@
 
 #include "wpi/datalog/DataLogReader.hpp"
 
+#include <algorithm>
 #include <bit>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "wpi/datalog/DataLog.hpp"
 #include "wpi/util/Endian.hpp"
@@ -225,6 +227,172 @@ bool DataLogRecord::GetStringArray(std::vector<std::string_view>* arr) const {
   return true;
 }
 
+static bool ReadLeb128(std::span<const uint8_t>* buf, uint64_t* val) {
+  uint64_t result = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7) {
+    if (buf->empty()) {
+      return false;
+    }
+    uint8_t byte = buf->front();
+    *buf = buf->subspan(1);
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *val = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+static uint64_t ZigZagDecode(uint64_t val) {
+  return (val >> 1) ^ (~(val & 1) + 1);
+}
+
+// Reads the sample count and timestamps of a packed record; on success, buf
+// is left pointing to the encoded values.
+static bool ReadPackedTimestamps(std::span<const uint8_t>* buf, int64_t first,
+                                 std::vector<int64_t>* timestamps) {
+  uint64_t count;
+  // each timestamp after the first takes at least one byte
+  if (!ReadLeb128(buf, &count) || count == 0 || count - 1 > buf->size()) {
+    return false;
+  }
+  timestamps->reserve(count);
+  timestamps->push_back(first);
+  // unsigned arithmetic so differences wrap instead of overflowing
+  uint64_t timestamp = first;
+  uint64_t delta = 0;
+  for (uint64_t i = 1; i < count; ++i) {
+    uint64_t dod;
+    if (!ReadLeb128(buf, &dod)) {
+      timestamps->clear();
+      return false;
+    }
+    delta += ZigZagDecode(dod);
+    timestamp += delta;
+    timestamps->push_back(timestamp);
+  }
+  return true;
+}
+
+namespace {
+// Reads a most significant bit first bit stream.
+class BitReader {
+ public:
+  explicit BitReader(std::span<const uint8_t> buf) : m_buf{buf} {}
+
+  bool Read(unsigned int len, uint64_t* out) {
+    if (len > GetRemaining()) {
+      return false;
+    }
+    uint64_t val = 0;
+    while (len > 0) {
+      unsigned int bit = m_pos % 8;
+      unsigned int n = std::min(len, 8 - bit);
+      val = (val << n) |
+            ((m_buf[m_pos / 8] >> (8 - bit - n)) & ((1u << n) - 1));
+      m_pos += n;
+      len -= n;
+    }
+    *out = val;
+    return true;
+  }
+
+  size_t GetRemaining() const { return m_buf.size() * 8 - m_pos; }
+
+ private:
+  std::span<const uint8_t> m_buf;
+  size_t m_pos = 0;
+};
+}  // namespace
+
+bool DataLogRecord::GetPackedIntegers(std::vector<int64_t>* timestamps,
+                                      std::vector<int64_t>* values) const {
+  values->clear();
+  timestamps->clear();
+  auto buf = m_data;
+  if (!ReadPackedTimestamps(&buf, m_timestamp, timestamps)) {
+    return false;
+  }
+  values->reserve(timestamps->size());
+  uint64_t value = 0;
+  for (size_t i = 0; i < timestamps->size(); ++i) {
+    uint64_t delta;
+    if (!ReadLeb128(&buf, &delta)) {
+      timestamps->clear();
+      values->clear();
+      return false;
+    }
+    value += ZigZagDecode(delta);
+    values->push_back(value);
+  }
+  // any left over?  treat as corrupt
+  if (!buf.empty()) {
+    timestamps->clear();
+    values->clear();
+    return false;
+  }
+  return true;
+}
+
+bool DataLogRecord::GetPackedDoubles(std::vector<int64_t>* timestamps,
+                                     std::vector<double>* values) const {
+  values->clear();
+  timestamps->clear();
+  auto buf = m_data;
+  if (!ReadPackedTimestamps(&buf, m_timestamp, timestamps)) {
+    return false;
+  }
+  auto fail = [&] {
+    timestamps->clear();
+    values->clear();
+    return false;
+  };
+  values->reserve(timestamps->size());
+  BitReader reader{buf};
+  uint64_t value;
+  if (!reader.Read(64, &value)) {
+    return fail();
+  }
+  values->push_back(std::bit_cast<double>(value));
+  unsigned int leading = 64;  // no window yet
+  unsigned int trailing = 0;
+  for (size_t i = 1; i < timestamps->size(); ++i) {
+    uint64_t control;
+    if (!reader.Read(1, &control)) {
+      return fail();
+    }
+    if (control != 0) {
+      if (!reader.Read(1, &control)) {
+        return fail();
+      }
+      if (control != 0) {
+        // new window
+        uint64_t lz, meaningful;
+        if (!reader.Read(5, &lz) || !reader.Read(6, &meaningful) ||
+            lz + meaningful + 1 > 64) {
+          return fail();
+        }
+        leading = lz;
+        trailing = 64 - lz - (meaningful + 1);
+      } else if (leading == 64) {
+        return fail();
+      }
+      uint64_t bits;
+      if (!reader.Read(64 - leading - trailing, &bits)) {
+        return fail();
+      }
+      value ^= bits << trailing;
+    }
+    values->push_back(std::bit_cast<double>(value));
+  }
+  // only padding to a whole byte may be left over
+  if (reader.GetRemaining() >= 8) {
+    return fail();
+  }
+  return true;
+}
+
 DataLogReader::DataLogReader(std::unique_ptr<wpi::util::MemoryBuffer> buffer)
     : m_buf{std::move(buffer)} {}
 
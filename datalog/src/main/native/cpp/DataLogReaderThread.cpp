@@ -4,14 +4,103 @@
 
 #include "wpi/datalog/DataLogReaderThread.hpp"
 
+#include <algorithm>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "wpi/util/StringExtras.hpp"
 #include "wpi/util/print.hpp"
 
 using namespace wpi::log;
 
+// Logs smaller than this are scanned on a single thread unless a thread count
+// is explicitly requested.
+static constexpr size_t kParallelMinSize = 16 * 1024 * 1024;
+
+// Number of consecutive records that must parse to accept a chunk start.
+static constexpr int kSyncRecords = 16;
+
+namespace {
+struct ChunkResult {
+  // offset of the first record in the chunk
+  size_t start = SIZE_MAX;
+  // offset of the first record past the end of the chunk, or SIZE_MAX if an
+  // invalid record was found
+  size_t stop = SIZE_MAX;
+  unsigned int numRecords = 0;
+  std::vector<size_t> control;
+  // offset of the last data record for each entry
+  wpi::util::DenseMap<int, size_t> lastData;
+};
+
+struct SchemaEntry {
+  DataLogReaderEntry* entry;
+  // offset of the entry's Start record
+  size_t start;
+  // contents of the last data record
+  std::span<const uint8_t> data;
+};
+}  // namespace
+
+static bool ReadRecordAt(const DataLogReader& reader, size_t pos,
+                         DataLogRecord* record, size_t* next) {
+  *record = *reader.At(pos);
+  if (record->GetEntry() < 0) {
+    return false;
+  }
+  *next = record->GetRaw().data() + record->GetSize() -
+          reader.GetBuffer().data();
+  return true;
+}
+
+// Records do not have sync markers, so chunk starts are found speculatively:
+// the first offset from which a chain of records parses cleanly.  The guess is
+// verified against where the previous chunk's scan ended.
+static size_t FindRecordStart(const DataLogReader& reader, size_t pos,
+                              size_t end) {
+  size_t size = reader.GetBuffer().size();
+  DataLogRecord record;
+  for (; pos < end; ++pos) {
+    size_t next = pos;
+    int count = 0;
+    while (count < kSyncRecords && next != size &&
+           ReadRecordAt(reader, next, &record, &next)) {
+      ++count;
+    }
+    if (count == kSyncRecords || (count > 0 && next == size)) {
+      return pos;
+    }
+  }
+  return end;
+}
+
+static void ScanChunk(const DataLogReader& reader, size_t pos, size_t end,
+                      const std::atomic_bool& active, ChunkResult* result) {
+  *result = ChunkResult();
+  result->start = pos;
+  size_t size = reader.GetBuffer().size();
+  DataLogRecord record;
+  while (pos < end && pos != size) {
+    if ((result->numRecords & 0xffff) == 0 && !active) {
+      return;
+    }
+    size_t next;
+    if (!ReadRecordAt(reader, pos, &record, &next)) {
+      return;  // stop is SIZE_MAX
+    }
+    ++result->numRecords;
+    if (record.IsControl()) {
+      result->control.emplace_back(pos);
+    } else {
+      result->lastData[record.GetEntry()] = pos;
+    }
+    pos = next;
+  }
+  result->stop = pos;
+}
+
 DataLogReaderThread::~DataLogReaderThread() {
   if (m_thread.joinable()) {
     m_active = false;
@@ -26,16 +115,19 @@ DataLogReaderThread::~DataLogReaderThread() {
 }
 
 void DataLogReaderThread::ReadMain() {
-  wpi::util::SmallDenseMap<
-      int, std::pair<DataLogReaderEntry*, std::span<const uint8_t>>, 8>
-      schemaEntries;
+  wpi::util::SmallDenseMap<int, SchemaEntry, 8> schemaEntries;
+
+  size_t size = m_reader.GetBuffer().size();
+  unsigned int numThreads = m_numThreads;
+  if (numThreads == 0) {
+    numThreads = size < kParallelMinSize
+                     ? 1
+                     : std::max(std::thread::hardware_concurrency(), 1u);
+  }
 
-  for (auto recordIt = m_reader.begin(), recordEnd = m_reader.end();
-       recordIt != recordEnd; ++recordIt) {
+  auto recordEnd = m_reader.end();
+  auto processRecord = [&](DataLogReader::iterator recordIt) {
     auto& record = *recordIt;
-    if (!m_active) {
-      break;
-    }
     ++m_numRecords;
     if (record.IsStart()) {
       DataLogReaderEntry data;
@@ -54,6 +146,7 @@ void DataLogReaderThread::ReadMain() {
           if (data.type == "structschema" ||
               data.type == "proto:FileDescriptorProto") {
             schemaEntries.try_emplace(data.entry, entryPtr,
+                                      recordIt.GetOffset(),
                                       std::span<const uint8_t>{});
           }
         }
@@ -93,15 +186,105 @@ void DataLogReaderThread::ReadMain() {
     } else {
       auto it = schemaEntries.find(record.GetEntry());
       if (it != schemaEntries.end()) {
-        it->second.second = record.GetRaw();
+        it->second.data = record.GetRaw();
+      }
+    }
+  };
+
+  if (m_index) {
+    // only control records are needed to build the entry table
+    for (size_t pos : m_index->GetControlRecords()) {
+      if (!m_active) {
+        break;
+      }
+      processRecord(m_reader.At(pos));
+    }
+    for (auto&& [entry, schema] : schemaEntries) {
+      // only records written under this Start; the ID may have been reused
+      auto records = m_index->GetRecords(entry, schema.start);
+      if (!records.empty()) {
+        // use the last record in the log, as a full scan would
+        auto last = std::max_element(records.begin(), records.end(),
+                                     [](const auto& a, const auto& b) {
+                                       return a.offset < b.offset;
+                                     });
+        schema.data = m_reader.At(last->offset)->GetRaw();
+      }
+    }
+    m_numRecords = m_index->GetNumRecords();
+  } else if (numThreads > 1) {
+    auto begin = m_reader.begin();
+    size_t recordsStart = begin == recordEnd ? size : begin.GetOffset();
+    size_t chunkSize = (size - recordsStart) / numThreads + 1;
+
+    // scan chunks concurrently
+    std::vector<ChunkResult> chunks(numThreads);
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i) {
+      workers.emplace_back([&, i] {
+        size_t start = std::min(recordsStart + i * chunkSize, size);
+        size_t end = std::min(start + chunkSize, size);
+        if (i != 0) {
+          start = FindRecordStart(m_reader, start, end);
+        }
+        ScanChunk(m_reader, start, end, m_active, &chunks[i]);
+      });
+    }
+    for (auto&& worker : workers) {
+      worker.join();
+    }
+
+    // rescan any chunk whose start guess doesn't match where the previous
+    // chunk ended
+    for (unsigned int i = 1; i < numThreads && m_active; ++i) {
+      size_t start = chunks[i - 1].stop;
+      if (chunks[i].start == start) {
+        continue;
+      }
+      if (start == SIZE_MAX) {
+        // previous chunk ended at an invalid record; nothing more to read
+        chunks[i] = ChunkResult();
+      } else {
+        size_t end = std::min(recordsStart + (i + 1) * chunkSize, size);
+        ScanChunk(m_reader, start, end, m_active, &chunks[i]);
+      }
+    }
+
+    // control records must be processed in log order
+    unsigned int numRecords = 0;
+    for (auto&& chunk : chunks) {
+      for (size_t pos : chunk.control) {
+        if (!m_active) {
+          break;
+        }
+        processRecord(m_reader.At(pos));
+      }
+      numRecords += chunk.numRecords;
+    }
+    for (auto&& [entry, schema] : schemaEntries) {
+      for (auto chunk = chunks.rbegin(); chunk != chunks.rend(); ++chunk) {
+        auto it = chunk->lastData.find(entry);
+        if (it != chunk->lastData.end()) {
+          schema.data = m_reader.At(it->second)->GetRaw();
+          break;
+        }
+      }
+    }
+    m_numRecords = numRecords;
+  } else {
+    for (auto recordIt = m_reader.begin(); recordIt != recordEnd; ++recordIt) {
+      if (!m_active) {
+        break;
       }
+      processRecord(recordIt);
     }
   }
 
   // build schema databases
   for (auto&& schemaPair : schemaEntries) {
-    auto name = schemaPair.second.first->name;
-    auto data = schemaPair.second.second;
+    auto name = schemaPair.second.entry->name;
+    auto data = schemaPair.second.data;
     if (data.empty()) {
       continue;
     }
@@ -0,0 +1,366 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "UringFile.hpp"
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+using namespace wpi::log::detail;
+
+#ifdef __linux__
+
+// user data of the no-op used to stop the completion thread
+static constexpr uint64_t kStopUserData = UINT64_MAX;
+
+// number of times a submission failing for lack of kernel resources is retried
+static constexpr int kMaxSubmitRetries = 10;
+
+static int Enter(int ringFd, unsigned int toSubmit, unsigned int minComplete,
+                 const __kernel_timespec* timeout = nullptr) {
+  unsigned int flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+  io_uring_getevents_arg arg;
+  const void* argp = nullptr;
+  size_t argsz = 0;
+  if (timeout) {
+    std::memset(&arg, 0, sizeof(arg));
+    arg.ts = reinterpret_cast<uintptr_t>(timeout);
+    flags |= IORING_ENTER_EXT_ARG;
+    argp = &arg;
+    argsz = sizeof(arg);
+  }
+  for (;;) {
+    int ret = syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags,
+                      argp, argsz);
+    if (ret >= 0 || errno != EINTR) {
+      return ret;
+    }
+  }
+}
+
+std::unique_ptr<UringFile> UringFile::Create(int fd, unsigned int entries,
+                                             CompleteFunc complete,
+                                             std::error_code& ec) {
+  std::unique_ptr<UringFile> ring{new UringFile};
+  ring->m_fd = fd;
+  ring->m_complete = std::move(complete);
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  // one extra entry for the no-op that stops the completion thread
+  entries = std::max(entries, 1u);
+  int ringFd = syscall(__NR_io_uring_setup, entries + 1, &params);
+  if (ringFd < 0) {
+    ec = std::error_code{errno, std::generic_category()};
+    return nullptr;
+  }
+  ring->m_ringFd = ringFd;
+  // lets the completion thread periodically check for a stop request
+  ring->m_waitTimeout = (params.features & IORING_FEAT_EXT_ARG) != 0;
+
+  ring->m_sqRingSize =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->m_cqRingSize =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (singleMmap) {
+    ring->m_sqRingSize = std::max(ring->m_sqRingSize, ring->m_cqRingSize);
+  }
+
+  void* sqRing = mmap(nullptr, ring->m_sqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+  if (sqRing == MAP_FAILED) {
+    ec = std::error_code{errno, std::generic_category()};
+    return nullptr;
+  }
+  ring->m_sqRing = sqRing;
+
+  void* cqRing = sqRing;
+  if (!singleMmap) {
+    cqRing = mmap(nullptr, ring->m_cqRingSize, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    if (cqRing == MAP_FAILED) {
+      ec = std::error_code{errno, std::generic_category()};
+      return nullptr;
+    }
+    ring->m_cqRing = cqRing;
+  }
+
+  ring->m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr, ring->m_sqesSize, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    ec = std::error_code{errno, std::generic_category()};
+    return nullptr;
+  }
+  ring->m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+  auto sq = static_cast<uint8_t*>(sqRing);
+  ring->m_sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+  ring->m_sqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+  ring->m_sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+  auto cq = static_cast<uint8_t*>(cqRing);
+  ring->m_cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+  ring->m_cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+  ring->m_cqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+  ring->m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  // The completion queue is at least as large as the submission queue, so
+  // limiting operations in flight to less than the submission queue size
+  // means neither queue can overflow.
+  ring->m_size = entries;
+
+  ring->m_thread = std::thread{[r = ring.get()] { r->CompletionThreadMain(); }};
+  return ring;
+}
+
+UringFile::~UringFile() {
+  if (m_thread.joinable()) {
+    Drain();
+    m_stop = true;
+    io_uring_sqe* sqe = GetSqe();
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = kStopUserData;
+    CommitSqe();
+    Submit();
+    m_thread.join();
+
+    // if the completion thread stopped due to an error, some operations may
+    // never have completed
+    std::vector<uint64_t> pending;
+    {
+      std::scoped_lock lock{m_mutex};
+      pending.swap(m_pending);
+    }
+    for (auto userData : pending) {
+      m_complete(userData, -ECANCELED);
+    }
+  }
+  if (m_sqes) {
+    munmap(m_sqes, m_sqesSize);
+  }
+  if (m_cqRing) {
+    munmap(m_cqRing, m_cqRingSize);
+  }
+  if (m_sqRing) {
+    munmap(m_sqRing, m_sqRingSize);
+  }
+  if (m_ringFd >= 0) {
+    ::close(m_ringFd);
+  }
+}
+
+io_uring_sqe* UringFile::GetSqe() {
+  // only the submitting thread writes the tail
+  uint32_t index = *m_sqTail & m_sqMask;
+  io_uring_sqe* sqe = &m_sqes[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  m_sqArray[index] = index;
+  return sqe;
+}
+
+void UringFile::CommitSqe() {
+  std::atomic_ref<uint32_t>{*m_sqTail}.store(*m_sqTail + 1,
+                                              std::memory_order_release);
+  ++m_toSubmit;
+}
+
+bool UringFile::WaitForSpace(uint64_t userData) {
+  std::unique_lock lock{m_mutex};
+  if (m_inFlight >= m_size && !m_failed) {
+    // make room by submitting what's queued
+    lock.unlock();
+    Submit();
+    lock.lock();
+    m_cond.wait(lock, [&] { return m_inFlight < m_size || m_failed; });
+  }
+  if (m_failed) {
+    return false;
+  }
+  ++m_inFlight;
+  m_pending.push_back(userData);
+  return true;
+}
+
+void UringFile::QueueWrite(std::span<const uint8_t> data, uint64_t offset,
+                           uint64_t userData) {
+  if (!WaitForSpace(userData)) {
+    m_complete(userData, -ECANCELED);
+    return;
+  }
+  io_uring_sqe* sqe = GetSqe();
+  sqe->opcode = IORING_OP_WRITE;
+  sqe->fd = m_fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(data.data());
+  sqe->len = data.size();
+  sqe->off = offset;
+  sqe->user_data = userData;
+  CommitSqe();
+}
+
+void UringFile::QueueSync(uint64_t userData) {
+  if (!WaitForSpace(userData)) {
+    m_complete(userData, -ECANCELED);
+    return;
+  }
+  io_uring_sqe* sqe = GetSqe();
+  sqe->opcode = IORING_OP_FSYNC;
+  sqe->flags = IOSQE_IO_DRAIN;
+  sqe->fd = m_fd;
+  sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+  sqe->user_data = userData;
+  CommitSqe();
+}
+
+bool UringFile::Submit() {
+  int retries = 0;
+  while (m_toSubmit > 0) {
+    int ret = Enter(m_ringFd, m_toSubmit, 0);
+    if (ret < 0 && (errno == EAGAIN || errno == EBUSY) &&
+        ++retries <= kMaxSubmitRetries) {
+      // out of kernel resources; back off while some operations complete
+      std::this_thread::sleep_for(std::chrono::microseconds{100 * retries});
+      continue;
+    }
+    if (ret <= 0) {
+      int err = ret < 0 ? errno : EIO;
+      CancelUnsubmitted(err);
+      errno = err;
+      return false;
+    }
+    m_toSubmit -= ret;
+  }
+  return true;
+}
+
+void UringFile::CancelUnsubmitted(int err) {
+  // the kernel only consumes entries in io_uring_enter(), so the ones it
+  // didn't accept can be taken back off the submission queue
+  uint32_t tail = *m_sqTail;
+  uint32_t first = tail - m_toSubmit;
+  std::vector<uint64_t> userData;
+  for (uint32_t i = first; i != tail; ++i) {
+    uint64_t data = m_sqes[i & m_sqMask].user_data;
+    if (data != kStopUserData) {
+      userData.push_back(data);
+    }
+  }
+  std::atomic_ref<uint32_t>{*m_sqTail}.store(first, std::memory_order_release);
+  m_toSubmit = 0;
+
+  for (auto data : userData) {
+    m_complete(data, -err);
+  }
+  Completed(userData);
+}
+
+void UringFile::Completed(std::span<const uint64_t> userData) {
+  if (userData.empty()) {
+    return;
+  }
+  std::scoped_lock lock{m_mutex};
+  m_inFlight -= userData.size();
+  for (auto data : userData) {
+    auto it = std::find(m_pending.begin(), m_pending.end(), data);
+    if (it != m_pending.end()) {
+      m_pending.erase(it);
+    }
+  }
+  m_cond.notify_all();
+}
+
+void UringFile::Drain() {
+  Submit();
+  std::unique_lock lock{m_mutex};
+  m_cond.wait(lock, [&] { return m_inFlight == 0 || m_failed; });
+}
+
+void UringFile::CompletionThreadMain() {
+  __kernel_timespec timeout{.tv_sec = 0, .tv_nsec = 100000000};
+  std::vector<uint64_t> completed;
+  for (;;) {
+    int ret = Enter(m_ringFd, 0, 1, m_waitTimeout ? &timeout : nullptr);
+    bool error = ret < 0 && errno != ETIME;
+    // only this thread writes the head
+    uint32_t head = *m_cqHead;
+    uint32_t tail =
+        std::atomic_ref<uint32_t>{*m_cqTail}.load(std::memory_order_acquire);
+    bool stop = false;
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+      if (cqe.user_data == kStopUserData) {
+        stop = true;
+      } else {
+        m_complete(cqe.user_data, cqe.res);
+        completed.push_back(cqe.user_data);
+      }
+    }
+    std::atomic_ref<uint32_t>{*m_cqHead}.store(head, std::memory_order_release);
+    Completed(completed);
+    completed.clear();
+    if (stop || m_stop) {
+      return;
+    }
+    if (error) {
+      // can't wait for completions; let waiters fall through
+      std::scoped_lock lock{m_mutex};
+      m_failed = true;
+      m_cond.notify_all();
+      return;
+    }
+  }
+}
+
+#else
+
+std::unique_ptr<UringFile> UringFile::Create(int, unsigned int, CompleteFunc,
+                                             std::error_code& ec) {
+  ec = std::make_error_code(std::errc::not_supported);
+  return nullptr;
+}
+
+UringFile::~UringFile() = default;
+
+io_uring_sqe* UringFile::GetSqe() {
+  return nullptr;
+}
+
+void UringFile::CommitSqe() {}
+
+bool UringFile::WaitForSpace(uint64_t) {
+  return false;
+}
+
+void UringFile::CancelUnsubmitted(int) {}
+
+void UringFile::Completed(std::span<const uint64_t>) {}
+
+void UringFile::QueueWrite(std::span<const uint8_t>, uint64_t, uint64_t) {}
+
+void UringFile::QueueSync(uint64_t) {}
+
+bool UringFile::Submit() {
+  return false;
+}
+
+void UringFile::Drain() {}
+
+void UringFile::CompletionThreadMain() {}
+
+#endif
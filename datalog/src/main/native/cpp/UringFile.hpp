@@ -0,0 +1,151 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "wpi/util/condition_variable.hpp"
+#include "wpi/util/mutex.hpp"
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace wpi::log::detail {
+
+/**
+ * Minimal io_uring queue for asynchronous writes to a single file.  Uses the
+ * raw system calls so no additional libraries are required.  Only available
+ * on Linux; Create() fails with std::errc::not_supported elsewhere.
+ *
+ * Operations are queued and submitted by a single thread.  Completions are
+ * processed by a thread owned by this object, which calls the completion
+ * function for each operation.
+ */
+class UringFile {
+ public:
+  /**
+   * Function called exactly once for each queued operation, with the user
+   * data and result (bytes written, or negative errno) of the operation.
+   * Called from the completion thread, or from the submitting thread for
+   * operations that could not be submitted.
+   */
+  using CompleteFunc = std::function<void(uint64_t userData, int result)>;
+
+  /**
+   * Creates a queue for a file descriptor.
+   *
+   * @param fd file descriptor; must outlive this object
+   * @param entries maximum number of operations in flight
+   * @param complete completion function
+   * @param ec error code (set on failure)
+   * @return queue, or nullptr on failure
+   */
+  static std::unique_ptr<UringFile> Create(int fd, unsigned int entries,
+                                           CompleteFunc complete,
+                                           std::error_code& ec);
+
+  /**
+   * Waits for all operations to complete and stops the completion thread.
+   */
+  ~UringFile();
+
+  UringFile(const UringFile&) = delete;
+  UringFile& operator=(const UringFile&) = delete;
+
+  /**
+   * Queues a write.  The data must remain valid until the write completes.
+   * Blocks while the maximum number of operations are in flight.  If the
+   * queue has failed, the write is immediately completed with an error.
+   *
+   * @param data data to write
+   * @param offset file offset
+   * @param userData value passed to the completion function
+   */
+  void QueueWrite(std::span<const uint8_t> data, uint64_t offset,
+                  uint64_t userData);
+
+  /**
+   * Queues an fdatasync that starts after all previously queued operations
+   * have completed.  Blocks while the maximum number of operations are in
+   * flight.
+   *
+   * @param userData value passed to the completion function
+   */
+  void QueueSync(uint64_t userData);
+
+  /**
+   * Submits queued operations to the kernel.  On error, operations that were
+   * not submitted are completed with the error, and errno is set.
+   *
+   * @return False on error
+   */
+  bool Submit();
+
+  /**
+   * Waits for all submitted operations to complete.  Returns early if the
+   * completion thread stopped due to an error; operations still in flight
+   * are then completed with ECANCELED by the destructor.
+   */
+  void Drain();
+
+  /**
+   * Gets the maximum number of operations in flight.
+   *
+   * @return Queue size
+   */
+  unsigned int GetSize() const { return m_size; }
+
+ private:
+  UringFile() = default;
+
+  bool WaitForSpace(uint64_t userData);
+  io_uring_sqe* GetSqe();
+  void CommitSqe();
+  void CancelUnsubmitted(int err);
+  void Completed(std::span<const uint64_t> userData);
+  void CompletionThreadMain();
+
+  int m_ringFd = -1;
+  int m_fd = -1;
+  unsigned int m_size = 0;
+  unsigned int m_toSubmit = 0;
+  CompleteFunc m_complete;
+
+  wpi::util::mutex m_mutex;
+  wpi::util::condition_variable m_cond;
+  unsigned int m_inFlight = 0;
+  // user data of operations in flight
+  std::vector<uint64_t> m_pending;
+  // set when the completion thread stops due to an error
+  bool m_failed = false;
+  std::atomic_bool m_stop = false;
+  bool m_waitTimeout = false;
+  std::thread m_thread;
+
+  void* m_sqRing = nullptr;
+  size_t m_sqRingSize = 0;
+  void* m_cqRing = nullptr;
+  size_t m_cqRingSize = 0;
+  io_uring_sqe* m_sqes = nullptr;
+  size_t m_sqesSize = 0;
+
+  uint32_t* m_sqTail = nullptr;
+  uint32_t m_sqMask = 0;
+  uint32_t* m_sqArray = nullptr;
+  uint32_t* m_cqHead = nullptr;
+  uint32_t* m_cqTail = nullptr;
+  uint32_t m_cqMask = 0;
+  io_uring_cqe* m_cqes = nullptr;
+};
+
+}  // namespace wpi::log::detail
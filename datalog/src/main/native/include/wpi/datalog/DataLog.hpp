@@ -7,8 +7,10 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <concepts>
 #include <initializer_list>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
@@ -34,6 +36,8 @@ class Logger;
 
 namespace wpi::log {
 
+class DataLogBatch;
+
 namespace impl {
 
 enum ControlRecordType {
@@ -65,10 +69,24 @@ enum ControlRecordType {
  * For this reason (as well as the fact that timestamps can be set to
  * arbitrary values), records in the log are not guaranteed to be sorted by
  * timestamp.
+ *
+ * Optionally, per-thread buffering can be enabled with
+ * SetThreadLocalBuffering().  In this mode, data records are appended to a
+ * buffer chain private to the calling thread, so appends from different threads
+ * never contend on a shared mutex.  The per-thread chains are merged into the
+ * log in timestamp order when the log is flushed.
+ *
+ * Integer and double entries that change slowly and are sampled at a steady
+ * rate can instead use the "packed:int64" and "packed:double" types (see
+ * AppendPackedInteger() and AppendPackedDouble()).  Samples for these entries
+ * are buffered and written as a single record holding many samples, using
+ * delta-of-delta timestamps and delta (integer) or XOR (double) compressed
+ * values.  The buffered samples are written when the log is flushed, when the
+ * entry is finished, or when the record reaches a fixed number of samples.
  */
 class DataLog {
  public:
-  virtual ~DataLog() = default;
+  virtual ~DataLog();
 
   DataLog(const DataLog&) = delete;
   DataLog& operator=(const DataLog&) = delete;
@@ -97,6 +115,28 @@ class DataLog {
    */
   virtual void Stop();
 
+  /**
+   * Enables or disables per-thread append buffers.  When enabled, data records
+   * are written to a buffer chain owned by the appending thread rather than to
+   * the shared buffer chain, so Append calls never wait on other threads.  The
+   * per-thread chains are merged in timestamp order when the log is flushed.
+   * Start, finish, and metadata records are always written to the shared
+   * chain; pending per-thread data is merged first so that record order
+   * relative to these is preserved.
+   *
+   * @param enable true to enable per-thread buffers, false to disable
+   */
+  void SetThreadLocalBuffering(bool enable);
+
+  /**
+   * Returns whether per-thread append buffers are enabled.
+   *
+   * @return True if per-thread buffers are enabled
+   */
+  bool IsThreadLocalBuffering() const {
+    return m_threadLocal.load(std::memory_order_relaxed);
+  }
+
   /**
    * Returns whether there is a data schema already registered with the given
    * name.
@@ -280,6 +320,36 @@ class DataLog {
    */
   void AppendDouble(int entry, double value, int64_t timestamp);
 
+  /**
+   * Appends an integer sample to a packed integer entry ("packed:int64").
+   * The sample is buffered and written as part of a packed record.
+   *
+   * @param entry Entry index, as returned by Start()
+   * @param value Integer value to record
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void AppendPackedInteger(int entry, int64_t value, int64_t timestamp);
+
+  /**
+   * Appends a double sample to a packed double entry ("packed:double").
+   * The sample is buffered and written as part of a packed record.
+   *
+   * @param entry Entry index, as returned by Start()
+   * @param value Double value to record
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void AppendPackedDouble(int entry, double value, int64_t timestamp);
+
+  /**
+   * Appends all of the records in a batch to the log with a shared timestamp.
+   * This takes the lock and reserves buffer space once for the whole batch,
+   * rather than once per record.  The batch is not modified.
+   *
+   * @param batch Records to append
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void AppendBatch(const DataLogBatch& batch, int64_t timestamp = 0);
+
   /**
    * Appends a string record to the log.
    *
@@ -441,8 +511,8 @@ class DataLog {
    * @param msglog message logger (will be called from separate thread)
    * @param extraHeader extra header metadata
    */
-  explicit DataLog(wpi::util::Logger& msglog, std::string_view extraHeader = "")
-      : m_msglog{msglog}, m_extraHeader{extraHeader} {}
+  explicit DataLog(wpi::util::Logger& msglog,
+                   std::string_view extraHeader = "");
 
   /**
    * Starts the log.  Appends file header and Start records and schema data
@@ -473,14 +543,15 @@ class DataLog {
 
   /**
    * Called when internal buffers are half the maximum count.  Called with
-   * internal mutex held; do not call any other DataLog functions from this
-   * function.
+   * internal mutex (or a per-thread buffer lock) held; do not call any other
+   * DataLog functions from this function.
    */
   virtual void BufferHalfFull();
 
   /**
    * Called when internal buffers reach the maximum count.  Called with internal
-   * mutex held; do not call any other DataLog functions from this function.
+   * mutex (or a per-thread buffer lock) held; do not call any other DataLog
+   * functions from this function.
    *
    * @return true if log should be paused (don't call PauseLog)
    */
@@ -490,17 +561,40 @@ class DataLog {
   static constexpr size_t kMaxBufferCount = 1024 * 1024 / kBlockSize;
   static constexpr size_t kMaxFreeCount = 256 * 1024 / kBlockSize;
 
+  struct ThreadBuffer;
+  class AppendScope;
+  struct PackedEntry;
+
+  // returns calling thread's buffer; must be called without m_mutex held
+  ThreadBuffer* GetThreadBuffer();
+
   // must be called with m_mutex held
   int StartImpl(std::string_view name, std::string_view type,
                 std::string_view metadata, int64_t timestamp);
+  void MergeThreadBufs();
+  void PruneThreadBufs();
+
+  // must be called with m_mutex held (tb == nullptr) or tb->mutex held
   uint8_t* StartRecord(uint32_t entry, uint64_t timestamp, uint32_t payloadSize,
-                       size_t reserveSize);
-  uint8_t* Reserve(size_t size);
-  void AppendImpl(std::span<const uint8_t> data);
-  void AppendStringImpl(std::string_view str);
+                       size_t reserveSize, ThreadBuffer* tb = nullptr);
+  uint8_t* Reserve(size_t size, ThreadBuffer* tb = nullptr);
+  void CountNewBuf();
+  void EndReserve(uint8_t* start, size_t unused, uint64_t timestamp,
+                  size_t size, ThreadBuffer* tb);
+  void AppendImpl(std::span<const uint8_t> data, ThreadBuffer* tb = nullptr);
+  void AppendStringImpl(std::string_view str, ThreadBuffer* tb = nullptr);
+
+  // must be called with m_mutex held
   void AppendStartRecord(int id, std::string_view name, std::string_view type,
                          std::string_view metadata, int64_t timestamp);
+  void AppendPacked(int entry, uint64_t value, bool isDouble,
+                    int64_t timestamp);
+  void FlushPacked(int entry, PackedEntry& packed);
+  void FlushAllPacked();
+
+  // may be called with any lock held
   void DoReleaseBufs(std::vector<Buffer>* bufs);
+  Buffer GetFreeBuf();
 
  protected:
   wpi::util::Logger& m_msglog;
@@ -508,11 +602,18 @@ class DataLog {
  private:
   mutable wpi::util::mutex m_mutex;
   bool m_active = false;
-  bool m_paused = false;
+  std::atomic_bool m_paused = false;
   bool m_manuallyPaused = false;
+  std::atomic_bool m_threadLocal = false;
+  uint64_t m_instance;
   std::string m_extraHeader;
+  // buffers in use by the shared and per-thread chains
+  std::atomic<size_t> m_bufferCount = 0;
+  // leaf lock; the free list is shared by all chains
+  wpi::util::mutex m_freeMutex;
   std::vector<Buffer> m_free;
   std::vector<Buffer> m_outgoing;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_threadBufs;
   struct EntryInfo {
     std::string type;
     int id{0};
@@ -528,9 +629,182 @@ class DataLog {
     unsigned int count;
   };
   wpi::util::DenseMap<int, EntryInfo2> m_entryIds;
+  wpi::util::DenseMap<int, std::unique_ptr<PackedEntry>> m_packed;
   int m_lastId = 0;
 };
 
+/**
+ * A set of records to be appended to a data log together with a shared
+ * timestamp (see DataLog::AppendBatch()).  This is useful when many values
+ * are logged at the same time, e.g. all the signals of a mechanism in a
+ * periodic loop, as the log lock is taken once for the whole batch.
+ *
+ * Record data is copied into the batch when added.  Batches can be reused
+ * after Clear() without reallocating.  A batch is not thread safe.
+ */
+class DataLogBatch {
+ public:
+  /**
+   * Returns true if the batch has no records.
+   *
+   * @return True if empty
+   */
+  bool IsEmpty() const { return m_records.empty(); }
+
+  /**
+   * Gets the number of records in the batch.
+   *
+   * @return Number of records
+   */
+  size_t GetNumRecords() const { return m_records.size(); }
+
+  /**
+   * Removes all records from the batch.
+   */
+  void Clear() {
+    m_records.clear();
+    m_data.clear();
+  }
+
+  /**
+   * Appends all of the records in the batch to a log and clears the batch.
+   *
+   * @param log Data log
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void Commit(DataLog& log, int64_t timestamp = 0) {
+    log.AppendBatch(*this, timestamp);
+    Clear();
+  }
+
+  /**
+   * Adds a raw record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param data Byte array to record
+   */
+  void AppendRaw(int entry, std::span<const uint8_t> data);
+
+  /**
+   * Adds a boolean record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param value Boolean value to record
+   */
+  void AppendBoolean(int entry, bool value);
+
+  /**
+   * Adds an integer record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param value Integer value to record
+   */
+  void AppendInteger(int entry, int64_t value);
+
+  /**
+   * Adds a float record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param value Float value to record
+   */
+  void AppendFloat(int entry, float value);
+
+  /**
+   * Adds a double record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param value Double value to record
+   */
+  void AppendDouble(int entry, double value);
+
+  /**
+   * Adds a string record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param value String value to record
+   */
+  void AppendString(int entry, std::string_view value);
+
+  /**
+   * Adds a boolean array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr Boolean array to record
+   */
+  void AppendBooleanArray(int entry, std::span<const bool> arr);
+
+  /**
+   * Adds a boolean array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr Boolean array to record
+   */
+  void AppendBooleanArray(int entry, std::span<const int> arr);
+
+  /**
+   * Adds a boolean array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr Boolean array to record
+   */
+  void AppendBooleanArray(int entry, std::span<const uint8_t> arr);
+
+  /**
+   * Adds an integer array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr Integer array to record
+   */
+  void AppendIntegerArray(int entry, std::span<const int64_t> arr);
+
+  /**
+   * Adds a float array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr Float array to record
+   */
+  void AppendFloatArray(int entry, std::span<const float> arr);
+
+  /**
+   * Adds a double array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr Double array to record
+   */
+  void AppendDoubleArray(int entry, std::span<const double> arr);
+
+  /**
+   * Adds a string array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr String array to record
+   */
+  void AppendStringArray(int entry, std::span<const std::string> arr);
+
+  /**
+   * Adds a string array record to the batch.
+   *
+   * @param entry Entry index, as returned by DataLog::Start()
+   * @param arr String array to record
+   */
+  void AppendStringArray(int entry, std::span<const std::string_view> arr);
+
+ private:
+  friend class DataLog;
+
+  // returns space for the record payload; nullptr if entry is invalid
+  uint8_t* AddRecord(int entry, size_t size);
+  template <typename T>
+  void AppendStringArrayImpl(int entry, std::span<const T> arr);
+
+  struct Record {
+    int entry;
+    uint32_t size;
+  };
+  std::vector<Record> m_records;
+  std::vector<uint8_t> m_data;
+};
+
 /**
  * Log entry base class.
  */
@@ -664,6 +938,17 @@ class RawLogEntry : public DataLogValueEntryImpl<std::vector<uint8_t>> {
     m_log->AppendRaw(m_entry, data, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param data Data to record
+   */
+  void Append(DataLogBatch& batch, std::span<const uint8_t> data) {
+    batch.AppendRaw(m_entry, data);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -701,6 +986,17 @@ class BooleanLogEntry : public DataLogValueEntryImpl<bool> {
     m_log->AppendBoolean(m_entry, value, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param value Value to record
+   */
+  void Append(DataLogBatch& batch, bool value) {
+    batch.AppendBoolean(m_entry, value);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -744,6 +1040,17 @@ class IntegerLogEntry : public DataLogValueEntryImpl<int64_t> {
     m_log->AppendInteger(m_entry, value, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param value Value to record
+   */
+  void Append(DataLogBatch& batch, int64_t value) {
+    batch.AppendInteger(m_entry, value);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -787,6 +1094,17 @@ class FloatLogEntry : public DataLogValueEntryImpl<float> {
     m_log->AppendFloat(m_entry, value, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param value Value to record
+   */
+  void Append(DataLogBatch& batch, float value) {
+    batch.AppendFloat(m_entry, value);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -830,6 +1148,17 @@ class DoubleLogEntry : public DataLogValueEntryImpl<double> {
     m_log->AppendDouble(m_entry, value, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param value Value to record
+   */
+  void Append(DataLogBatch& batch, double value) {
+    batch.AppendDouble(m_entry, value);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -849,6 +1178,96 @@ class DoubleLogEntry : public DataLogValueEntryImpl<double> {
   }
 };
 
+/**
+ * Log integer values using the packed encoding. Suited to slowly changing
+ * values sampled at a steady rate; see DataLog for details.
+ */
+class PackedIntegerLogEntry : public DataLogValueEntryImpl<int64_t> {
+ public:
+  static constexpr std::string_view kDataType = "packed:int64";
+
+  PackedIntegerLogEntry() = default;
+  PackedIntegerLogEntry(DataLog& log, std::string_view name,
+                        int64_t timestamp = 0)
+      : PackedIntegerLogEntry{log, name, {}, timestamp} {}
+  PackedIntegerLogEntry(DataLog& log, std::string_view name,
+                        std::string_view metadata, int64_t timestamp = 0)
+      : DataLogValueEntryImpl{log, name, kDataType, metadata, timestamp} {}
+
+  /**
+   * Appends a sample to the log.
+   *
+   * @param value Value to record
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void Append(int64_t value, int64_t timestamp = 0) {
+    m_log->AppendPackedInteger(m_entry, value, timestamp);
+  }
+
+  /**
+   * Updates the last value and appends a sample to the log if it has changed.
+   *
+   * @note The last value is local to this class instance; using Update() with
+   * two instances pointing to the same underlying log entry name will likely
+   * result in unexpected results.
+   *
+   * @param value Value to record
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void Update(int64_t value, int64_t timestamp = 0) {
+    std::scoped_lock lock{m_mutex};
+    if (m_lastValue != value) {
+      m_lastValue = value;
+      Append(value, timestamp);
+    }
+  }
+};
+
+/**
+ * Log double values using the packed encoding. Suited to slowly changing
+ * values sampled at a steady rate; see DataLog for details.
+ */
+class PackedDoubleLogEntry : public DataLogValueEntryImpl<double> {
+ public:
+  static constexpr std::string_view kDataType = "packed:double";
+
+  PackedDoubleLogEntry() = default;
+  PackedDoubleLogEntry(DataLog& log, std::string_view name,
+                       int64_t timestamp = 0)
+      : PackedDoubleLogEntry{log, name, {}, timestamp} {}
+  PackedDoubleLogEntry(DataLog& log, std::string_view name,
+                       std::string_view metadata, int64_t timestamp = 0)
+      : DataLogValueEntryImpl{log, name, kDataType, metadata, timestamp} {}
+
+  /**
+   * Appends a sample to the log.
+   *
+   * @param value Value to record
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void Append(double value, int64_t timestamp = 0) {
+    m_log->AppendPackedDouble(m_entry, value, timestamp);
+  }
+
+  /**
+   * Updates the last value and appends a sample to the log if it has changed.
+   *
+   * @note The last value is local to this class instance; using Update() with
+   * two instances pointing to the same underlying log entry name will likely
+   * result in unexpected results.
+   *
+   * @param value Value to record
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void Update(double value, int64_t timestamp = 0) {
+    std::scoped_lock lock{m_mutex};
+    if (m_lastValue != value) {
+      m_lastValue = value;
+      Append(value, timestamp);
+    }
+  }
+};
+
 /**
  * Log string values.
  */
@@ -876,6 +1295,17 @@ class StringLogEntry : public DataLogValueEntryImpl<std::string> {
     m_log->AppendString(m_entry, value, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param value Value to record
+   */
+  void Append(DataLogBatch& batch, std::string_view value) {
+    batch.AppendString(m_entry, value);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -921,6 +1351,17 @@ class BooleanArrayLogEntry : public DataLogValueEntryImpl<std::vector<int>> {
     m_log->AppendBooleanArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const bool> arr) {
+    batch.AppendBooleanArray(m_entry, arr);
+  }
+
   /**
    * Appends a record to the log.
    *
@@ -941,6 +1382,17 @@ class BooleanArrayLogEntry : public DataLogValueEntryImpl<std::vector<int>> {
     m_log->AppendBooleanArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const int> arr) {
+    batch.AppendBooleanArray(m_entry, arr);
+  }
+
   /**
    * Appends a record to the log.
    *
@@ -961,6 +1413,17 @@ class BooleanArrayLogEntry : public DataLogValueEntryImpl<std::vector<int>> {
     m_log->AppendBooleanArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const uint8_t> arr) {
+    batch.AppendBooleanArray(m_entry, arr);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -1052,6 +1515,17 @@ class IntegerArrayLogEntry
     m_log->AppendIntegerArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const int64_t> arr) {
+    batch.AppendIntegerArray(m_entry, arr);
+  }
+
   /**
    * Appends a record to the log.
    *
@@ -1113,6 +1587,17 @@ class FloatArrayLogEntry : public DataLogValueEntryImpl<std::vector<float>> {
     m_log->AppendFloatArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const float> arr) {
+    batch.AppendFloatArray(m_entry, arr);
+  }
+
   /**
    * Appends a record to the log.
    *
@@ -1175,6 +1660,17 @@ class DoubleArrayLogEntry : public DataLogValueEntryImpl<std::vector<double>> {
     m_log->AppendDoubleArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const double> arr) {
+    batch.AppendDoubleArray(m_entry, arr);
+  }
+
   /**
    * Appends a record to the log.
    *
@@ -1238,6 +1734,17 @@ class StringArrayLogEntry
     m_log->AppendStringArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const std::string> arr) {
+    batch.AppendStringArray(m_entry, arr);
+  }
+
   /**
    * Appends a record to the log.
    *
@@ -1248,6 +1755,17 @@ class StringArrayLogEntry
     m_log->AppendStringArray(m_entry, arr, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param arr Values to record
+   */
+  void Append(DataLogBatch& batch, std::span<const std::string_view> arr) {
+    batch.AppendStringArray(m_entry, arr);
+  }
+
   /**
    * Appends a record to the log.
    *
@@ -1362,6 +1880,20 @@ class StructLogEntry : public DataLogEntry {
     m_log->AppendRaw(m_entry, buf, timestamp);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param data Data to record
+   */
+  void Append(DataLogBatch& batch, const T& data) {
+    wpi::util::SmallVector<uint8_t, 128> buf;
+    buf.resize_for_overwrite(std::apply(S::GetSize, m_info));
+    std::apply([&](const I&... info) { S::Pack(buf, data, info...); }, m_info);
+    batch.AppendRaw(m_entry, buf);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -1519,6 +2051,23 @@ class StructArrayLogEntry : public DataLogEntry {
         m_info);
   }
 
+  /**
+   * Adds a record to a batch, to be appended to the log when the batch is
+   * committed.
+   *
+   * @param batch Batch
+   * @param data Data to record
+   */
+  void Append(DataLogBatch& batch, std::span<const T> data) {
+    std::apply(
+        [&](const I&... info) {
+          m_buf.Write(
+              data, [&](auto bytes) { batch.AppendRaw(m_entry, bytes); },
+              info...);
+        },
+        m_info);
+  }
+
   /**
    * Updates the last value and appends a record to the log if it has changed.
    *
@@ -6,11 +6,13 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <functional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 #include "wpi/datalog/DataLog.hpp"
 #include "wpi/util/condition_variable.hpp"
@@ -34,9 +36,79 @@ namespace wpi::log {
  * The data log is periodically flushed to disk.  It can also be explicitly
  * flushed to disk by using the Flush() function.  This operation is, however,
  * non-blocking.
+ *
+ * How data is written to the file can be tuned with SetWriteOptions(); on
+ * Linux, writes can be submitted asynchronously through io_uring and file
+ * space can be preallocated, which avoids stalls on slow storage.  Statistics
+ * about the writes are available from GetWriteStats().
  */
 class DataLogBackgroundWriter final : public DataLog {
  public:
+  /**
+   * Options for writing to the log file.
+   */
+  struct WriteOptions {
+    /**
+     * Submit writes asynchronously using io_uring.  Only supported on Linux;
+     * if io_uring is not available, writes are made with write().
+     */
+    bool asyncWrites = false;
+
+    /**
+     * Maximum number of asynchronous writes in flight.
+     */
+    int queueDepth = 16;
+
+    /**
+     * Number of bytes of file space to preallocate ahead of the data written,
+     * or 0 to not preallocate.  Only supported on Linux.
+     */
+    uint64_t preallocateSize = 0;
+
+    /**
+     * Number of flushes between syncs of the file to storage, or 0 to never
+     * sync.
+     */
+    int syncInterval = 1;
+  };
+
+  /**
+   * Log file write statistics.
+   */
+  struct WriteStats {
+    /**
+     * Number of buckets in the latency histograms.  Bucket 0 counts latencies
+     * less than 32 us, and each following bucket counts latencies less than
+     * double the limit of the previous bucket.  The last bucket counts all
+     * longer latencies.
+     */
+    static constexpr int kNumLatencyBuckets = 16;
+
+    /** Number of bytes written to the log file. */
+    uint64_t bytesWritten = 0;
+
+    /** Number of completed writes. */
+    uint64_t writes = 0;
+
+    /** Number of completed syncs to storage. */
+    uint64_t syncs = 0;
+
+    /** Number of failed writes and syncs. */
+    uint64_t errors = 0;
+
+    /** Number of writes and syncs submitted but not yet completed. */
+    int queueDepth = 0;
+
+    /** Maximum queue depth seen. */
+    int maxQueueDepth = 0;
+
+    /** Write latency histogram. */
+    std::array<uint64_t, kNumLatencyBuckets> writeLatency{};
+
+    /** Sync latency histogram. */
+    std::array<uint64_t, kNumLatencyBuckets> syncLatency{};
+  };
+
   /**
    * Construct a new Data Log.  The log will be initially created with a
    * temporary filename.
@@ -116,6 +188,22 @@ class DataLogBackgroundWriter final : public DataLog {
    */
   void SetFilename(std::string_view filename);
 
+  /**
+   * Sets options for writing to the log file.  The options take effect at the
+   * next flush.
+   *
+   * @param options write options
+   */
+  void SetWriteOptions(const WriteOptions& options);
+
+  /**
+   * Gets statistics about writes to the log file.  The statistics are updated
+   * after every flush.
+   *
+   * @return write statistics
+   */
+  WriteStats GetWriteStats() const;
+
   /**
    * Explicitly flushes the log data to disk.
    */
@@ -148,6 +236,12 @@ class DataLogBackgroundWriter final : public DataLog {
   bool BufferFull() final;
 
   void StartLogFile(WriterThreadState& state);
+  void ApplyWriteOptions(WriterThreadState& state);
+  void Preallocate(WriterThreadState& state, uint64_t size);
+  void WriteBufs(WriterThreadState& state, std::vector<DataLog::Buffer>& bufs,
+                 size_t count);
+  void WriteComplete(WriterThreadState& state, uint64_t id, int result,
+                     std::string_view filename);
   void WriterThreadMain(std::string_view dir);
   void WriterThreadMain(
       std::function<void(std::span<const uint8_t> data)> write);
@@ -164,6 +258,9 @@ class DataLogBackgroundWriter final : public DataLog {
     kStopped,
   } m_state = kActive;
   double m_period;
+  WriteOptions m_options;
+  mutable wpi::util::mutex m_statsMutex;
+  WriteStats m_stats;
   std::string m_newFilename;
   std::thread m_thread;
 };
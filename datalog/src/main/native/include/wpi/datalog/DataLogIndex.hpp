@@ -0,0 +1,188 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "wpi/util/DenseMap.hpp"
+
+namespace wpi::log {
+
+class DataLogReader;
+
+/**
+ * An index of the records in a data log, allowing records for a particular
+ * entry and time range to be located without scanning the entire log.  The
+ * index maps each entry to the timestamps and byte offsets of its data
+ * records, and also stores the byte offsets of all control records.  Offsets
+ * can be turned back into records with DataLogReader::At().
+ *
+ * Entry IDs can be reused after a Finish record, so an entry is identified by
+ * both its ID and the byte offset of its Start record.
+ *
+ * The index can be saved to a sidecar file alongside the log so that later
+ * opens only need to read the index.  If the log has grown since the index was
+ * saved (e.g. it was still being written), only the new records are scanned.
+ */
+class DataLogIndex {
+ public:
+  /** A data record location. */
+  struct Record {
+    /** Record timestamp, in integer microseconds. */
+    int64_t timestamp;
+
+    /** Byte offset of the record within the log. */
+    size_t offset;
+  };
+
+  /** An entry, identified by its ID and the location of its Start record. */
+  struct Entry {
+    /** Entry ID. */
+    int id;
+
+    /**
+     * Byte offset of the Start record within the log, or 0 for data records
+     * with no Start record.
+     */
+    size_t start;
+  };
+
+  DataLogIndex() = default;
+
+  /**
+   * Builds an index by scanning all records in a data log.
+   *
+   * @param reader data log reader
+   * @return Index
+   */
+  static DataLogIndex Build(const DataLogReader& reader);
+
+  /**
+   * Loads an index from a sidecar file.  Any records added to the log since
+   * the index was saved are indexed as well.
+   *
+   * @param filename index filename
+   * @param reader data log reader for the log the index was built from
+   * @return Index, or empty if the file could not be read or does not match
+   *         the log
+   */
+  static std::optional<DataLogIndex> Load(std::string_view filename,
+                                          const DataLogReader& reader);
+
+  /**
+   * Loads an index from a sidecar file if one exists and matches the log;
+   * otherwise builds it.  If the index was built or extended, it is saved back
+   * to the sidecar file.
+   *
+   * @param filename index filename
+   * @param reader data log reader
+   * @return Index
+   */
+  static DataLogIndex Open(std::string_view filename,
+                           const DataLogReader& reader);
+
+  /**
+   * Gets the conventional sidecar index filename for a log file.
+   *
+   * @param logFilename log filename
+   * @return Index filename
+   */
+  static std::string GetSidecarFilename(std::string_view logFilename) {
+    std::string filename{logFilename};
+    filename += ".idx";
+    return filename;
+  }
+
+  /**
+   * Saves the index to a sidecar file.
+   *
+   * @param filename index filename
+   * @param ec error code (output)
+   * @return True on success
+   */
+  bool Save(std::string_view filename, std::error_code& ec) const;
+
+  /**
+   * Indexes any records in the log past the end of what has already been
+   * indexed.  If the log does not match the index (e.g. it is a different
+   * log), the index is rebuilt from scratch.
+   *
+   * @param reader data log reader
+   * @return True if any records were added to the index
+   */
+  bool Update(const DataLogReader& reader);
+
+  /**
+   * Gets the number of bytes of the log covered by the index.
+   *
+   * @return Byte offset just past the last indexed record
+   */
+  size_t GetIndexedSize() const { return m_end; }
+
+  /**
+   * Gets the total number of indexed records (control and data).
+   *
+   * @return Number of records
+   */
+  size_t GetNumRecords() const { return m_numRecords; }
+
+  /**
+   * Gets the byte offsets of all control records, in log order.
+   *
+   * @return Control record offsets
+   */
+  std::span<const size_t> GetControlRecords() const { return m_control; }
+
+  /**
+   * Gets all entries with data records.
+   *
+   * @return Entries (unordered)
+   */
+  std::vector<Entry> GetEntries() const;
+
+  /**
+   * Gets all data records for an entry, sorted by timestamp (records with
+   * equal timestamps remain in log order).
+   *
+   * @param entry entry ID
+   * @param start byte offset of the entry's Start record
+   * @return Records
+   */
+  std::span<const Record> GetRecords(int entry, size_t start) const;
+
+  /**
+   * Gets the data records for an entry with timestamps in the range
+   * [startTime, endTime), sorted by timestamp.
+   *
+   * @param entry entry ID
+   * @param start byte offset of the entry's Start record
+   * @param startTime start timestamp (inclusive)
+   * @param endTime end timestamp (exclusive)
+   * @return Records
+   */
+  std::span<const Record> GetRecords(int entry, size_t start,
+                                     int64_t startTime, int64_t endTime) const;
+
+ private:
+  size_t m_end = 0;
+  size_t m_logSize = 0;
+  uint64_t m_hash = 0;
+  size_t m_numRecords = 0;
+  std::vector<size_t> m_control;
+  // Start record offset of each entry ID that hasn't been finished
+  wpi::util::DenseMap<int, size_t> m_live;
+  // keyed by entry ID and Start record offset
+  wpi::util::DenseMap<std::pair<int, size_t>, std::vector<Record>> m_records;
+};
+
+}  // namespace wpi::log
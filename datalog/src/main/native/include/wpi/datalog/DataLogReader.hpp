@@ -239,6 +239,30 @@ class DataLogRecord {
    */
   bool GetStringArray(std::vector<std::string_view>* arr) const;
 
+  /**
+   * Decodes a data record as a set of packed integer samples. Note if the data
+   * type (as indicated in the corresponding start control record for this
+   * entry) is not "packed:int64", invalid results may be returned.
+   *
+   * @param[out] timestamps sample timestamps (if successful)
+   * @param[out] values sample values (if successful)
+   * @return True on success, false on error
+   */
+  bool GetPackedIntegers(std::vector<int64_t>* timestamps,
+                         std::vector<int64_t>* values) const;
+
+  /**
+   * Decodes a data record as a set of packed double samples. Note if the data
+   * type (as indicated in the corresponding start control record for this
+   * entry) is not "packed:double", invalid results may be returned.
+   *
+   * @param[out] timestamps sample timestamps (if successful)
+   * @param[out] values sample values (if successful)
+   * @return True on success, false on error
+   */
+  bool GetPackedDoubles(std::vector<int64_t>* timestamps,
+                        std::vector<double>* values) const;
+
  private:
   int64_t m_timestamp{0};
   std::span<const uint8_t> m_data;
@@ -288,6 +312,14 @@ class DataLogIterator {
 
   pointer operator->() const { return &this->operator*(); }
 
+  /**
+   * Gets the byte offset of the current record within the log.  The iterator
+   * can be recreated later with DataLogReader::At().
+   *
+   * @return Byte offset
+   */
+  size_t GetOffset() const { return m_pos; }
+
  protected:
   const DataLogReader* m_reader;
   size_t m_pos;
@@ -344,6 +376,25 @@ class DataLogReader {
   /** Returns end iterator. */
   iterator end() const { return DataLogIterator{this, SIZE_MAX}; }
 
+  /**
+   * Returns iterator to the record at the given byte offset.  The offset must
+   * be the start of a record, e.g. as returned by DataLogIterator::GetOffset()
+   * or stored in a DataLogIndex.
+   *
+   * @param pos byte offset of record
+   * @return Iterator
+   */
+  iterator At(size_t pos) const { return DataLogIterator{this, pos}; }
+
+  /**
+   * Gets the raw contents of the log.
+   *
+   * @return Log contents (empty if invalid)
+   */
+  std::span<const uint8_t> GetBuffer() const {
+    return m_buf ? m_buf->GetBuffer() : std::span<const uint8_t>{};
+  }
+
  private:
   std::unique_ptr<wpi::util::MemoryBuffer> m_buf;
 
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -16,6 +17,7 @@
 #include <upb/mem/arena.h>
 #include <upb/reflection/def.h>
 
+#include "wpi/datalog/DataLogIndex.hpp"
 #include "wpi/datalog/DataLogReader.hpp"
 #include "wpi/util/DenseMap.hpp"
 #include "wpi/util/Signal.h"
@@ -53,17 +55,37 @@ class DataLogReaderThread {
   /**
    * Connects the callback before starting the reader thread. The callback runs
    * on the reader thread and receives this object so it can query entries.
+   * The log is scanned by the reader thread alone.
    */
   DataLogReaderThread(wpi::log::DataLogReader reader,
                       EntryAddedCallback entryAddedCallback)
-      : m_reader{std::move(reader)} {
-    if (entryAddedCallback) {
-      sigEntryAdded.connect(
-          [this, callback = std::move(entryAddedCallback)](
-              const DataLogReaderEntry& entry) { callback(*this, entry); });
-    }
-    m_thread = std::thread{[this] { ReadMain(); }};
-  }
+      : DataLogReaderThread{std::move(reader), 1u,
+                            std::move(entryAddedCallback)} {}
+
+  /**
+   * Scans the log with multiple threads. The log is split into chunks that are
+   * parsed concurrently; the entry table is then built from the chunk results
+   * in log order.  The other constructors scan serially.
+   *
+   * @param numThreads number of scan threads; 0 uses the hardware concurrency
+   *                   for logs large enough to benefit
+   */
+  DataLogReaderThread(wpi::log::DataLogReader reader, unsigned int numThreads,
+                      EntryAddedCallback entryAddedCallback = {})
+      : DataLogReaderThread{std::move(reader), std::nullopt, numThreads,
+                            std::move(entryAddedCallback)} {}
+
+  /**
+   * Uses a record index to find entries. Only control records and schema data
+   * records are read, so loading time depends on the size of the index rather
+   * than the size of the log.
+   */
+  DataLogReaderThread(wpi::log::DataLogReader reader,
+                      std::optional<DataLogIndex> index,
+                      EntryAddedCallback entryAddedCallback = {})
+      : DataLogReaderThread{std::move(reader), std::move(index), 1u,
+                            std::move(entryAddedCallback)} {}
+
   ~DataLogReaderThread();
 
   bool IsDone() const { return m_done; }
@@ -111,14 +133,36 @@ class DataLogReaderThread {
 
   const wpi::log::DataLogReader& GetReader() const { return m_reader; }
 
+  // returns nullptr if not constructed with an index
+  const DataLogIndex* GetIndex() const {
+    return m_index ? &*m_index : nullptr;
+  }
+
   // note: these are called on separate thread
   wpi::util::sig::Signal_mt<const DataLogReaderEntry&> sigEntryAdded;
   wpi::util::sig::Signal_mt<> sigDone;
 
  private:
+  DataLogReaderThread(wpi::log::DataLogReader reader,
+                      std::optional<DataLogIndex> index,
+                      unsigned int numThreads,
+                      EntryAddedCallback entryAddedCallback)
+      : m_reader{std::move(reader)},
+        m_index{std::move(index)},
+        m_numThreads{numThreads} {
+    if (entryAddedCallback) {
+      sigEntryAdded.connect(
+          [this, callback = std::move(entryAddedCallback)](
+              const DataLogReaderEntry& entry) { callback(*this, entry); });
+    }
+    m_thread = std::thread{[this] { ReadMain(); }};
+  }
+
   void ReadMain();
 
   wpi::log::DataLogReader m_reader;
+  std::optional<DataLogIndex> m_index;
+  unsigned int m_numThreads;
   mutable wpi::util::mutex m_mutex;
   std::atomic_bool m_active{true};
   std::atomic_bool m_done{false};
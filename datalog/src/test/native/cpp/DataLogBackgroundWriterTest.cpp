@@ -13,9 +13,11 @@
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include "wpi/datalog/DataLogReader.hpp"
 #include "wpi/util/MemoryBuffer.hpp"
+#include "wpi/util/fs.hpp"
 
 namespace {
 
@@ -201,3 +203,75 @@ TEST_CASE("DataLogBackgroundWriterTest FlushWakesAfterBlockedDrain",
   writer.reset();
   REQUIRE(secondDrainWasPrompt);
 }
+
+TEST_CASE("DataLogBackgroundWriterTest WriteOptions",
+          "[datalog][background-writer]") {
+  bool asyncWrites = GENERATE(false, true);
+  auto dir = fs::temp_directory_path();
+  std::string filename = asyncWrites
+                             ? "DataLogBackgroundWriterTest.async.wpilog"
+                             : "DataLogBackgroundWriterTest.wpilog";
+  std::error_code ec;
+  fs::remove(dir / filename, ec);
+
+  std::vector<uint8_t> payload(1000, 0xa5);
+  wpi::log::DataLogBackgroundWriter::WriteStats stats;
+  {
+    wpi::log::DataLogBackgroundWriter writer{dir.string(), filename, 30.0};
+    writer.SetWriteOptions({.asyncWrites = asyncWrites,
+                            .queueDepth = 4,
+                            .preallocateSize = 64 * 1024,
+                            .syncInterval = 2});
+    int entry = writer.Start("raw", "raw", {}, 1);
+    // flush in several rounds, waiting for each to be written
+    for (int round = 0; round < 10; ++round) {
+      for (int i = round * 10; i < (round + 1) * 10; ++i) {
+        payload[0] = i;
+        writer.AppendRaw(entry, payload, i + 2);
+      }
+      writer.Flush();
+      auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds{2};
+      do {
+        stats = writer.GetWriteStats();
+        if (stats.bytesWritten > (round + 1) * 10 * payload.size() &&
+            stats.queueDepth == 0) {
+          break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      } while (std::chrono::steady_clock::now() < deadline);
+    }
+  }
+
+  CHECK(stats.bytesWritten > 100 * payload.size());
+  CHECK(stats.writes > 0);
+  CHECK(stats.syncs > 0);
+  CHECK(stats.errors == 0);
+  CHECK(stats.queueDepth == 0);
+  uint64_t latencyCount = 0;
+  for (auto count : stats.writeLatency) {
+    latencyCount += count;
+  }
+  CHECK(latencyCount == stats.writes);
+
+  auto size = fs::file_size(dir / filename, ec);
+  REQUIRE(!ec);
+  CHECK(size >= stats.bytesWritten);
+
+  auto buf = wpi::util::MemoryBuffer::GetFile((dir / filename).string());
+  REQUIRE(buf);
+  wpi::log::DataLogReader reader{std::move(*buf)};
+  REQUIRE(reader.IsValid());
+  int count = 0;
+  for (const auto& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    auto data = record.GetRaw();
+    REQUIRE(data.size() == payload.size());
+    CHECK(data[0] == count);
+    ++count;
+  }
+  CHECK(count == 100);
+  fs::remove(dir / filename, ec);
+}
@@ -0,0 +1,235 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/datalog/DataLogIndex.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "wpi/datalog/DataLogReader.hpp"
+#include "wpi/datalog/DataLogReaderThread.hpp"
+#include "wpi/datalog/DataLogWriter.hpp"
+#include "wpi/util/MemoryBuffer.hpp"
+#include "wpi/util/fs.hpp"
+#include "wpi/util/raw_ostream.hpp"
+
+namespace {
+std::vector<uint8_t> MakeLog(int count) {
+  std::vector<uint8_t> output;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    int a = writer.Start("a", "int64", {}, 1);
+    int b = writer.Start("b", "double", {}, 1);
+    for (int i = 0; i < count; ++i) {
+      writer.AppendInteger(a, i, 10 + i * 10);
+      writer.AppendDouble(b, i, 15 + i * 10);
+    }
+    writer.Finish(b, 20 + count * 10);
+    writer.Flush();
+  }
+  return output;
+}
+
+wpi::log::DataLogReader MakeReader(const std::vector<uint8_t>& data) {
+  return wpi::log::DataLogReader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(data, "index")};
+}
+}  // namespace
+
+TEST_CASE("DataLogIndexTest Build", "[datalog][index]") {
+  auto data = MakeLog(100);
+  auto reader = MakeReader(data);
+  auto index = wpi::log::DataLogIndex::Build(reader);
+
+  CHECK(index.GetIndexedSize() == data.size());
+  CHECK(index.GetNumRecords() == 203u);
+  CHECK(index.GetControlRecords().size() == 3u);
+  CHECK(index.GetEntries().size() == 2u);
+  for (auto pos : index.GetControlRecords()) {
+    CHECK(reader.At(pos)->IsControl());
+  }
+
+  auto control = index.GetControlRecords();
+  auto records = index.GetRecords(1, control[0]);
+  REQUIRE(records.size() == 100u);
+  for (size_t i = 0; i < records.size(); ++i) {
+    auto it = reader.At(records[i].offset);
+    CHECK(it->GetEntry() == 1);
+    CHECK(it->GetTimestamp() == records[i].timestamp);
+    int64_t value = 0;
+    REQUIRE(it->GetInteger(&value));
+    CHECK(value == static_cast<int64_t>(i));
+  }
+  CHECK(index.GetRecords(1, control[1]).empty());
+  CHECK(index.GetRecords(3, control[0]).empty());
+}
+
+TEST_CASE("DataLogIndexTest TimeRange", "[datalog][index]") {
+  auto data = MakeLog(100);
+  auto reader = MakeReader(data);
+  auto index = wpi::log::DataLogIndex::Build(reader);
+
+  auto control = index.GetControlRecords();
+  auto records = index.GetRecords(2, control[1], 100, 200);
+  REQUIRE(records.size() == 10u);
+  CHECK(records.front().timestamp == 105);
+  CHECK(records.back().timestamp == 195);
+  CHECK(index.GetRecords(2, control[1], 2000, 3000).empty());
+  CHECK(index.GetRecords(1, control[0], 0, 20).size() == 1u);
+}
+
+TEST_CASE("DataLogIndexTest SaveLoad", "[datalog][index]") {
+  auto data = MakeLog(50);
+  auto reader = MakeReader(data);
+  auto filename =
+      (fs::temp_directory_path() / "DataLogIndexTest.wpilog.idx").string();
+
+  auto index = wpi::log::DataLogIndex::Build(reader);
+  std::error_code ec;
+  REQUIRE(index.Save(filename, ec));
+
+  auto loaded = wpi::log::DataLogIndex::Load(filename, reader);
+  REQUIRE(loaded);
+  CHECK(loaded->GetIndexedSize() == index.GetIndexedSize());
+  CHECK(loaded->GetNumRecords() == index.GetNumRecords());
+  size_t start = index.GetControlRecords()[1];
+  REQUIRE(loaded->GetRecords(2, start).size() == 50u);
+  CHECK(loaded->GetRecords(2, start)[7].offset ==
+        index.GetRecords(2, start)[7].offset);
+
+  // a different log must not use the index
+  auto other = MakeLog(10);
+  other[12] ^= 0xff;
+  CHECK_FALSE(wpi::log::DataLogIndex::Load(filename, MakeReader(other)));
+
+  fs::remove(filename, ec);
+}
+
+TEST_CASE("DataLogIndexTest SameHeaderDifferentLog", "[datalog][index]") {
+  // larger than the hashed sample at the start of the log
+  auto data = MakeLog(1000);
+  REQUIRE(data.size() > 3 * 4096);
+  auto reader = MakeReader(data);
+  auto filename =
+      (fs::temp_directory_path() / "DataLogIndexTest.mismatch.idx").string();
+  auto index = wpi::log::DataLogIndex::Build(reader);
+  std::error_code ec;
+  REQUIRE(index.Save(filename, ec));
+  REQUIRE(wpi::log::DataLogIndex::Load(filename, reader));
+
+  // same size and header, different data near the end
+  auto other = data;
+  other[other.size() - 20] ^= 0xff;
+  CHECK_FALSE(wpi::log::DataLogIndex::Load(filename, MakeReader(other)));
+
+  // log with a trailing partial record, later replaced by a shorter log
+  auto partial = data;
+  partial.push_back(0x20);
+  auto partialIndex = wpi::log::DataLogIndex::Build(MakeReader(partial));
+  CHECK(partialIndex.GetIndexedSize() == data.size());
+  REQUIRE(partialIndex.Save(filename, ec));
+  CHECK(wpi::log::DataLogIndex::Load(filename, MakeReader(partial)));
+  CHECK_FALSE(wpi::log::DataLogIndex::Load(filename, reader));
+
+  fs::remove(filename, ec);
+}
+
+TEST_CASE("DataLogIndexTest Extend", "[datalog][index]") {
+  auto full = MakeLog(100);
+  auto partialData = std::vector<uint8_t>(full.begin(), full.begin() + 400);
+  auto partial = MakeReader(partialData);
+  auto index = wpi::log::DataLogIndex::Build(partial);
+  size_t partialRecords = index.GetNumRecords();
+  CHECK(index.GetIndexedSize() <= 400u);
+
+  auto reader = MakeReader(full);
+  CHECK(index.Update(reader));
+  CHECK(index.GetNumRecords() > partialRecords);
+  CHECK(index.GetIndexedSize() == full.size());
+  CHECK(index.GetRecords(1, index.GetControlRecords()[0]).size() == 100u);
+  CHECK_FALSE(index.Update(reader));
+}
+
+TEST_CASE("DataLogIndexTest ReusedId", "[datalog][index]") {
+  // the writer doesn't reuse IDs, so join the records of two logs
+  std::vector<uint8_t> first;
+  std::vector<uint8_t> second;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(first)};
+    int a = writer.Start("/.schema/struct:Foo", "structschema", {}, 1);
+    writer.AppendString(a, "int32 x", 10);
+    writer.AppendString(a, "int32 x;int32 y", 20);
+    writer.Finish(a, 30);
+    writer.Flush();
+  }
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(second)};
+    int b = writer.Start("b", "string", {}, 40);
+    REQUIRE(b == 1);
+    writer.AppendString(b, "not a schema", 50);
+    writer.Flush();
+  }
+  auto data = first;
+  data.insert(data.end(),
+              second.begin() + MakeReader(second).begin().GetOffset(),
+              second.end());
+  auto reader = MakeReader(data);
+  auto filename =
+      (fs::temp_directory_path() / "DataLogIndexTest.reused.idx").string();
+
+  // split the log so the second Start is picked up by Update after Load
+  auto partialData = std::vector<uint8_t>(data.begin(), data.begin() +
+                                                            first.size());
+  auto index = wpi::log::DataLogIndex::Build(MakeReader(partialData));
+  std::error_code ec;
+  REQUIRE(index.Save(filename, ec));
+  auto loaded = wpi::log::DataLogIndex::Load(filename, reader);
+  REQUIRE(loaded);
+  fs::remove(filename, ec);
+
+  auto control = loaded->GetControlRecords();
+  REQUIRE(control.size() == 3u);
+  CHECK(loaded->GetEntries().size() == 2u);
+  auto aRecords = loaded->GetRecords(1, control[0]);
+  REQUIRE(aRecords.size() == 2u);
+  CHECK(aRecords.back().timestamp == 20);
+  auto bRecords = loaded->GetRecords(1, control[2]);
+  REQUIRE(bRecords.size() == 1u);
+  CHECK(bRecords.front().timestamp == 50);
+
+  // the schema comes from the first entry, not the later one using its ID
+  wpi::log::DataLogReaderThread thread{std::move(reader), std::move(loaded)};
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+  while (!thread.IsDone() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  REQUIRE(thread.IsDone());
+  auto desc = thread.GetStructDatabase().Find("Foo");
+  REQUIRE(desc);
+  CHECK(desc->GetSize() == 8u);
+}
+
+TEST_CASE("DataLogIndexTest ReaderThread", "[datalog][index]") {
+  auto data = MakeLog(100);
+  auto reader = MakeReader(data);
+  auto index = wpi::log::DataLogIndex::Build(reader);
+  wpi::log::DataLogReaderThread thread{std::move(reader), std::move(index)};
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+  while (!thread.IsDone() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  REQUIRE(thread.IsDone());
+  CHECK(thread.GetNumRecords() == 203u);
+  CHECK(thread.GetNumEntries() == 2u);
+  REQUIRE(thread.GetIndex());
+  CHECK(thread.GetEntry("a") != nullptr);
+}
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <memory>
 #include <span>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -49,6 +50,35 @@ std::vector<uint8_t> MakeEntryLog() {
   return output;
 }
 
+std::vector<uint8_t> MakeLargeLog() {
+  std::vector<uint8_t> output;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    writer.AddSchema("struct:A", "structschema", std::string_view{"int8 a"},
+                     1);
+    std::vector<int> entries;
+    for (int i = 0; i < 2000; ++i) {
+      if (i % 100 == 0) {
+        entries.emplace_back(
+            writer.Start("entry" + std::to_string(i / 100), "raw", {}, i + 1));
+      }
+      if (i % 300 == 299) {
+        writer.Finish(entries[i / 300], i + 1);
+      }
+      if (i % 250 == 0) {
+        writer.SetMetadata(entries.back(), std::to_string(i), i + 1);
+      }
+      // payload sizes and contents vary so chunk starts land mid-record
+      std::vector<uint8_t> payload(i % 37 + (i % 500 == 0 ? 20000 : 0),
+                                   static_cast<uint8_t>(i));
+      writer.AppendRaw(entries.back(), payload, i + 1);
+    }
+    writer.Flush();
+  }
+  return output;
+}
+
 bool WaitForDone(const wpi::log::DataLogReaderThread& thread,
                  std::chrono::steady_clock::duration timeout) {
   auto deadline = std::chrono::steady_clock::now() + timeout;
@@ -99,3 +129,43 @@ TEST_CASE("DataLogReaderThreadTest EntryCallbackCanQueryEntries",
   CHECK(state->foundById);
   CHECK(state->foundByIteration);
 }
+
+TEST_CASE("DataLogReaderThreadTest ParallelScanMatchesSerial",
+          "[datalog][reader-thread]") {
+  auto output = MakeLargeLog();
+  for (size_t size : {output.size(), output.size() - 7}) {
+    std::vector<uint8_t> data{output.begin(), output.begin() + size};
+    wpi::log::DataLogReaderThread serial{
+        wpi::log::DataLogReader{
+            wpi::util::MemoryBuffer::GetMemBufferCopy(data, "serial")},
+        1u};
+    REQUIRE(WaitForDone(serial, std::chrono::seconds{10}));
+    CHECK(serial.GetNumEntries() == 21u);
+
+    for (unsigned int numThreads : {2u, 3u, 8u, 64u}) {
+      DYNAMIC_SECTION("size=" << size << " threads=" << numThreads) {
+        wpi::log::DataLogReaderThread parallel{
+            wpi::log::DataLogReader{
+                wpi::util::MemoryBuffer::GetMemBufferCopy(data, "parallel")},
+            numThreads};
+        REQUIRE(WaitForDone(parallel, std::chrono::seconds{10}));
+        CHECK(parallel.GetNumRecords() == serial.GetNumRecords());
+        CHECK(parallel.GetNumEntries() == serial.GetNumEntries());
+        serial.ForEachEntryName([&](const wpi::log::DataLogReaderEntry& a) {
+          auto b = parallel.GetEntry(a.name);
+          REQUIRE(b);
+          CHECK(a.entry == b->entry);
+          CHECK(a.metadata == b->metadata);
+          REQUIRE(a.ranges.size() == b->ranges.size());
+          for (size_t i = 0; i < a.ranges.size(); ++i) {
+            CHECK(a.ranges[i].begin().GetOffset() ==
+                  b->ranges[i].begin().GetOffset());
+            CHECK(a.ranges[i].end().GetOffset() ==
+                  b->ranges[i].end().GetOffset());
+          }
+        });
+        CHECK(parallel.GetStructDatabase().Find("A") != nullptr);
+      }
+    }
+  }
+}
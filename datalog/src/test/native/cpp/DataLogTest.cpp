@@ -3,8 +3,11 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <array>
+#include <bit>
 #include <chrono>
+#include <cmath>
 #include <future>
+#include <limits>
 #include <memory>
 #include <string>
 #include <thread>
@@ -12,6 +15,7 @@
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include "wpi/datalog/DataLogReader.hpp"
 #include "wpi/datalog/DataLogWriter.hpp"
@@ -212,6 +216,384 @@ TEST_CASE("DataLogTest ExtraHeaderCrossesBufferBoundary",
   }
 }
 
+TEST_CASE("DataLogTest ThreadLocalMergesInTimestampOrder",
+          "[datalog][data-log]") {
+  static constexpr int kThreads = 4;
+  static constexpr int kPerThread = 5000;
+  std::vector<uint8_t> output;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    writer.SetThreadLocalBuffering(true);
+    REQUIRE(writer.IsThreadLocalBuffering());
+    int entry = writer.Start("integer", "int64", {}, 1);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&, i] {
+        for (int j = 0; j < kPerThread; ++j) {
+          writer.AppendInteger(entry, i, 2 + j * kThreads + i);
+        }
+      });
+    }
+    for (auto&& thread : threads) {
+      thread.join();
+    }
+    writer.Flush();
+  }
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "thread-local")};
+  REQUIRE(reader.IsValid());
+  int count = 0;
+  int64_t lastTimestamp = 0;
+  for (const auto& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    CHECK(record.GetTimestamp() > lastTimestamp);
+    lastTimestamp = record.GetTimestamp();
+    int64_t value = 0;
+    REQUIRE(record.GetInteger(&value));
+    CHECK(value == (lastTimestamp - 2) % kThreads);
+    ++count;
+  }
+  CHECK(count == kThreads * kPerThread);
+}
+
+namespace {
+class CountingLog final : public wpi::log::DataLog {
+ public:
+  CountingLog() : DataLog{msglog} {}
+  ~CountingLog() final { Flush(); }
+
+  void Flush() final {
+    std::vector<Buffer> bufs;
+    FlushBufs(&bufs);
+    ReleaseBufs(&bufs);
+  }
+
+  int halfFull = 0;
+
+ protected:
+  void BufferHalfFull() final { ++halfFull; }
+  bool BufferFull() final { return false; }
+
+ private:
+  wpi::util::Logger msglog;
+};
+}  // namespace
+
+TEST_CASE("DataLogTest ThreadLocalBufferLimitIsShared",
+          "[datalog][data-log]") {
+  static constexpr int kThreads = 4;
+  CountingLog log;
+  log.SetThreadLocalBuffering(true);
+  int entry = log.Start("raw", "raw", {}, 1);
+  // each thread stays well under half the limit on its own, but together
+  // they exceed it
+  std::vector<uint8_t> payload(1000);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 200; ++j) {
+        log.AppendRaw(entry, payload, 2);
+      }
+    });
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  CHECK(log.halfFull == 1);
+}
+
+TEST_CASE("DataLogTest ThreadLocalIdleThreadPruned", "[datalog][data-log]") {
+  std::vector<uint8_t> output;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    writer.SetThreadLocalBuffering(true);
+    int entry = writer.Start("integer", "int64", {}, 1);
+    writer.AppendInteger(entry, 1, 2);
+    // the buffer is idle for a full flush and is pruned
+    writer.Flush();
+    writer.Flush();
+    writer.Flush();
+    // the same thread gets a new buffer
+    writer.AppendInteger(entry, 2, 3);
+    std::thread{[&] { writer.AppendInteger(entry, 3, 4); }}.join();
+    writer.Flush();
+    writer.Flush();
+    writer.AppendInteger(entry, 4, 5);
+    writer.Flush();
+  }
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "thread-local")};
+  REQUIRE(reader.IsValid());
+  std::vector<int64_t> values;
+  for (const auto& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    int64_t value = 0;
+    REQUIRE(record.GetInteger(&value));
+    values.push_back(value);
+  }
+  CHECK(values == std::vector<int64_t>{1, 2, 3, 4});
+}
+
+TEST_CASE("DataLogTest ThreadLocalFinishFollowsData", "[datalog][data-log]") {
+  std::vector<uint8_t> output;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    writer.SetThreadLocalBuffering(true);
+    int entry = writer.Start("string", "string", {}, 1);
+    writer.AppendString(entry, std::string(20000, 'x'), 2);
+    writer.Finish(entry, 3);
+    writer.SetThreadLocalBuffering(false);
+    writer.Flush();
+  }
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "thread-local")};
+  REQUIRE(reader.IsValid());
+  std::vector<int64_t> timestamps;
+  for (const auto& record : reader) {
+    timestamps.push_back(record.GetTimestamp());
+    if (!record.IsControl()) {
+      CHECK(record.GetSize() == 20000u);
+    }
+  }
+  CHECK(timestamps == std::vector<int64_t>{1, 2, 3});
+}
+
+TEST_CASE("DataLogTest PackedIntegerRoundTrip", "[datalog][data-log]") {
+  std::vector<uint8_t> output;
+  std::vector<int64_t> expectedTimestamps;
+  std::vector<int64_t> expectedValues;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    wpi::log::PackedIntegerLogEntry entry{writer, "packed", 1};
+    int64_t timestamp = 1000;
+    for (int i = 0; i < 1000; ++i) {
+      // mostly steady period with jitter, plus extreme values
+      timestamp += 20000 + (i % 7) - 3;
+      int64_t value = i * 3 - 500;
+      if (i == 500) {
+        value = std::numeric_limits<int64_t>::min();
+      } else if (i == 501) {
+        value = std::numeric_limits<int64_t>::max();
+      }
+      entry.Append(value, timestamp);
+      expectedTimestamps.push_back(timestamp);
+      expectedValues.push_back(value);
+    }
+    writer.Flush();
+  }
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "packed")};
+  REQUIRE(reader.IsValid());
+  std::vector<int64_t> timestamps;
+  std::vector<int64_t> values;
+  int records = 0;
+  for (const auto& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    std::vector<int64_t> ts;
+    std::vector<int64_t> vals;
+    REQUIRE(record.GetPackedIntegers(&ts, &vals));
+    REQUIRE(ts.size() == vals.size());
+    CHECK(ts.front() == record.GetTimestamp());
+    timestamps.insert(timestamps.end(), ts.begin(), ts.end());
+    values.insert(values.end(), vals.begin(), vals.end());
+    ++records;
+  }
+  CHECK(records > 1);
+  CHECK(timestamps == expectedTimestamps);
+  CHECK(values == expectedValues);
+}
+
+TEST_CASE("DataLogTest PackedDoubleRoundTrip", "[datalog][data-log]") {
+  std::vector<uint8_t> output;
+  std::vector<uint8_t> unpackedOutput;
+  std::vector<double> expected;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    wpi::log::DataLogWriter unpackedWriter{
+        std::make_unique<wpi::util::raw_uvector_ostream>(unpackedOutput)};
+    wpi::log::PackedDoubleLogEntry entry{writer, "packed", 1};
+    wpi::log::DoubleLogEntry unpackedEntry{unpackedWriter, "packed", 1};
+    for (int i = 0; i < 1000; ++i) {
+      double value = i < 600 ? (i / 50) * 0.25 : std::sin(i * 0.01);
+      if (i == 700) {
+        value = -0.0;
+      } else if (i == 701) {
+        value = std::numeric_limits<double>::infinity();
+      }
+      entry.Append(value, 1000 + i * 20000);
+      unpackedEntry.Append(value, 1000 + i * 20000);
+      expected.push_back(value);
+      // flushing mid-stream starts a new record
+      if (i == 42) {
+        writer.Flush();
+      }
+    }
+    writer.Flush();
+    unpackedWriter.Flush();
+  }
+  CHECK(output.size() * 3 < unpackedOutput.size());
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "packed")};
+  REQUIRE(reader.IsValid());
+  std::vector<double> values;
+  int64_t expectedTimestamp = 1000;
+  for (const auto& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    std::vector<int64_t> ts;
+    std::vector<double> vals;
+    REQUIRE(record.GetPackedDoubles(&ts, &vals));
+    for (auto timestamp : ts) {
+      CHECK(timestamp == expectedTimestamp);
+      expectedTimestamp += 20000;
+    }
+    values.insert(values.end(), vals.begin(), vals.end());
+  }
+  REQUIRE(values.size() == expected.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    CHECK(std::bit_cast<uint64_t>(values[i]) ==
+          std::bit_cast<uint64_t>(expected[i]));
+  }
+}
+
+TEST_CASE("DataLogTest PackedFinishFlushesSamples", "[datalog][data-log]") {
+  std::vector<uint8_t> output;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    int entry = writer.Start("packed", "packed:int64", {}, 1);
+    writer.AppendPackedInteger(entry, 5, 2);
+    writer.AppendPackedInteger(entry, 6, 3);
+    writer.Finish(entry, 4);
+    writer.Flush();
+  }
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "packed")};
+  std::vector<int64_t> timestamps;
+  for (const auto& record : reader) {
+    timestamps.push_back(record.GetTimestamp());
+    if (!record.IsControl()) {
+      std::vector<int64_t> ts;
+      std::vector<int64_t> vals;
+      REQUIRE(record.GetPackedIntegers(&ts, &vals));
+      CHECK(ts == std::vector<int64_t>{2, 3});
+      CHECK(vals == std::vector<int64_t>{5, 6});
+      int64_t value;
+      CHECK_FALSE(record.GetInteger(&value));
+    }
+  }
+  CHECK(timestamps == std::vector<int64_t>{1, 2, 4});
+}
+
+TEST_CASE("DataLogTest BatchSharesTimestamp", "[datalog][data-log]") {
+  bool threadLocal = GENERATE(false, true);
+  std::vector<uint8_t> output;
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    writer.SetThreadLocalBuffering(threadLocal);
+    wpi::log::IntegerLogEntry intEntry{writer, "int", 1};
+    wpi::log::DoubleArrayLogEntry arrEntry{writer, "arr", 1};
+    wpi::log::StringArrayLogEntry strEntry{writer, "str", 1};
+    wpi::log::DataLogBatch batch;
+    CHECK(batch.IsEmpty());
+    intEntry.Append(batch, 5);
+    std::array<double, 2> arr{1.0, 2.5};
+    std::array<std::string_view, 2> strs{"a", "bc"};
+    arrEntry.Append(batch, arr);
+    strEntry.Append(batch, strs);
+    // invalid entries are ignored
+    batch.AppendInteger(0, 1);
+    CHECK(batch.GetNumRecords() == 3);
+    batch.Commit(writer, 7);
+    CHECK(batch.IsEmpty());
+    // committing an empty batch does nothing
+    batch.Commit(writer, 8);
+    writer.Flush();
+  }
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "batch")};
+  std::vector<int> entries;
+  for (const auto& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    CHECK(record.GetTimestamp() == 7);
+    entries.push_back(record.GetEntry());
+    if (record.GetEntry() == 1) {
+      int64_t value;
+      REQUIRE(record.GetInteger(&value));
+      CHECK(value == 5);
+    } else if (record.GetEntry() == 2) {
+      std::vector<double> arr;
+      REQUIRE(record.GetDoubleArray(&arr));
+      CHECK(arr == std::vector<double>{1.0, 2.5});
+    } else if (record.GetEntry() == 3) {
+      std::vector<std::string_view> arr;
+      REQUIRE(record.GetStringArray(&arr));
+      REQUIRE(arr.size() == 2);
+      CHECK(arr[0] == "a");
+      CHECK(arr[1] == "bc");
+    }
+  }
+  CHECK(entries == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("DataLogTest BatchLargerThanBlock", "[datalog][data-log]") {
+  bool threadLocal = GENERATE(false, true);
+  std::vector<uint8_t> output;
+  // 6 records of 4 KiB are larger than a single 16 KiB block
+  std::vector<uint8_t> raw(4096, 0x5a);
+  {
+    wpi::log::DataLogWriter writer{
+        std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+    writer.SetThreadLocalBuffering(threadLocal);
+    wpi::log::RawLogEntry entry{writer, "raw", 1};
+    wpi::log::DataLogBatch batch;
+    for (int i = 0; i < 6; ++i) {
+      raw[0] = i;
+      entry.Append(batch, raw);
+    }
+    batch.Commit(writer, 10);
+    writer.Flush();
+  }
+
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(output, "batch")};
+  int count = 0;
+  for (const auto& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    CHECK(record.GetTimestamp() == 10);
+    auto data = record.GetRaw();
+    REQUIRE(data.size() == raw.size());
+    CHECK(data[0] == count);
+    CHECK(data[1] == 0x5a);
+    ++count;
+  }
+  CHECK(count == 6);
+}
+
 TEST_CASE_METHOD(DataLogTest, "DataLogTest SimpleInt", "[datalog][data-log]") {
   int entry = log.Start("test", "int64", "", 1);
   log.AppendInteger(entry, 1, 2);
@@ -28,8 +28,8 @@ template <ValidType T>
 static inline bool Set(NT_Handle pubentry, typename TypeInfo<T>::View value,
                        int64_t time) {
   if (auto ii = InstanceImpl::Get(Handle{pubentry}.GetInst())) {
-    return ii->localStorage.SetEntryValue(
-        pubentry, MakeValue<T>(value, time == 0 ? Now() : time));
+    return ii->localStorage.SetEntryValue<T>(pubentry, value,
+                                             time == 0 ? Now() : time);
   } else {
     return {};
   }
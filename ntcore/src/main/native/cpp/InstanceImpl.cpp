@@ -118,6 +118,11 @@ void InstanceImpl::StartServer(std::string_view persistFilename,
           networkMode |= NT_NET_MODE_MDNS_ANNOUNCING;
         }
       });
+  if (m_sharedMemory) {
+    m_networkServer->StartSharedMemory(
+        m_sharedMemory->name, m_sharedMemory->size, m_sharedMemory->maxTopics,
+        m_sharedMemory->worldReadable);
+  }
   networkMode = NT_NET_MODE_SERVER | NT_NET_MODE_STARTING;
   listenerStorage.NotifyTimeSync({}, NT_EVENT_TIME_SYNC, 0, 0, true);
   m_serverTimeOffset = 0;
@@ -139,6 +144,18 @@ void InstanceImpl::StopServer() {
   }
 }
 
+void InstanceImpl::SetServerSharedMemory(std::string_view name, size_t size,
+                                         unsigned int maxTopics,
+                                         bool worldReadable) {
+  std::scoped_lock lock{m_mutex};
+  if (name.empty()) {
+    m_sharedMemory.reset();
+  } else {
+    m_sharedMemory =
+        SharedMemoryConfig{std::string{name}, size, maxTopics, worldReadable};
+  }
+}
+
 void InstanceImpl::StartClient(std::string_view identity) {
   std::scoped_lock lock{m_mutex};
   if (networkMode != NT_NET_MODE_NONE) {
@@ -241,6 +258,7 @@ void InstanceImpl::Reset() {
   m_networkClient.reset();
   m_servers.clear();
   m_serverResolver.reset();
+  m_sharedMemory.reset();
   networkMode = NT_NET_MODE_NONE;
   m_serverTimeOffset.reset();
   m_rtt2 = 0;
@@ -47,6 +47,8 @@ class InstanceImpl {
                    std::string_view listenAddress, std::string_view mdnsService,
                    unsigned int port);
   void StopServer();
+  void SetServerSharedMemory(std::string_view name, size_t size,
+                             unsigned int maxTopics, bool worldReadable);
   void StartClient(std::string_view identity);
   void StopClient();
   void SetServers(
@@ -95,6 +97,13 @@ class InstanceImpl {
   std::shared_ptr<INetworkClient> m_networkClient;
   std::vector<std::pair<std::string, unsigned int>> m_servers;
   std::optional<INetworkClient::ServerResolver> m_serverResolver;
+  struct SharedMemoryConfig {
+    std::string name;
+    size_t size;
+    unsigned int maxTopics;
+    bool worldReadable;
+  };
+  std::optional<SharedMemoryConfig> m_sharedMemory;
   std::optional<int64_t> m_serverTimeOffset;
   int64_t m_rtt2 = 0;
   int m_inst;
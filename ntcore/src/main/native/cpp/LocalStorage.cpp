@@ -4,6 +4,8 @@
 
 #include "LocalStorage.hpp"
 
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 using namespace wpi::nt;
@@ -66,8 +68,9 @@ void LocalStorage::Release(NT_Handle pubsubentryHandle) {
 }
 
 Value LocalStorage::GetEntryValue(NT_Handle subentryHandle) {
-  std::scoped_lock lock{m_mutex};
+  std::shared_lock lock{m_mutex};
   if (auto subscriber = m_impl.GetSubEntry(subentryHandle)) {
+    std::scoped_lock topicLock{subscriber->topic->valueMutex};
     if (subscriber->config.type == NT_UNASSIGNED ||
         !subscriber->topic->lastValue ||
         subscriber->config.type == subscriber->topic->lastValue.type()) {
@@ -6,7 +6,9 @@
 
 #include <stdint.h>
 
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string>
 #include <string_view>
@@ -19,7 +21,6 @@
 #include "wpi/util/Logger.hpp"
 #include "wpi/util/SmallVector.hpp"
 #include "wpi/util/json.hpp"
-#include "wpi/util/mutex.hpp"
 
 namespace wpi::util {
 class Logger;
@@ -61,8 +62,9 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   void ServerSetValue(int topicId, const Value& value) final {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.GetTopicById(topicId)) {
+      std::scoped_lock topicLock{topic->valueMutex};
       m_impl.ServerSetValue(topic, value);
     }
   }
@@ -329,10 +331,36 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   bool SetEntryValue(NT_Handle pubentryHandle, const Value& value) {
+    {
+      std::shared_lock lock{m_mutex};
+      if (auto publisher = m_impl.GetPubEntry(pubentryHandle)) {
+        std::scoped_lock topicLock{publisher->topic->valueMutex};
+        return m_impl.PublishLocalValue(publisher, value);
+      }
+    }
+    // first set on an entry creates its publisher
     std::scoped_lock lock{m_mutex};
     return m_impl.SetEntryValue(pubentryHandle, value);
   }
 
+  // Makes the value using the publisher's buffer pool, so setting fixed-size
+  // arrays doesn't allocate
+  template <ValidType T>
+  bool SetEntryValue(NT_Handle pubentryHandle,
+                     typename TypeInfo<T>::View value, int64_t time) {
+    {
+      std::shared_lock lock{m_mutex};
+      if (auto publisher = m_impl.GetPubEntry(pubentryHandle)) {
+        std::scoped_lock topicLock{publisher->topic->valueMutex};
+        return m_impl.PublishLocalValue(
+            publisher, publisher->bufferPool.MakeValue<T>(value, time));
+      }
+    }
+    // first set on an entry creates its publisher
+    std::scoped_lock lock{m_mutex};
+    return m_impl.SetEntryValue(pubentryHandle, MakeValue<T>(value, time));
+  }
+
   bool SetDefaultEntryValue(NT_Handle pubsubentryHandle, const Value& value) {
     std::scoped_lock lock{m_mutex};
     return m_impl.SetDefaultEntryValue(pubsubentryHandle, value);
@@ -341,13 +369,15 @@ class LocalStorage final : public net::ILocalStorage {
   template <ValidType T>
   Timestamped<typename TypeInfo<T>::Value> GetAtomic(
       NT_Handle subentry, typename TypeInfo<T>::View defaultValue) {
-    std::scoped_lock lock{m_mutex};
-    Value* value = m_impl.GetSubEntryValue(subentry);
-    if (value && (IsNumericConvertibleTo<T>(*value) || IsType<T>(*value))) {
-      return GetTimestamped<T, true>(*value);
-    } else {
-      return {0, 0, CopyValue<T>(defaultValue)};
+    std::shared_lock lock{m_mutex};
+    if (auto subscriber = m_impl.GetSubEntry(subentry)) {
+      std::scoped_lock topicLock{subscriber->topic->valueMutex};
+      const Value& value = subscriber->topic->lastValue;
+      if (value && (IsNumericConvertibleTo<T>(value) || IsType<T>(value))) {
+        return GetTimestamped<T, true>(value);
+      }
     }
+    return {0, 0, CopyValue<T>(defaultValue)};
   }
 
   template <SmallArrayType T>
@@ -355,32 +385,36 @@ class LocalStorage final : public net::ILocalStorage {
       NT_Handle subentry,
       wpi::util::SmallVectorImpl<typename TypeInfo<T>::SmallElem>& buf,
       typename TypeInfo<T>::View defaultValue) {
-    std::scoped_lock lock{m_mutex};
-    Value* value = m_impl.GetSubEntryValue(subentry);
-    if (value && (IsNumericConvertibleTo<T>(*value) || IsType<T>(*value))) {
-      return GetTimestamped<T, true>(*value, buf);
-    } else {
-      return {0, 0, CopyValue<T>(defaultValue, buf)};
+    std::shared_lock lock{m_mutex};
+    if (auto subscriber = m_impl.GetSubEntry(subentry)) {
+      std::scoped_lock topicLock{subscriber->topic->valueMutex};
+      const Value& value = subscriber->topic->lastValue;
+      if (value && (IsNumericConvertibleTo<T>(value) || IsType<T>(value))) {
+        return GetTimestamped<T, true>(value, buf);
+      }
     }
+    return {0, 0, CopyValue<T>(defaultValue, buf)};
   }
 
   std::vector<Value> ReadQueueValue(NT_Handle subentry, unsigned int types) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     auto subscriber = m_impl.GetSubEntry(subentry);
     if (!subscriber) {
       return {};
     }
+    std::scoped_lock topicLock{subscriber->topic->valueMutex};
     return subscriber->pollStorage.ReadValue(types);
   }
 
   template <ValidType T>
   std::vector<Timestamped<typename TypeInfo<T>::Value>> ReadQueue(
       NT_Handle subentry) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     auto subscriber = m_impl.GetSubEntry(subentry);
     if (!subscriber) {
       return {};
     }
+    std::scoped_lock topicLock{subscriber->topic->valueMutex};
     return subscriber->pollStorage.Read<T>();
   }
 
@@ -435,8 +469,9 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   int64_t GetEntryLastChange(NT_Entry subentryHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto subscriber = m_impl.GetSubEntry(subentryHandle)) {
+      std::scoped_lock topicLock{subscriber->topic->valueMutex};
       return subscriber->topic->lastValue.time();
     } else {
       return 0;
@@ -504,7 +539,10 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
  private:
-  wpi::util::mutex m_mutex;
+  // Value gets and sets hold this shared plus the topic's valueMutex, so
+  // operations on different topics don't contend.  Everything else (which may
+  // change topics, publishers, subscribers, or listeners) holds it exclusive.
+  std::shared_mutex m_mutex;
   local::StorageImpl m_impl;
 };
 
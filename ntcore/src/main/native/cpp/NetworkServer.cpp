@@ -262,6 +262,7 @@ NetworkServer::NetworkServer(std::string_view persistentFilename,
       m_logger{logger},
       m_initDone{std::move(initDone)},
       m_persistentFilename{persistentFilename},
+      m_persistentBinary{persistentFilename.ends_with(".msgpack")},
       m_listenAddress{wpi::util::trim(listenAddress)},
       m_mdnsService{wpi::util::trim(mdnsService)},
       m_port{port},
@@ -297,6 +298,15 @@ void NetworkServer::Flush() {
   }
 }
 
+void NetworkServer::StartSharedMemory(std::string_view name, size_t size,
+                                      unsigned int maxTopics,
+                                      bool worldReadable) {
+  m_loopRunner.ExecAsync([this, name = std::string{name}, size, maxTopics,
+                          worldReadable](uv::Loop&) {
+    m_serverImpl.StartSharedMemory(name, size, maxTopics, worldReadable);
+  });
+}
+
 void NetworkServer::ProcessAllLocal() {
   while (m_serverImpl.ProcessLocalMessages(128)) {
   }
@@ -329,9 +339,12 @@ void NetworkServer::LoadPersistent() {
     fs::copy_file(m_persistentFilename, m_persistentFilename + ".bak",
                   std::filesystem::copy_options::overwrite_existing, ec);
     // try to write an empty file so it doesn't happen again
-    wpi::util::raw_fd_ostream os{m_persistentFilename, ec, fs::F_Text};
+    wpi::util::raw_fd_ostream os{m_persistentFilename, ec,
+                                 m_persistentBinary ? fs::F_None : fs::F_Text};
     if (ec.value() == 0) {
-      os << "[]\n";
+      if (!m_persistentBinary) {
+        os << "[]\n";
+      }
       os.close();
     }
     return;
@@ -346,7 +359,8 @@ void NetworkServer::SavePersistent(std::string_view filename,
   // write to temporary file
   auto tmp = std::format("{}.tmp", filename);
   std::error_code ec;
-  wpi::util::raw_fd_ostream os{tmp, ec, fs::F_Text};
+  wpi::util::raw_fd_ostream os{tmp, ec,
+                               m_persistentBinary ? fs::F_None : fs::F_Text};
   if (ec.value() != 0) {
     INFO("could not open persistent file '{}' for write: {}", tmp,
          ec.message());
@@ -398,7 +412,8 @@ void NetworkServer::Init() {
         uv::QueueWork(
             m_loop,
             [this, fn = m_persistentFilename,
-             data = m_serverImpl.DumpPersistent()] {
+             data = m_persistentBinary ? m_serverImpl.DumpPersistentBinary()
+                                       : m_serverImpl.DumpPersistent()] {
               SavePersistent(fn, data);
             },
             nullptr);
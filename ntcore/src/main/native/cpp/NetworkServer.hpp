@@ -46,6 +46,9 @@ class NetworkServer {
   void FlushLocal();
   void Flush();
 
+  void StartSharedMemory(std::string_view name, size_t size,
+                         unsigned int maxTopics, bool worldReadable);
+
  private:
   class ServerConnection;
   class ServerConnection4;
@@ -63,6 +66,8 @@ class NetworkServer {
   std::function<void(bool)> m_initDone;
   std::string m_persistentData;
   std::string m_persistentFilename;
+  // save in the binary format rather than JSON
+  bool m_persistentBinary;
   std::string m_listenAddress;
   std::string m_mdnsService;
   unsigned int m_port;
@@ -0,0 +1,193 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace wpi::nt {
+
+// Radix tree from topic names and name prefixes to values (e.g. subscribers).
+// Finding the values matching a topic name takes time proportional to the
+// name length rather than to the number of keys, and finding the values under
+// every key starting with a prefix takes time proportional to the number of
+// matches.
+template <typename T>
+class PrefixTrie {
+ public:
+  // Adds a value. If prefix is true, the value matches any name starting with
+  // key; otherwise it only matches the name equal to key. The same value may
+  // be added under several keys.
+  void Add(std::string_view key, bool prefix, T value) {
+    Node* node = &m_root;
+    while (!key.empty()) {
+      auto it = node->FindChild(key.front());
+      if (it == node->children.end()) {
+        auto& child = node->children.emplace_back(std::make_unique<Node>());
+        child->edge = key;
+        node = child.get();
+        break;
+      }
+
+      // split the edge if the key diverges partway along it
+      auto& edge = (*it)->edge;
+      size_t common =
+          std::mismatch(edge.begin(), edge.end(), key.begin(), key.end())
+              .first -
+          edge.begin();
+      if (common < edge.size()) {
+        auto mid = std::make_unique<Node>();
+        mid->edge = edge.substr(0, common);
+        edge.erase(0, common);
+        mid->children.emplace_back(std::move(*it));
+        *it = std::move(mid);
+      }
+      key.remove_prefix(common);
+      node = it->get();
+    }
+    node->Values(prefix).emplace_back(std::move(value));
+  }
+
+  // Removes a value added with the same key and prefix flag. Returns true if
+  // the value was present.
+  bool Remove(std::string_view key, bool prefix, const T& value) {
+    return Remove(m_root, key, prefix, value);
+  }
+
+  // Calls func for each value matching the name. As with prefix subscriptions,
+  // values added with an empty prefix don't match special names. A value added
+  // under several matching keys is passed once for each.
+  template <std::invocable<const T&> F>
+  void ForEachMatch(std::string_view name, bool special, F&& func) const {
+    const Node* node = &m_root;
+    if (!special) {
+      ForEach(node->prefixValues, func);
+    }
+    while (!name.empty()) {
+      auto it = node->FindChild(name.front());
+      if (it == node->children.end() || !name.starts_with((*it)->edge)) {
+        return;
+      }
+      node = it->get();
+      name.remove_prefix(node->edge.size());
+      ForEach(node->prefixValues, func);
+    }
+    ForEach(node->exactValues, func);
+  }
+
+  // Calls func for each value added under a key starting with prefix.
+  template <std::invocable<const T&> F>
+  void ForEachStartingWith(std::string_view prefix, F&& func) const {
+    const Node* node = &m_root;
+    while (!prefix.empty()) {
+      auto it = node->FindChild(prefix.front());
+      if (it == node->children.end()) {
+        return;
+      }
+      const auto& edge = (*it)->edge;
+      if (prefix.starts_with(edge)) {
+        prefix.remove_prefix(edge.size());
+      } else if (std::string_view{edge}.starts_with(prefix)) {
+        prefix = {};
+      } else {
+        return;
+      }
+      node = it->get();
+    }
+    ForEachUnder(*node, func);
+  }
+
+  bool empty() const { return m_root.empty(); }
+
+  void clear() { m_root = Node{}; }
+
+ private:
+  struct Node {
+    using Children = std::vector<std::unique_ptr<Node>>;
+
+    // label of the edge from the parent; only empty for the root
+    std::string edge;
+    std::vector<T> prefixValues;
+    std::vector<T> exactValues;
+    Children children;
+
+    std::vector<T>& Values(bool prefix) {
+      return prefix ? prefixValues : exactValues;
+    }
+
+    // children always start with distinct characters
+    typename Children::iterator FindChild(char c) {
+      return std::find_if(children.begin(), children.end(),
+                          [&](auto& child) { return child->edge[0] == c; });
+    }
+    typename Children::const_iterator FindChild(char c) const {
+      return std::find_if(children.begin(), children.end(),
+                          [&](auto& child) { return child->edge[0] == c; });
+    }
+
+    bool empty() const {
+      return prefixValues.empty() && exactValues.empty() && children.empty();
+    }
+  };
+
+  static bool Remove(Node& node, std::string_view key, bool prefix,
+                     const T& value) {
+    if (key.empty()) {
+      auto& values = node.Values(prefix);
+      auto it = std::find(values.begin(), values.end(), value);
+      if (it == values.end()) {
+        return false;
+      }
+      values.erase(it);
+      return true;
+    }
+
+    auto it = node.FindChild(key.front());
+    if (it == node.children.end() || !key.starts_with((*it)->edge)) {
+      return false;
+    }
+    auto& child = **it;
+    if (!Remove(child, key.substr(child.edge.size()), prefix, value)) {
+      return false;
+    }
+
+    // prune the child if it's now empty, or merge it with its only child if
+    // it no longer has values of its own
+    if (child.empty()) {
+      node.children.erase(it);
+    } else if (child.prefixValues.empty() && child.exactValues.empty() &&
+               child.children.size() == 1) {
+      auto grandchild = std::move(child.children.front());
+      grandchild->edge.insert(0, child.edge);
+      *it = std::move(grandchild);
+    }
+    return true;
+  }
+
+  template <typename F>
+  static void ForEach(const std::vector<T>& values, F& func) {
+    for (auto&& value : values) {
+      func(value);
+    }
+  }
+
+  template <typename F>
+  static void ForEachUnder(const Node& node, F& func) {
+    ForEach(node.prefixValues, func);
+    ForEach(node.exactValues, func);
+    for (auto&& child : node.children) {
+      ForEachUnder(*child, func);
+    }
+  }
+
+  Node m_root;
+};
+
+}  // namespace wpi::nt
@@ -0,0 +1,55 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/nt/SharedMemoryReader.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "net/SharedMemory.hpp"
+
+using namespace wpi::nt;
+
+SharedMemoryReader::SharedMemoryReader(std::string_view name)
+    : m_reader{std::make_unique<net::shm::Reader>(name)} {}
+
+SharedMemoryReader::~SharedMemoryReader() = default;
+
+SharedMemoryReader::SharedMemoryReader(SharedMemoryReader&&) = default;
+
+SharedMemoryReader& SharedMemoryReader::operator=(SharedMemoryReader&&) =
+    default;
+
+bool SharedMemoryReader::IsValid() const {
+  return m_reader && m_reader->IsValid();
+}
+
+int SharedMemoryReader::GetNumTopics() const {
+  return m_reader ? m_reader->GetNumTopics() : 0;
+}
+
+int SharedMemoryReader::FindTopic(std::string_view name) const {
+  for (int i = 0, end = GetNumTopics(); i < end; ++i) {
+    if (m_reader->GetTopicName(i) == name) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+std::string_view SharedMemoryReader::GetTopicName(int index) const {
+  return m_reader ? m_reader->GetTopicName(index) : std::string_view{};
+}
+
+std::string SharedMemoryReader::GetTopicTypeString(int index) const {
+  return m_reader ? m_reader->GetTopicTypeString(index) : std::string{};
+}
+
+std::optional<Value> SharedMemoryReader::GetValue(int index) const {
+  if (!m_reader) {
+    return std::nullopt;
+  }
+  return m_reader->GetValue(index);
+}
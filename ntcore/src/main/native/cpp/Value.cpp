@@ -5,6 +5,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <concepts>
 #include <cstring>
 #include <memory>
 #include <numeric>
@@ -13,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "ValueBufferPool.hpp"
 #include "Value_internal.hpp"
 #include "wpi/nt/NetworkTableValue.hpp"
 #include "wpi/util/MemAlloc.hpp"
@@ -68,27 +70,79 @@ void StringArrayStorage::InitNtStrings() {
   }
 }
 
-Value Value::MakeBooleanArray(std::span<const bool> value, int64_t time) {
-  Value val{NT_BOOLEAN_ARRAY, value.size() * sizeof(int), time, private_init{}};
-  auto data = AllocateArray<int>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_boolean.arr = data.get();
-  val.m_val.data.arr_boolean.size = value.size();
-  val.m_storage = std::move(data);
+template <typename T, typename U>
+Value Value::MakeArray(std::span<const U> value, int64_t time,
+                       ValueBufferPool* pool) {
+  NT_Type type;
+  if constexpr (std::same_as<T, uint8_t>) {
+    type = NT_RAW;
+  } else if constexpr (std::same_as<T, int>) {
+    type = NT_BOOLEAN_ARRAY;
+  } else if constexpr (std::same_as<T, int64_t>) {
+    type = NT_INTEGER_ARRAY;
+  } else if constexpr (std::same_as<T, float>) {
+    type = NT_FLOAT_ARRAY;
+  } else {
+    static_assert(std::same_as<T, double>);
+    type = NT_DOUBLE_ARRAY;
+  }
+
+  T* arr;
+  size_t nbytes = value.size() * sizeof(T);
+  Value val{type, 0, time, private_init{}};
+  if (nbytes <= kInlineSize) {
+    arr = reinterpret_cast<T*>(val.m_inline);
+  } else {
+    auto data = pool ? pool->AllocateArray<T>(value.size())
+                     : AllocateArray<T>(value.size());
+    arr = data.get();
+    val.m_size = nbytes;
+    val.m_storage = std::move(data);
+  }
+  std::copy(value.begin(), value.end(), arr);
+
+  if constexpr (std::same_as<T, uint8_t>) {
+    val.m_val.data.v_raw.data = arr;
+    val.m_val.data.v_raw.size = value.size();
+  } else if constexpr (std::same_as<T, int>) {
+    val.m_val.data.arr_boolean.arr = arr;
+    val.m_val.data.arr_boolean.size = value.size();
+  } else if constexpr (std::same_as<T, int64_t>) {
+    val.m_val.data.arr_int.arr = arr;
+    val.m_val.data.arr_int.size = value.size();
+  } else if constexpr (std::same_as<T, float>) {
+    val.m_val.data.arr_float.arr = arr;
+    val.m_val.data.arr_float.size = value.size();
+  } else {
+    val.m_val.data.arr_double.arr = arr;
+    val.m_val.data.arr_double.size = value.size();
+  }
   return val;
 }
 
+template Value Value::MakeArray<uint8_t>(std::span<const uint8_t>, int64_t,
+                                         ValueBufferPool*);
+template Value Value::MakeArray<int>(std::span<const int>, int64_t,
+                                     ValueBufferPool*);
+template Value Value::MakeArray<int64_t>(std::span<const int64_t>, int64_t,
+                                         ValueBufferPool*);
+template Value Value::MakeArray<float>(std::span<const float>, int64_t,
+                                       ValueBufferPool*);
+template Value Value::MakeArray<double>(std::span<const double>, int64_t,
+                                        ValueBufferPool*);
+
+Value Value::MakeBooleanArray(std::span<const bool> value, int64_t time) {
+  return MakeArray<int>(value, time, nullptr);
+}
+
 Value Value::MakeBooleanArray(std::span<const int> value, int64_t time) {
-  Value val{NT_BOOLEAN_ARRAY, value.size() * sizeof(int), time, private_init{}};
-  auto data = AllocateArray<int>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_boolean.arr = data.get();
-  val.m_val.data.arr_boolean.size = value.size();
-  val.m_storage = std::move(data);
-  return val;
+  return MakeArray<int>(value, time, nullptr);
 }
 
 Value Value::MakeBooleanArray(std::vector<int>&& value, int64_t time) {
+  if (value.size() * sizeof(int) <= kInlineSize) {
+    return MakeArray<int>(std::span<const int>{value}, time, nullptr);
+  }
   Value val{NT_BOOLEAN_ARRAY, value.size() * sizeof(int), time, private_init{}};
   auto data = std::make_shared<std::vector<int>>(std::move(value));
   val.m_val.data.arr_boolean.arr = data->data();
@@ -98,17 +152,13 @@ Value Value::MakeBooleanArray(std::vector<int>&& value, int64_t time) {
 }
 
 Value Value::MakeIntegerArray(std::span<const int64_t> value, int64_t time) {
-  Value val{NT_INTEGER_ARRAY, value.size() * sizeof(int64_t), time,
-            private_init{}};
-  auto data = AllocateArray<int64_t>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_int.arr = data.get();
-  val.m_val.data.arr_int.size = value.size();
-  val.m_storage = std::move(data);
-  return val;
+  return MakeArray<int64_t>(value, time, nullptr);
 }
 
 Value Value::MakeIntegerArray(std::vector<int64_t>&& value, int64_t time) {
+  if (value.size() * sizeof(int64_t) <= kInlineSize) {
+    return MakeArray<int64_t>(std::span<const int64_t>{value}, time, nullptr);
+  }
   Value val{NT_INTEGER_ARRAY, value.size() * sizeof(int64_t), time,
             private_init{}};
   auto data = std::make_shared<std::vector<int64_t>>(std::move(value));
@@ -119,16 +169,13 @@ Value Value::MakeIntegerArray(std::vector<int64_t>&& value, int64_t time) {
 }
 
 Value Value::MakeFloatArray(std::span<const float> value, int64_t time) {
-  Value val{NT_FLOAT_ARRAY, value.size() * sizeof(float), time, private_init{}};
-  auto data = AllocateArray<float>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_float.arr = data.get();
-  val.m_val.data.arr_float.size = value.size();
-  val.m_storage = std::move(data);
-  return val;
+  return MakeArray<float>(value, time, nullptr);
 }
 
 Value Value::MakeFloatArray(std::vector<float>&& value, int64_t time) {
+  if (value.size() * sizeof(float) <= kInlineSize) {
+    return MakeArray<float>(std::span<const float>{value}, time, nullptr);
+  }
   Value val{NT_FLOAT_ARRAY, value.size() * sizeof(float), time, private_init{}};
   auto data = std::make_shared<std::vector<float>>(std::move(value));
   val.m_val.data.arr_float.arr = data->data();
@@ -138,17 +185,13 @@ Value Value::MakeFloatArray(std::vector<float>&& value, int64_t time) {
 }
 
 Value Value::MakeDoubleArray(std::span<const double> value, int64_t time) {
-  Value val{NT_DOUBLE_ARRAY, value.size() * sizeof(double), time,
-            private_init{}};
-  auto data = AllocateArray<double>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_double.arr = data.get();
-  val.m_val.data.arr_double.size = value.size();
-  val.m_storage = std::move(data);
-  return val;
+  return MakeArray<double>(value, time, nullptr);
 }
 
 Value Value::MakeDoubleArray(std::vector<double>&& value, int64_t time) {
+  if (value.size() * sizeof(double) <= kInlineSize) {
+    return MakeArray<double>(std::span<const double>{value}, time, nullptr);
+  }
   Value val{NT_DOUBLE_ARRAY, value.size() * sizeof(double), time,
             private_init{}};
   auto data = std::make_shared<std::vector<double>>(std::move(value));
@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ValueBufferPool.hpp"
+
+#include <mutex>
+#include <new>
+
+using namespace wpi::nt;
+
+ValueBufferPool::State::~State() {
+  for (void* ptr : free) {
+    ::operator delete(ptr);
+  }
+}
+
+void* ValueBufferPool::State::Allocate(size_t size) {
+  {
+    std::scoped_lock lock{mutex};
+    if (size == blockSize) {
+      if (!free.empty()) {
+        void* ptr = free.back();
+        free.pop_back();
+        return ptr;
+      }
+    } else {
+      // the array size changed; drop the buffers of the old size
+      for (void* ptr : free) {
+        ::operator delete(ptr);
+      }
+      free.clear();
+      blockSize = size;
+    }
+  }
+  return ::operator new(size);
+}
+
+void ValueBufferPool::State::Deallocate(void* ptr, size_t size) {
+  {
+    std::scoped_lock lock{mutex};
+    if (size == blockSize && free.size() < kMaxFree) {
+      free.push_back(ptr);
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
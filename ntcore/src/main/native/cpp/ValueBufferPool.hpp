@@ -0,0 +1,103 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Value_internal.hpp"
+#include "wpi/nt/NetworkTableValue.hpp"
+#include "wpi/util/mutex.hpp"
+
+namespace wpi::nt {
+
+// Recycles the storage of raw and numeric array values too large to be stored
+// inline, so repeatedly making values of the same size (e.g. a publisher
+// setting a fixed-size array) doesn't allocate once a few buffers are in
+// circulation. Storage goes back to the pool when the last value using it is
+// destroyed, which may be on another thread or after the pool is destroyed.
+class ValueBufferPool {
+ public:
+  template <ValidType T>
+  Value MakeValue(typename TypeInfo<T>::View value, int64_t time) {
+    if constexpr (NumericArrayType<T> || IsNTType<T, NT_BOOLEAN_ARRAY> ||
+                  IsNTType<T, NT_RAW>) {
+      return Value::MakeArray<std::remove_const_t<
+          typename TypeInfo<T>::View::element_type>>(value, time, this);
+    } else {
+      return wpi::nt::MakeValue<T>(value, time);
+    }
+  }
+
+  template <typename T>
+  std::shared_ptr<T[]> AllocateArray(size_t nelem) {
+    if (!m_state) {
+      m_state = std::make_shared<State>();
+    }
+#if __cpp_lib_shared_ptr_arrays >= 201707L
+#if __cpp_lib_smart_ptr_for_overwrite >= 202002L
+    return std::allocate_shared_for_overwrite<T[]>(Allocator<T>{m_state},
+                                                   nelem);
+#else
+    return std::allocate_shared<T[]>(Allocator<T>{m_state}, nelem);
+#endif
+#else
+    return std::shared_ptr<T[]>{new T[nelem]};
+#endif
+  }
+
+ private:
+  // maximum number of free buffers kept
+  static constexpr size_t kMaxFree = 8;
+
+  // Shared with the allocator stored alongside each buffer
+  struct State {
+    State() { free.reserve(kMaxFree); }
+    ~State();
+    State(const State&) = delete;
+    State& operator=(const State&) = delete;
+
+    void* Allocate(size_t size);
+    void Deallocate(void* ptr, size_t size);
+
+    wpi::util::mutex mutex;
+    // only buffers of the most recently allocated size are kept
+    size_t blockSize = 0;
+    std::vector<void*> free;
+  };
+
+  template <typename T>
+  struct Allocator {
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<State> state)
+        : state{std::move(state)} {}
+    template <typename U>
+    Allocator(const Allocator<U>& other)  // NOLINT
+        : state{other.state} {}
+
+    T* allocate(size_t n) {
+      return static_cast<T*>(state->Allocate(n * sizeof(T)));
+    }
+    void deallocate(T* ptr, size_t n) {
+      state->Deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return state == other.state;
+    }
+
+    std::shared_ptr<State> state;
+  };
+
+  std::shared_ptr<State> m_state;
+};
+
+}  // namespace wpi::nt
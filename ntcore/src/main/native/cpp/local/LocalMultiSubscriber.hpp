@@ -53,6 +53,9 @@ struct LocalMultiSubscriber {
 
   // value listeners
   VectorSet<NT_Listener> valueListeners;
+
+  // topic listeners
+  VectorSet<NT_Listener> topicListeners;
 };
 
 }  // namespace wpi::nt::local
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "Handle.hpp"
+#include "ValueBufferPool.hpp"
 #include "local/LocalTopic.hpp"
 #include "local/PubSubConfig.hpp"
 #include "wpi/util/Synchronization.h"
@@ -30,6 +31,9 @@ struct LocalPublisher {
 
   // whether or not the publisher should actually publish values
   bool active{false};
+
+  // recycled storage for set values; protected by the topic value mutex
+  ValueBufferPool bufferPool;
 };
 
 }  // namespace wpi::nt::local
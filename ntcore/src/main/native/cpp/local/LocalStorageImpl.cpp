@@ -4,6 +4,7 @@
 
 #include "LocalStorageImpl.hpp"
 
+#include <algorithm>
 #include <format>
 #include <memory>
 #include <string>
@@ -169,16 +170,38 @@ LocalTopic* StorageImpl::GetOrCreateTopic(std::string_view name) {
   // create if it does not already exist
   if (!topic) {
     topic = m_topics.Add(m_inst, name);
-    // attach multi-subscribers
-    for (auto&& sub : m_multiSubscribers) {
-      if (sub->Matches(name, topic->special)) {
-        topic->multiSubscribers.Add(sub.get());
-      }
-    }
+    m_topicIndex.Add(name, false, topic);
+    // attach multi-subscribers; a subscriber may match more than one of its
+    // prefixes
+    m_multiSubscriberIndex.ForEachMatch(
+        name, topic->special, [&](LocalMultiSubscriber* sub) {
+          if (std::find(topic->multiSubscribers.begin(),
+                        topic->multiSubscribers.end(),
+                        sub) == topic->multiSubscribers.end()) {
+            topic->multiSubscribers.Add(sub);
+          }
+        });
   }
   return topic;
 }
 
+std::vector<LocalTopic*> StorageImpl::FindTopics(
+    LocalMultiSubscriber* subscriber) const {
+  std::vector<LocalTopic*> topics;
+  for (auto&& prefix : subscriber->prefixes) {
+    m_topicIndex.ForEachStartingWith(prefix, [&](LocalTopic* topic) {
+      if (PrefixMatch(topic->name, prefix, topic->special)) {
+        topics.emplace_back(topic);
+      }
+    });
+  }
+  std::sort(topics.begin(), topics.end(), [](auto a, auto b) {
+    return Handle{a->handle}.GetIndex() < Handle{b->handle}.GetIndex();
+  });
+  topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+  return topics;
+}
+
 //
 // Topic property functions
 //
@@ -432,14 +455,12 @@ LocalMultiSubscriber* StorageImpl::AddMultiSubscriber(
     return nullptr;
   }
   auto subscriber = m_multiSubscribers.Add(m_inst, prefixes, options);
+  for (auto&& prefix : prefixes) {
+    m_multiSubscriberIndex.Add(prefix, true, subscriber);
+  }
   // subscribe to any already existing topics
-  for (auto&& topic : m_topics) {
-    for (auto&& prefix : prefixes) {
-      if (PrefixMatch(topic->name, prefix, topic->special)) {
-        topic->multiSubscribers.Add(subscriber);
-        break;
-      }
-    }
+  for (auto topic : FindTopics(subscriber)) {
+    topic->multiSubscribers.Add(subscriber);
   }
   if (m_network && !subscriber->options.hidden) {
     DEBUG4("-> NetworkSubscribe");
@@ -453,7 +474,10 @@ std::unique_ptr<LocalMultiSubscriber> StorageImpl::RemoveMultiSubscriber(
     NT_MultiSubscriber subHandle) {
   auto subscriber = m_multiSubscribers.Remove(subHandle);
   if (subscriber) {
-    for (auto&& topic : m_topics) {
+    for (auto&& prefix : subscriber->prefixes) {
+      m_multiSubscriberIndex.Remove(prefix, true, subscriber.get());
+    }
+    for (auto topic : FindTopics(subscriber.get())) {
       topic->multiSubscribers.Remove(subscriber.get());
     }
     for (auto&& listener : m_listeners) {
@@ -606,9 +630,9 @@ void StorageImpl::AddListenerImpl(NT_Listener listenerHandle,
   wpi::util::SmallVector<LocalTopic*, 32> topics;
   if ((eventMask & NT_EVENT_IMMEDIATE) != 0 &&
       (eventMask & (NT_EVENT_PUBLISH | NT_EVENT_VALUE_ALL)) != 0) {
-    for (auto&& topic : m_topics) {
-      if (topic->Exists() && subscriber->Matches(topic->name, topic->special)) {
-        topics.emplace_back(topic.get());
+    for (auto topic : FindTopics(subscriber)) {
+      if (topic->Exists()) {
+        topics.emplace_back(topic);
       }
     }
   }
@@ -623,6 +647,7 @@ void StorageImpl::AddListenerImpl(NT_Listener listenerHandle,
         listenerHandle, eventMask & (NT_EVENT_TOPIC | NT_EVENT_IMMEDIATE));
 
     m_topicPrefixListeners.Add(listener);
+    subscriber->topicListeners.Add(listenerHandle);
 
     // handle immediate publish
     if ((eventMask & (NT_EVENT_PUBLISH | NT_EVENT_IMMEDIATE)) ==
@@ -693,6 +718,7 @@ void StorageImpl::RemoveListener(NT_Listener listenerHandle,
   }
   if (listener->multiSubscriber) {
     listener->multiSubscriber->valueListeners.Remove(listenerHandle);
+    listener->multiSubscriber->topicListeners.Remove(listenerHandle);
     if (listener->subscriberOwned) {
       RemoveMultiSubscriber(listener->multiSubscriber->handle);
     }
@@ -780,6 +806,8 @@ void StorageImpl::Reset() {
   m_multiSubscribers.clear();
   m_dataloggers.clear();
   m_nameTopics.clear();
+  m_topicIndex.clear();
+  m_multiSubscriberIndex.clear();
   m_listeners.clear();
   m_topicPrefixListeners.clear();
 }
@@ -791,12 +819,11 @@ void StorageImpl::NotifyTopic(LocalTopic* topic, unsigned int eventFlags) {
     m_listenerStorage.Notify(topic->listeners, eventFlags, topicInfo);
   }
 
+  // topic listeners are only on multi-subscribers, and the topic already
+  // tracks which of those match it
   wpi::util::SmallVector<NT_Listener, 32> listeners;
-  for (auto listener : m_topicPrefixListeners) {
-    if (listener->multiSubscriber &&
-        listener->multiSubscriber->Matches(topic->name, topic->special)) {
-      listeners.emplace_back(listener->handle);
-    }
+  for (auto sub : topic->multiSubscribers) {
+    listeners.append(sub->topicListeners.begin(), sub->topicListeners.end());
   }
   if (!listeners.empty()) {
     m_listenerStorage.Notify(listeners, eventFlags, topicInfo);
@@ -7,8 +7,10 @@
 #include <concepts>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 #include "HandleMap.hpp"
+#include "PrefixTrie.hpp"
 #include "local/LocalDataLogger.hpp"
 #include "local/LocalEntry.hpp"
 #include "local/LocalListener.hpp"
@@ -141,13 +143,10 @@ class StorageImpl {
   bool SetEntryValue(NT_Handle pubentryHandle, const Value& value);
   bool SetDefaultEntryValue(NT_Handle pubsubentryHandle, const Value& value);
 
-  Value* GetSubEntryValue(NT_Handle subentryHandle) {
-    if (auto subscriber = GetSubEntry(subentryHandle)) {
-      return &subscriber->topic->lastValue;
-    } else {
-      return nullptr;
-    }
-  }
+  // Only accesses the publisher's topic, so may be called with shared access
+  // while holding the topic's valueMutex.
+  bool PublishLocalValue(LocalPublisher* publisher, const Value& value,
+                         bool force = false);
 
   //
   // Publish/Subscribe/Entry functions
@@ -201,6 +200,17 @@ class StorageImpl {
 
   LocalSubscriber* GetSubEntry(NT_Handle subentryHandle);
 
+  // does not create a publisher for entries that have not been published
+  LocalPublisher* GetPubEntry(NT_Handle pubentryHandle) {
+    if (auto publisher = m_publishers.Get(pubentryHandle)) {
+      return publisher;
+    } else if (auto entry = m_entries.Get(pubentryHandle)) {
+      return entry->publisher;
+    } else {
+      return nullptr;
+    }
+  }
+
   LocalEntry* GetEntryByHandle(NT_Entry entryHandle) {
     return m_entries.Get(entryHandle);
   }
@@ -289,10 +299,10 @@ class StorageImpl {
 
   LocalPublisher* PublishEntry(LocalEntry* entry, NT_Type type);
 
-  bool PublishLocalValue(LocalPublisher* publisher, const Value& value,
-                         bool force = false);
-
  private:
+  // Gets the topics matching a multi-subscriber, in handle order
+  std::vector<LocalTopic*> FindTopics(LocalMultiSubscriber* subscriber) const;
+
   int m_inst;
   IListenerStorage& m_listenerStorage;
   wpi::util::Logger& m_logger;
@@ -308,6 +318,8 @@ class StorageImpl {
 
   // name mappings
   wpi::util::StringMap<LocalTopic*> m_nameTopics;
+  PrefixTrie<LocalTopic*> m_topicIndex;
+  PrefixTrie<LocalMultiSubscriber*> m_multiSubscriberIndex;
 
   // listeners
   wpi::util::DenseMap<NT_Listener, std::unique_ptr<LocalListener>> m_listeners;
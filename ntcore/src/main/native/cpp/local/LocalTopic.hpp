@@ -17,6 +17,7 @@
 #include "wpi/util/SmallVector.hpp"
 #include "wpi/util/Synchronization.h"
 #include "wpi/util/json.hpp"
+#include "wpi/util/mutex.hpp"
 
 namespace wpi::nt::local {
 
@@ -81,6 +82,11 @@ struct LocalTopic {
   std::string name;
   bool special;
 
+  // Protects the value state (lastValue, lastValueNetwork, type,
+  // lastValueFromNetwork, and subscriber poll storage) when the storage is
+  // only locked for shared access.  Not needed with exclusive access.
+  wpi::util::mutex valueMutex;
+
   Value lastValue;  // also stores timestamp
   Value lastValueNetwork;
   NT_Type type{NT_UNASSIGNED};
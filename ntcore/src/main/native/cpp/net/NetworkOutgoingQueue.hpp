@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <memory>
 #include <numeric>
 #include <span>
 #include <utility>
@@ -63,6 +64,32 @@ concept NetworkMessage =
 
 enum class ValueSendMode { kDisabled = 0, kAll, kNormal, kImm };
 
+// Binary encoding of a server value message, made on first use and shared by
+// the outgoing queues of all the clients the value is sent to. The server
+// sends the same topic ID and timestamp to every client, so a value is only
+// encoded once no matter how many clients are subscribed to it.
+class SharedValueEncoding {
+ public:
+  SharedValueEncoding(int id, const Value& value) : m_id{id}, m_value{value} {}
+  SharedValueEncoding(const SharedValueEncoding&) = delete;
+  SharedValueEncoding& operator=(const SharedValueEncoding&) = delete;
+
+  const std::shared_ptr<const std::vector<uint8_t>>& Get() {
+    if (!m_encoded) {
+      auto encoded = std::make_shared<std::vector<uint8_t>>();
+      wpi::util::raw_uvector_ostream os{*encoded};
+      WireEncodeBinary(os, m_id, m_value.time(), m_value);
+      m_encoded = std::move(encoded);
+    }
+    return m_encoded;
+  }
+
+ private:
+  int m_id;
+  const Value& m_value;
+  std::shared_ptr<const std::vector<uint8_t>> m_encoded;
+};
+
 template <NetworkMessage MessageType>
 class NetworkOutgoingQueue {
  public:
@@ -136,56 +163,17 @@ class NetworkOutgoingQueue {
   }
 
   void SendValue(int id, const Value& value, ValueSendMode mode) {
-    if (m_local) {
-      mode = ValueSendMode::kImm;  // always send local immediately
-    }
-    // backpressure by stopping sending all if the buffer is too full
-    if (mode == ValueSendMode::kAll && m_totalSize >= kOutgoingLimit) {
-      mode = ValueSendMode::kNormal;
-    }
-    switch (mode) {
-      case ValueSendMode::kDisabled:  // do nothing
-        break;
-      case ValueSendMode::kImm:  // send immediately
-        m_wire.SendBinary([&](auto& os) { EncodeValue(os, id, value); });
-        break;
-      case ValueSendMode::kAll: {  // append to outgoing
-        auto& info = m_idMap[id];
-        auto& queue = m_queues[info.queueIndex];
-        info.valuePos = queue.msgs.size();
-        queue.Append(id, ValueMsg{id, value});
-        m_totalSize += sizeof(Message) + value.size();
-        break;
-      }
-      case ValueSendMode::kNormal: {
-        // replace, or append if not present
-        auto& info = m_idMap[id];
-        auto& queue = m_queues[info.queueIndex];
-        if (info.valuePos != -1 &&
-            static_cast<unsigned int>(info.valuePos) < queue.msgs.size()) {
-          auto& elem = queue.msgs[info.valuePos];
-          if (auto m = std::get_if<ValueMsg>(&elem.msg.contents)) {
-            // double-check handle, and only replace if timestamp newer
-            if (elem.id == id) {
-              if (m->value.time() == 0 || value.time() >= m->value.time()) {
-                m->value = value;
-                m_totalSize += static_cast<int64_t>(value.size()) -
-                               static_cast<int64_t>(m->value.size());
-              }
-              return;
-            }
-          }
-        }
-        info.valuePos = queue.msgs.size();
-        queue.Append(id, ValueMsg{id, value});
-        m_totalSize += sizeof(Message) + value.size();
-        break;
-      }
-    }
-    if (m_local) {
-      // local connections should never have outgoing messages queued
-      assert(m_totalSize == 0);
-    }
+    SendValueImpl(id, value, mode, {});
+  }
+
+  // If encoded is set, it's sent instead of encoding the value; it must be
+  // the encoding of the same id and value (see SharedValueEncoding). Only
+  // server queues have this overload, as clients adjust the timestamp.
+  void SendValue(int id, const Value& value, ValueSendMode mode,
+                 std::shared_ptr<const std::vector<uint8_t>> encoded)
+    requires std::same_as<typename MessageType::ValueMsg, ServerValueMsg>
+  {
+    SendValueImpl(id, value, mode, std::move(encoded));
   }
 
   void SendOutgoing(uint64_t curTimeMs, bool flush) {
@@ -235,8 +223,9 @@ class NetworkOutgoingQueue {
       int unsent = 0;
       for (; it != end && unsent == 0; ++it) {
         if (auto m = std::get_if<ValueMsg>(&it->msg.contents)) {
-          unsent = m_wire.WriteBinary(
-              [&](auto& os) { EncodeValue(os, it->id, m->value); });
+          unsent = m_wire.WriteBinary([&](auto& os) {
+            EncodeValue(os, it->id, m->value, it->encoded.get());
+          });
         } else {
           unsent = m_wire.WriteText([&](auto& os) {
             if (!WireEncodeText(os, it->msg)) {
@@ -296,7 +285,68 @@ class NetworkOutgoingQueue {
  private:
   using ValueMsg = typename MessageType::ValueMsg;
 
-  void EncodeValue(wpi::util::raw_ostream& os, int id, const Value& value) {
+  void SendValueImpl(int id, const Value& value, ValueSendMode mode,
+                     std::shared_ptr<const std::vector<uint8_t>> encoded) {
+    if (m_local) {
+      mode = ValueSendMode::kImm;  // always send local immediately
+    }
+    // backpressure by stopping sending all if the buffer is too full
+    if (mode == ValueSendMode::kAll && m_totalSize >= kOutgoingLimit) {
+      mode = ValueSendMode::kNormal;
+    }
+    switch (mode) {
+      case ValueSendMode::kDisabled:  // do nothing
+        break;
+      case ValueSendMode::kImm:  // send immediately
+        m_wire.SendBinary(
+            [&](auto& os) { EncodeValue(os, id, value, encoded.get()); });
+        break;
+      case ValueSendMode::kAll: {  // append to outgoing
+        auto& info = m_idMap[id];
+        auto& queue = m_queues[info.queueIndex];
+        info.valuePos = queue.msgs.size();
+        queue.Append(id, ValueMsg{id, value}, std::move(encoded));
+        m_totalSize += sizeof(Message) + value.size();
+        break;
+      }
+      case ValueSendMode::kNormal: {
+        // replace, or append if not present
+        auto& info = m_idMap[id];
+        auto& queue = m_queues[info.queueIndex];
+        if (info.valuePos != -1 &&
+            static_cast<unsigned int>(info.valuePos) < queue.msgs.size()) {
+          auto& elem = queue.msgs[info.valuePos];
+          if (auto m = std::get_if<ValueMsg>(&elem.msg.contents)) {
+            // double-check handle, and only replace if timestamp newer
+            if (elem.id == id) {
+              if (m->value.time() == 0 || value.time() >= m->value.time()) {
+                m->value = value;
+                elem.encoded = std::move(encoded);
+                m_totalSize += static_cast<int64_t>(value.size()) -
+                               static_cast<int64_t>(m->value.size());
+              }
+              return;
+            }
+          }
+        }
+        info.valuePos = queue.msgs.size();
+        queue.Append(id, ValueMsg{id, value}, std::move(encoded));
+        m_totalSize += sizeof(Message) + value.size();
+        break;
+      }
+    }
+    if (m_local) {
+      // local connections should never have outgoing messages queued
+      assert(m_totalSize == 0);
+    }
+  }
+
+  void EncodeValue(wpi::util::raw_ostream& os, int id, const Value& value,
+                   const std::vector<uint8_t>* encoded) {
+    if (encoded) {
+      os << std::span{*encoded};
+      return;
+    }
     int64_t time = value.time();
     if constexpr (std::same_as<ValueMsg, ClientValueMsg>) {
       if (time != 0) {
@@ -313,17 +363,22 @@ class NetworkOutgoingQueue {
   struct Message {
     Message() = default;
     template <typename T>
-    Message(T&& msg, int id) : msg{std::forward<T>(msg)}, id{id} {}
+    Message(T&& msg, int id,
+            std::shared_ptr<const std::vector<uint8_t>> encoded = {})
+        : msg{std::forward<T>(msg)}, id{id}, encoded{std::move(encoded)} {}
 
     MessageType msg;
     int id;
+    // pre-encoded value message, if shared with other queues
+    std::shared_ptr<const std::vector<uint8_t>> encoded;
   };
 
   struct Queue {
     explicit Queue(uint32_t periodMs) : periodMs{periodMs} {}
     template <typename T>
-    void Append(NT_Handle handle, T&& msg) {
-      msgs.emplace_back(std::forward<T>(msg), handle);
+    void Append(NT_Handle handle, T&& msg,
+                std::shared_ptr<const std::vector<uint8_t>> encoded = {}) {
+      msgs.emplace_back(std::forward<T>(msg), handle, std::move(encoded));
     }
     std::vector<Message> msgs;
     uint64_t nextSendMs = 0;
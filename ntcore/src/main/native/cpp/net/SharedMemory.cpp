@@ -0,0 +1,500 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SharedMemory.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace wpi::nt::net::shm;
+
+// number of times a reader retries a slot that is being written
+static constexpr int kMaxReadTries = 100;
+
+static std::string GetShmName(std::string_view name) {
+  if (name.starts_with('/')) {
+    return std::string{name};
+  }
+  std::string rv{"/"};
+  rv += name;
+  return rv;
+}
+
+template <typename T>
+static std::span<const uint8_t> AsBytes(std::span<const T> arr) {
+  return {reinterpret_cast<const uint8_t*>(arr.data()), arr.size_bytes()};
+}
+
+template <typename T>
+static std::vector<T> FromBytes(std::span<const uint8_t> data) {
+  std::vector<T> arr(data.size() / sizeof(T));
+  std::memcpy(arr.data(), data.data(), arr.size() * sizeof(T));
+  return arr;
+}
+
+static std::optional<wpi::nt::Value> Decode(NT_Type type, uint64_t scalar,
+                                            std::span<const uint8_t> data,
+                                            int64_t time) {
+  using wpi::nt::Value;
+  switch (type) {
+    case NT_BOOLEAN:
+      return Value::MakeBoolean(scalar != 0, time);
+    case NT_INTEGER:
+      return Value::MakeInteger(std::bit_cast<int64_t>(scalar), time);
+    case NT_FLOAT:
+      return Value::MakeFloat(
+          std::bit_cast<float>(static_cast<uint32_t>(scalar)), time);
+    case NT_DOUBLE:
+      return Value::MakeDouble(std::bit_cast<double>(scalar), time);
+    case NT_STRING:
+      return Value::MakeString(
+          std::string_view{reinterpret_cast<const char*>(data.data()),
+                           data.size()},
+          time);
+    case NT_RAW:
+      return Value::MakeRaw(data, time);
+    case NT_BOOLEAN_ARRAY:
+      return Value::MakeBooleanArray(FromBytes<int>(data), time);
+    case NT_INTEGER_ARRAY:
+      return Value::MakeIntegerArray(FromBytes<int64_t>(data), time);
+    case NT_FLOAT_ARRAY:
+      return Value::MakeFloatArray(FromBytes<float>(data), time);
+    case NT_DOUBLE_ARRAY:
+      return Value::MakeDoubleArray(FromBytes<double>(data), time);
+    case NT_STRING_ARRAY: {
+      std::vector<std::string> arr;
+      while (!data.empty()) {
+        uint32_t len;
+        if (data.size() < sizeof(len)) {
+          return std::nullopt;
+        }
+        std::memcpy(&len, data.data(), sizeof(len));
+        data = data.subspan(sizeof(len));
+        if (data.size() < len) {
+          return std::nullopt;
+        }
+        arr.emplace_back(reinterpret_cast<const char*>(data.data()), len);
+        data = data.subspan(len);
+      }
+      return Value::MakeStringArray(std::move(arr), time);
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+#ifndef _WIN32
+
+// Returns true if an existing segment was provably left behind by a writer
+// that no longer exists.  Segments that can't be checked (e.g. from another
+// version, or still being initialized) are never considered stale.
+static bool IsStale(const std::string& name) {
+  int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    // removed in the meantime
+    return errno == ENOENT;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<uint64_t>(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    return false;
+  }
+  std::error_code ec;
+  wpi::util::MappedFileRegion region{
+      fd, sizeof(Header), 0, wpi::util::MappedFileRegion::MapMode::READ_ONLY,
+      ec};
+  ::close(fd);
+  if (ec || !region) {
+    return false;
+  }
+  auto header = reinterpret_cast<const Header*>(region.const_data());
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || header->ownerPid == 0) {
+    return false;
+  }
+  return ::kill(static_cast<pid_t>(header->ownerPid), 0) != 0 &&
+         errno == ESRCH;
+}
+
+std::unique_ptr<Writer> Writer::Create(std::string_view name, size_t size,
+                                       uint32_t maxTopics, bool worldReadable,
+                                       std::error_code& ec) {
+  uint64_t heapOffset =
+      sizeof(Header) + static_cast<uint64_t>(maxTopics) * sizeof(Slot);
+  if (maxTopics == 0 || size <= heapOffset) {
+    ec = std::make_error_code(std::errc::invalid_argument);
+    return nullptr;
+  }
+
+  std::unique_ptr<Writer> writer{new Writer};
+  writer->m_name = GetShmName(name);
+
+  mode_t mode = worldReadable ? 0644 : 0600;
+  int fd = ::shm_open(writer->m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+  if (fd < 0 && errno == EEXIST && IsStale(writer->m_name)) {
+    // left behind by a server that exited without removing it
+    ::shm_unlink(writer->m_name.c_str());
+    fd = ::shm_open(writer->m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+  }
+  if (fd < 0) {
+    ec = std::error_code{errno, std::generic_category()};
+    return nullptr;
+  }
+  if (::ftruncate(fd, size) != 0) {
+    ec = std::error_code{errno, std::generic_category()};
+    ::close(fd);
+    ::shm_unlink(writer->m_name.c_str());
+    return nullptr;
+  }
+  writer->m_region = wpi::util::MappedFileRegion{
+      fd, size, 0, wpi::util::MappedFileRegion::MapMode::READ_WRITE, ec};
+  ::close(fd);
+  if (ec) {
+    ::shm_unlink(writer->m_name.c_str());
+    return nullptr;
+  }
+
+  // the new segment is zero filled
+  uint8_t* base = writer->m_region.data();
+  auto header = new (base) Header{};
+  for (uint32_t i = 0; i < maxTopics; ++i) {
+    new (base + sizeof(Header) + i * sizeof(Slot)) Slot{};
+  }
+  header->version = kVersion;
+  header->maxTopics = maxTopics;
+  header->size = size;
+  header->heapOffset = heapOffset;
+  header->ownerPid = static_cast<uint32_t>(::getpid());
+  std::memcpy(header->magic, kMagic, sizeof(kMagic));
+  std::atomic_thread_fence(std::memory_order_release);
+  writer->m_header = header;
+  return writer;
+}
+
+Writer::~Writer() {
+  if (m_header) {
+    m_header->closed.store(1, std::memory_order_release);
+    ::shm_unlink(m_name.c_str());
+  }
+}
+
+Reader::Reader(std::string_view name) {
+  std::string shmName = GetShmName(name);
+  int fd = ::shm_open(shmName.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<uint64_t>(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    return;
+  }
+  std::error_code ec;
+  m_region = wpi::util::MappedFileRegion{
+      fd, static_cast<uint64_t>(st.st_size), 0,
+      wpi::util::MappedFileRegion::MapMode::READ_ONLY, ec};
+  ::close(fd);
+  if (ec || !m_region) {
+    return;
+  }
+
+  // validate header
+  auto header = reinterpret_cast<const Header*>(m_region.const_data());
+  uint64_t slotsEnd =
+      sizeof(Header) + static_cast<uint64_t>(header->maxTopics) * sizeof(Slot);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || header->size > m_region.size() ||
+      header->heapOffset < slotsEnd || header->heapOffset > header->size) {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  m_header = header;
+}
+
+#else
+
+std::unique_ptr<Writer> Writer::Create(std::string_view, size_t, uint32_t,
+                                       bool, std::error_code& ec) {
+  ec = std::make_error_code(std::errc::not_supported);
+  return nullptr;
+}
+
+Writer::~Writer() = default;
+
+Reader::Reader(std::string_view) {}
+
+#endif
+
+Slot& Writer::GetSlot(int index) {
+  return *reinterpret_cast<Slot*>(m_region.data() + sizeof(Header) +
+                                  index * sizeof(Slot));
+}
+
+uint64_t Writer::Allocate(size_t size) {
+  // keep blocks 8-byte aligned so array elements are aligned
+  uint64_t offset = m_header->heapOffset + m_heapUsed;
+  uint64_t end = offset + ((size + 7) & ~static_cast<uint64_t>(7));
+  if (end > m_header->size) {
+    return 0;
+  }
+  m_heapUsed = end - m_header->heapOffset;
+  return offset;
+}
+
+int Writer::Announce(std::string_view name, std::string_view typeStr) {
+  auto [it, isNew] = m_slots.try_emplace(name, -1);
+  int index = it->second;
+  if (isNew) {
+    uint32_t numTopics = m_header->numTopics.load(std::memory_order_relaxed);
+    uint64_t nameOffset = 0;
+    if (numTopics < m_header->maxTopics) {
+      nameOffset = Allocate(name.size());
+    }
+    if (nameOffset == 0) {
+      m_slots.erase(it);
+      return -1;
+    }
+    std::memcpy(m_region.data() + nameOffset, name.data(), name.size());
+    index = numTopics;
+    Slot& slot = GetSlot(index);
+    slot.nameOffset = nameOffset;
+    slot.nameLen = name.size();
+    it->second = index;
+    m_capacity.emplace_back(0);
+    // publish the slot
+    m_header->numTopics.store(numTopics + 1, std::memory_order_release);
+  }
+
+  // type strings rarely change, so only store a new one if it's different
+  Slot& slot = GetSlot(index);
+  uint32_t typeStrLen = slot.typeStrLen.load(std::memory_order_relaxed);
+  uint64_t typeStrOffset = slot.typeStrOffset.load(std::memory_order_relaxed);
+  if (typeStrLen != typeStr.size() ||
+      std::memcmp(m_region.data() + typeStrOffset, typeStr.data(),
+                  typeStrLen) != 0) {
+    typeStrOffset = Allocate(typeStr.size());
+    if (typeStrOffset == 0) {
+      return -1;
+    }
+    std::memcpy(m_region.data() + typeStrOffset, typeStr.data(),
+                typeStr.size());
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.typeStrOffset.store(typeStrOffset, std::memory_order_relaxed);
+    slot.typeStrLen.store(typeStr.size(), std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+  }
+  return index;
+}
+
+void Writer::Unannounce(int index) {
+  Slot& slot = GetSlot(index);
+  uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+  slot.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.type.store(NT_UNASSIGNED, std::memory_order_relaxed);
+  slot.dataSize.store(0, std::memory_order_relaxed);
+  slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+bool Writer::SetValue(int index, const Value& value) {
+  uint64_t scalar = 0;
+  std::span<const uint8_t> data;
+  switch (value.type()) {
+    case NT_BOOLEAN:
+      scalar = value.GetBoolean() ? 1 : 0;
+      break;
+    case NT_INTEGER:
+      scalar = std::bit_cast<uint64_t>(value.GetInteger());
+      break;
+    case NT_FLOAT:
+      scalar = std::bit_cast<uint32_t>(value.GetFloat());
+      break;
+    case NT_DOUBLE:
+      scalar = std::bit_cast<uint64_t>(value.GetDouble());
+      break;
+    case NT_STRING: {
+      auto str = value.GetString();
+      data = {reinterpret_cast<const uint8_t*>(str.data()), str.size()};
+      break;
+    }
+    case NT_RAW:
+      data = value.GetRaw();
+      break;
+    case NT_BOOLEAN_ARRAY:
+      data = AsBytes(value.GetBooleanArray());
+      break;
+    case NT_INTEGER_ARRAY:
+      data = AsBytes(value.GetIntegerArray());
+      break;
+    case NT_FLOAT_ARRAY:
+      data = AsBytes(value.GetFloatArray());
+      break;
+    case NT_DOUBLE_ARRAY:
+      data = AsBytes(value.GetDoubleArray());
+      break;
+    case NT_STRING_ARRAY:
+      // each string is stored as a 32-bit length followed by its contents
+      m_buf.clear();
+      for (auto&& str : value.GetStringArray()) {
+        uint32_t len = str.size();
+        m_buf.insert(m_buf.end(), reinterpret_cast<const uint8_t*>(&len),
+                     reinterpret_cast<const uint8_t*>(&len) + sizeof(len));
+        m_buf.insert(m_buf.end(), str.begin(), str.end());
+      }
+      data = m_buf;
+      break;
+    default:
+      return true;
+  }
+  if (data.size() > UINT32_MAX) {
+    return false;
+  }
+
+  // grow the data block if needed; old blocks are abandoned, not reused
+  Slot& slot = GetSlot(index);
+  uint64_t dataOffset = slot.dataOffset.load(std::memory_order_relaxed);
+  uint32_t& capacity = m_capacity[index];
+  if (data.size() > capacity) {
+    size_t newCapacity = std::max<size_t>(
+        {data.size(), static_cast<size_t>(capacity) * 2, 16});
+    newCapacity = std::min<size_t>(newCapacity, UINT32_MAX);
+    dataOffset = Allocate(newCapacity);
+    if (dataOffset == 0) {
+      return false;
+    }
+    capacity = newCapacity;
+  }
+
+  uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+  slot.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.type.store(value.type(), std::memory_order_relaxed);
+  slot.time.store(value.time(), std::memory_order_relaxed);
+  slot.serverTime.store(value.server_time(), std::memory_order_relaxed);
+  slot.scalar.store(scalar, std::memory_order_relaxed);
+  slot.dataOffset.store(dataOffset, std::memory_order_relaxed);
+  slot.dataSize.store(data.size(), std::memory_order_relaxed);
+  if (!data.empty()) {
+    std::memcpy(m_region.data() + dataOffset, data.data(), data.size());
+  }
+  slot.seq.store(seq + 2, std::memory_order_release);
+  return true;
+}
+
+bool Reader::IsValid() const {
+  return m_header && m_header->closed.load(std::memory_order_acquire) == 0;
+}
+
+int Reader::GetNumTopics() const {
+  if (!m_header) {
+    return 0;
+  }
+  return std::min(m_header->numTopics.load(std::memory_order_acquire),
+                  m_header->maxTopics);
+}
+
+const Slot* Reader::GetSlot(int index) const {
+  if (index < 0 || index >= GetNumTopics()) {
+    return nullptr;
+  }
+  return reinterpret_cast<const Slot*>(m_region.const_data() + sizeof(Header) +
+                                       index * sizeof(Slot));
+}
+
+std::string_view Reader::GetHeapString(uint64_t offset, uint32_t len) const {
+  if (offset < m_header->heapOffset || offset > m_header->size ||
+      len > m_header->size - offset) {
+    return {};
+  }
+  return {reinterpret_cast<const char*>(m_region.const_data() + offset), len};
+}
+
+std::string_view Reader::GetTopicName(int index) const {
+  auto slot = GetSlot(index);
+  if (!slot) {
+    return {};
+  }
+  return GetHeapString(slot->nameOffset, slot->nameLen);
+}
+
+std::string Reader::GetTopicTypeString(int index) const {
+  auto slot = GetSlot(index);
+  if (!slot) {
+    return {};
+  }
+  for (int i = 0; i < kMaxReadTries; ++i) {
+    uint32_t seq = slot->seq.load(std::memory_order_acquire);
+    if ((seq & 1) != 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::string typeStr{
+        GetHeapString(slot->typeStrOffset.load(std::memory_order_relaxed),
+                      slot->typeStrLen.load(std::memory_order_relaxed))};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->seq.load(std::memory_order_relaxed) == seq) {
+      return typeStr;
+    }
+  }
+  return {};
+}
+
+std::optional<wpi::nt::Value> Reader::GetValue(int index) const {
+  auto slot = GetSlot(index);
+  if (!slot) {
+    return std::nullopt;
+  }
+  std::vector<uint8_t> data;
+  for (int i = 0; i < kMaxReadTries; ++i) {
+    uint32_t seq = slot->seq.load(std::memory_order_acquire);
+    if ((seq & 1) != 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    auto type =
+        static_cast<NT_Type>(slot->type.load(std::memory_order_relaxed));
+    int64_t time = slot->time.load(std::memory_order_relaxed);
+    int64_t serverTime = slot->serverTime.load(std::memory_order_relaxed);
+    uint64_t scalar = slot->scalar.load(std::memory_order_relaxed);
+    uint64_t dataOffset = slot->dataOffset.load(std::memory_order_relaxed);
+    uint32_t dataSize = slot->dataSize.load(std::memory_order_relaxed);
+    // a torn read may produce a bad offset; the seq check below catches it
+    auto bytes = GetHeapString(dataOffset, dataSize);
+    data.assign(bytes.begin(), bytes.end());
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->seq.load(std::memory_order_relaxed) != seq) {
+      continue;
+    }
+    if (type == NT_UNASSIGNED || bytes.size() != dataSize) {
+      return std::nullopt;
+    }
+    auto value = Decode(type, scalar, data, time);
+    if (value) {
+      value->SetServerTime(serverTime);
+    }
+    return value;
+  }
+  return std::nullopt;
+}
@@ -0,0 +1,167 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "wpi/nt/NetworkTableValue.hpp"
+#include "wpi/util/MappedFileRegion.hpp"
+#include "wpi/util/StringMap.hpp"
+
+namespace wpi::nt::net::shm {
+
+// Segment layout:
+//   Header
+//   Slot[maxTopics]
+//   heap (names, type strings, and array/string value data)
+//
+// There is a single writer (the server).  Slots and heap blocks are never
+// freed, so readers can always safely follow offsets; each slot's seq counter
+// (odd while a write is in progress) lets readers detect and retry torn reads.
+
+inline constexpr char kMagic[8] = {'N', 'T', 'S', 'H', 'M', 'E', 'M', '1'};
+inline constexpr uint32_t kVersion = 2;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t maxTopics;
+  uint64_t size;
+  uint64_t heapOffset;
+  // number of slots in use; slot names are written before this is increased
+  std::atomic<uint32_t> numTopics;
+  // set when the writer closes the segment
+  std::atomic<uint32_t> closed;
+  // process ID of the writer; a segment whose writer no longer exists is stale
+  uint32_t ownerPid;
+  uint32_t reserved;
+};
+
+struct Slot {
+  std::atomic<uint32_t> seq;
+  std::atomic<uint32_t> type;  // NT_Type; NT_UNASSIGNED if no value
+  std::atomic<int64_t> time;
+  std::atomic<int64_t> serverTime;
+  // boolean, integer, float, and double values
+  std::atomic<uint64_t> scalar;
+  // string, raw, and array values
+  std::atomic<uint64_t> dataOffset;
+  std::atomic<uint32_t> dataSize;
+  std::atomic<uint32_t> typeStrLen;
+  std::atomic<uint64_t> typeStrOffset;
+  // immutable once the slot is published via Header::numTopics
+  uint64_t nameOffset;
+  uint32_t nameLen;
+  uint32_t reserved;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<int64_t>::is_always_lock_free);
+
+/**
+ * Creates and writes a shared memory segment.  Not thread safe.
+ */
+class Writer {
+ public:
+  /**
+   * Creates a named segment.  An existing segment with the same name is only
+   * replaced if the process that created it no longer exists; otherwise this
+   * fails with std::errc::file_exists.  Only supported on POSIX systems.
+   *
+   * @param name segment name
+   * @param size segment size in bytes
+   * @param maxTopics maximum number of topics
+   * @param worldReadable if true, other users can read the segment;
+   *                      otherwise only the same user can
+   * @param ec error code (set on failure)
+   * @return writer, or nullptr on failure
+   */
+  static std::unique_ptr<Writer> Create(std::string_view name, size_t size,
+                                        uint32_t maxTopics, bool worldReadable,
+                                        std::error_code& ec);
+
+  /**
+   * Marks the segment closed and removes its name.  Readers that still have
+   * it mapped continue to see the last values.
+   */
+  ~Writer();
+
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  /**
+   * Assigns a slot to a topic.  Announcing a topic that was previously
+   * unannounced reuses its slot.
+   *
+   * @param name topic name
+   * @param typeStr type string
+   * @return slot index, or -1 if out of slots or heap space
+   */
+  int Announce(std::string_view name, std::string_view typeStr);
+
+  /**
+   * Clears the value of a slot.
+   *
+   * @param index slot index
+   */
+  void Unannounce(int index);
+
+  /**
+   * Sets the value of a slot.
+   *
+   * @param index slot index
+   * @param value value
+   * @return False if out of heap space
+   */
+  bool SetValue(int index, const Value& value);
+
+  std::string_view GetName() const { return m_name; }
+
+ private:
+  Writer() = default;
+
+  // returns 0 on failure
+  uint64_t Allocate(size_t size);
+  Slot& GetSlot(int index);
+
+  std::string m_name;
+  wpi::util::MappedFileRegion m_region;
+  Header* m_header = nullptr;
+  uint64_t m_heapUsed = 0;
+  wpi::util::StringMap<int> m_slots;
+  std::vector<uint32_t> m_capacity;
+  std::vector<uint8_t> m_buf;
+};
+
+/**
+ * Maps a named segment for reading.  Thread safe.
+ */
+class Reader {
+ public:
+  explicit Reader(std::string_view name);
+
+  bool IsValid() const;
+  int GetNumTopics() const;
+  std::string_view GetTopicName(int index) const;
+  std::string GetTopicTypeString(int index) const;
+  std::optional<Value> GetValue(int index) const;
+
+ private:
+  const Slot* GetSlot(int index) const;
+  std::string_view GetHeapString(uint64_t offset, uint32_t len) const;
+
+  wpi::util::MappedFileRegion m_region;
+  const Header* m_header = nullptr;
+};
+
+}  // namespace wpi::nt::net::shm
@@ -659,6 +659,13 @@ void StopServer(NT_Inst inst) {
   }
 }
 
+void SetServerSharedMemory(NT_Inst inst, std::string_view name, size_t size,
+                           unsigned int max_topics, bool world_readable) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::INSTANCE)) {
+    ii->SetServerSharedMemory(name, size, max_topics, world_readable);
+  }
+}
+
 void StartClient(NT_Inst inst, std::string_view identity) {
   if (auto ii = InstanceImpl::GetTyped(inst, Handle::INSTANCE)) {
     ii->StartClient(identity);
@@ -4,6 +4,7 @@
 
 #include "ServerClient.hpp"
 
+#include <algorithm>
 #include <utility>
 
 #include "server/MessagePackWriter.hpp"
@@ -48,11 +49,26 @@ std::span<ServerSubscriber*> ServerClient::GetSubscribers(
     std::string_view name, bool special,
     wpi::util::SmallVectorImpl<ServerSubscriber*>& buf) {
   buf.resize(0);
-  for (auto&& subPair : m_subscribers) {
-    ServerSubscriber* subscriber = subPair.getSecond().get();
-    if (subscriber->Matches(name, special)) {
-      buf.emplace_back(subscriber);
-    }
-  }
+  m_subscriberIndex.ForEachMatch(
+      name, special, [&](ServerSubscriber* subscriber) {
+        // a subscriber may match more than one of its topic names
+        if (std::find(buf.begin(), buf.end(), subscriber) == buf.end()) {
+          buf.emplace_back(subscriber);
+        }
+      });
   return {buf.data(), buf.size()};
 }
+
+void ServerClient::IndexSubscriber(ServerSubscriber* subscriber) {
+  bool prefix = subscriber->GetOptions().prefixMatch;
+  for (auto&& name : subscriber->GetTopicNames()) {
+    m_subscriberIndex.Add(name, prefix, subscriber);
+  }
+}
+
+void ServerClient::UnindexSubscriber(ServerSubscriber* subscriber) {
+  bool prefix = subscriber->GetOptions().prefixMatch;
+  for (auto&& name : subscriber->GetTopicNames()) {
+    m_subscriberIndex.Remove(name, prefix, subscriber);
+  }
+}
@@ -13,6 +13,7 @@
 #include <string_view>
 #include <utility>
 
+#include "PrefixTrie.hpp"
 #include "net/NetworkOutgoingQueue.hpp"
 #include "server/Functions.hpp"
 #include "server/ServerPublisher.hpp"
@@ -52,7 +53,8 @@ class ServerClient {
   virtual bool ProcessIncomingBinary(std::span<const uint8_t> data) = 0;
 
   virtual void SendValue(ServerTopic* topic, const Value& value,
-                         net::ValueSendMode mode) = 0;
+                         net::ValueSendMode mode,
+                         net::SharedValueEncoding& encoding) = 0;
   virtual void SendAnnounce(ServerTopic* topic, std::optional<int> pubuid) = 0;
   virtual void SendUnannounce(ServerTopic* topic) = 0;
   virtual void SendPropertiesUpdate(ServerTopic* topic,
@@ -78,6 +80,10 @@ class ServerClient {
   virtual void UpdatePeriod(TopicClientData& tcd, ServerTopic* topic) {}
 
  protected:
+  // keep m_subscriberIndex in sync with m_subscribers' topic names
+  void IndexSubscriber(ServerSubscriber* subscriber);
+  void UnindexSubscriber(ServerSubscriber* subscriber);
+
   std::string m_name;
   std::string m_connInfo;
   bool m_local;  // local to machine
@@ -91,6 +97,7 @@ class ServerClient {
 
   wpi::util::DenseMap<int, std::unique_ptr<ServerPublisher>> m_publishers;
   wpi::util::DenseMap<int, std::unique_ptr<ServerSubscriber>> m_subscribers;
+  PrefixTrie<ServerSubscriber*> m_subscriberIndex;
 
  public:
   // meta topics
@@ -89,8 +89,9 @@ bool ServerClient4::ProcessIncomingBinary(std::span<const uint8_t> data) {
 }
 
 void ServerClient4::SendValue(ServerTopic* topic, const Value& value,
-                              net::ValueSendMode mode) {
-  m_outgoing.SendValue(topic->id, value, mode);
+                              net::ValueSendMode mode,
+                              net::SharedValueEncoding& encoding) {
+  m_outgoing.SendValue(topic->id, value, mode, encoding.Get());
 }
 
 void ServerClient4::SendAnnounce(ServerTopic* topic,
@@ -31,7 +31,8 @@ class ServerClient4 final : public ServerClient4Base {
   }
 
   void SendValue(ServerTopic* topic, const Value& value,
-                 net::ValueSendMode mode) final;
+                 net::ValueSendMode mode,
+                 net::SharedValueEncoding& encoding) final;
   void SendAnnounce(ServerTopic* topic, std::optional<int> pubuid) final;
   void SendUnannounce(ServerTopic* topic) final;
   void SendPropertiesUpdate(ServerTopic* topic, const wpi::util::json& update,
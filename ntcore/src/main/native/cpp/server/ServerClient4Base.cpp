@@ -106,14 +106,27 @@ static std::string join(std::span<const std::string> values) {
   return ret;
 }
 
+// Sorts topics into the order of ServerStorage::ForEachTopic() and removes
+// duplicates
+static void SortTopics(std::vector<ServerTopic*>& topics) {
+  std::sort(topics.begin(), topics.end(),
+            [](auto a, auto b) { return a->id < b->id; });
+  topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+}
+
 void ServerClient4Base::ClientSubscribe(int subuid,
                                         std::span<const std::string> topicNames,
                                         const PubSubOptionsImpl& options) {
   DEBUG4("ClientSubscribe({}, ({}), {})", m_id, join(topicNames), subuid);
+  // only topics matched by the old or new topic names can be affected
+  std::vector<ServerTopic*> topics;
   auto& sub = m_subscribers[subuid];
   bool replace = false;
   if (sub) {
     // replace subscription
+    m_storage.FindTopics(sub->GetTopicNames(), sub->GetOptions().prefixMatch,
+                         topics);
+    UnindexSubscriber(sub.get());
     sub->Update(topicNames, options);
     replace = true;
   } else {
@@ -121,6 +134,10 @@ void ServerClient4Base::ClientSubscribe(int subuid,
     sub = std::make_unique<ServerSubscriber>(GetName(), topicNames, subuid,
                                              options);
   }
+  IndexSubscriber(sub.get());
+  m_storage.FindTopics(sub->GetTopicNames(), sub->GetOptions().prefixMatch,
+                       topics);
+  SortTopics(topics);
 
   // update periodic sender (if not local)
   if (!m_local) {
@@ -133,8 +150,8 @@ void ServerClient4Base::ClientSubscribe(int subuid,
   // send announcements in first loop and remember what we want to send in
   // second loop.
   std::vector<ServerTopic*> dataToSend;
-  dataToSend.reserve(m_storage.GetNumTopics());
-  m_storage.ForEachTopic([&](ServerTopic* topic) {
+  dataToSend.reserve(topics.size());
+  for (auto topic : topics) {
     auto tcdIt = topic->clients.find(this);
     bool removed = tcdIt != topic->clients.end() && replace &&
                    tcdIt->second.subscribers.erase(sub.get());
@@ -171,11 +188,13 @@ void ServerClient4Base::ClientSubscribe(int subuid,
         topic->lastValue) {
       dataToSend.emplace_back(topic);
     }
-  });
+  }
 
   for (auto topic : dataToSend) {
     DEBUG4("send last value for {} to client {}", topic->name, m_id);
-    SendValue(topic, topic->lastValue, net::ValueSendMode::kAll);
+    net::SharedValueEncoding encoding{static_cast<int>(topic->id),
+                                      topic->lastValue};
+    SendValue(topic, topic->lastValue, net::ValueSendMode::kAll, encoding);
   }
 }
 
@@ -186,9 +205,14 @@ void ServerClient4Base::ClientUnsubscribe(int subuid) {
     return;  // nothing to do
   }
   auto sub = subIt->getSecond().get();
+  UnindexSubscriber(sub);
 
   // remove from topics
-  m_storage.ForEachTopic([&](ServerTopic* topic) {
+  std::vector<ServerTopic*> topics;
+  m_storage.FindTopics(sub->GetTopicNames(), sub->GetOptions().prefixMatch,
+                       topics);
+  SortTopics(topics);
+  for (auto topic : topics) {
     auto tcdIt = topic->clients.find(this);
     if (tcdIt != topic->clients.end()) {
       if (tcdIt->second.subscribers.erase(sub)) {
@@ -196,7 +220,7 @@ void ServerClient4Base::ClientUnsubscribe(int subuid) {
         m_storage.UpdateMetaTopicSub(topic);
       }
     }
-  });
+  }
 
   // delete it from client (future value sets will be ignored)
   m_subscribers.erase(subIt);
@@ -29,7 +29,8 @@ ServerClientLocal::ServerClientLocal(ServerStorage& storage, int id,
 #endif
 
 void ServerClientLocal::SendValue(ServerTopic* topic, const Value& value,
-                                  net::ValueSendMode mode) {
+                                  net::ValueSendMode mode,
+                                  net::SharedValueEncoding& encoding) {
   if (m_local) {
     m_local->ServerSetValue(topic->localTopic, value);
   }
@@ -0,0 +1,63 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ServerClientShm.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "Log.hpp"
+#include "server/ServerStorage.hpp"
+#include "server/ServerTopic.hpp"
+
+using namespace wpi::nt::server;
+
+ServerClientShm::ServerClientShm(std::unique_ptr<net::shm::Writer> writer,
+                                 ServerStorage& storage, int id,
+                                 wpi::util::Logger& logger)
+    : ServerClient4Base{"shm",   writer->GetName(), true, [](uint32_t) {},
+                        storage, id,                logger},
+      m_writer{std::move(writer)} {
+  // subscribe to all values
+  std::string prefix;
+  ClientSubscribe(1, {&prefix, 1},
+                  PubSubOptions{.sendAll = true, .prefixMatch = true});
+}
+
+void ServerClientShm::SendValue(ServerTopic* topic, const Value& value,
+                                net::ValueSendMode mode,
+                                net::SharedValueEncoding& encoding) {
+  auto it = m_slots.find(topic);
+  if (it == m_slots.end() || it->second < 0) {
+    return;
+  }
+  if (!m_writer->SetValue(it->second, value) && !m_warnedFull) {
+    WARN("shared memory segment '{}' is full; not updating '{}'",
+         m_writer->GetName(), topic->name);
+    m_warnedFull = true;
+  }
+}
+
+void ServerClientShm::SendAnnounce(ServerTopic* topic,
+                                   std::optional<int> pubuid) {
+  int index = m_writer->Announce(topic->name, topic->typeStr);
+  m_slots[topic] = index;
+  if (index < 0 && !m_warnedFull) {
+    WARN("shared memory segment '{}' is full; not adding '{}'",
+         m_writer->GetName(), topic->name);
+    m_warnedFull = true;
+  }
+}
+
+void ServerClientShm::SendUnannounce(ServerTopic* topic) {
+  auto it = m_slots.find(topic);
+  if (it == m_slots.end()) {
+    return;
+  }
+  if (it->second >= 0) {
+    m_writer->Unannounce(it->second);
+  }
+  m_slots.erase(it);
+}
@@ -0,0 +1,47 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "net/SharedMemory.hpp"
+#include "server/ServerClient4Base.hpp"
+#include "wpi/util/DenseMap.hpp"
+
+namespace wpi::nt::server {
+
+// Publishes the value of every topic into a shared memory segment for readers
+// on the same host.  Subscribes to all topics with sendAll; never publishes.
+class ServerClientShm final : public ServerClient4Base {
+ public:
+  ServerClientShm(std::unique_ptr<net::shm::Writer> writer,
+                  ServerStorage& storage, int id, wpi::util::Logger& logger);
+
+  bool ProcessIncomingText(std::string_view data) final { return false; }
+  bool ProcessIncomingBinary(std::span<const uint8_t> data) final {
+    return false;
+  }
+  bool ProcessIncomingMessages(size_t max) final { return false; }
+
+  void SendValue(ServerTopic* topic, const Value& value,
+                 net::ValueSendMode mode,
+                 net::SharedValueEncoding& encoding) final;
+  void SendAnnounce(ServerTopic* topic, std::optional<int> pubuid) final;
+  void SendUnannounce(ServerTopic* topic) final;
+  void SendPropertiesUpdate(ServerTopic* topic, const wpi::util::json& update,
+                            bool ack) final {}
+  void SendOutgoing(uint64_t curTimeMs, bool flush) final {}
+  void Flush() final {}
+
+ private:
+  std::unique_ptr<net::shm::Writer> m_writer;
+  // slot index for each topic; -1 if the segment is full
+  wpi::util::DenseMap<ServerTopic*, int> m_slots;
+  bool m_warnedFull = false;
+};
+
+}  // namespace wpi::nt::server
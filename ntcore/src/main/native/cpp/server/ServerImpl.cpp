@@ -10,6 +10,7 @@
 #include <format>
 #include <memory>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -17,6 +18,7 @@
 #include "server/MessagePackWriter.hpp"
 #include "server/ServerClient4.hpp"
 #include "server/ServerClientLocal.hpp"
+#include "server/ServerClientShm.hpp"
 #include "wpi/util/MessagePack.hpp"
 
 using namespace wpi::nt;
@@ -68,6 +70,23 @@ std::shared_ptr<void> ServerImpl::RemoveClient(int clientId) {
   return std::move(client);
 }
 
+bool ServerImpl::StartSharedMemory(std::string_view name, size_t size,
+                                   unsigned int maxTopics, bool worldReadable) {
+  std::error_code ec;
+  auto writer =
+      net::shm::Writer::Create(name, size, maxTopics, worldReadable, ec);
+  if (!writer) {
+    ERR("could not create shared memory segment '{}': {}", name, ec.message());
+    return false;
+  }
+  size_t index = GetEmptyClientSlot();
+  m_clients[index] = std::make_unique<ServerClientShm>(
+      std::move(writer), m_storage, index, m_logger);
+  DEBUG3("StartSharedMemory('{}', {}, {}) -> {}", name, size, maxTopics,
+         index);
+  return true;
+}
+
 size_t ServerImpl::GetEmptyClientSlot() {
   size_t size = m_clients.size();
   // find an empty slot
@@ -200,3 +219,11 @@ std::string ServerImpl::DumpPersistent() {
   os.flush();
   return rv;
 }
+
+std::string ServerImpl::DumpPersistentBinary() {
+  std::string rv;
+  wpi::util::raw_string_ostream os{rv};
+  m_storage.DumpPersistentBinary(os);
+  os.flush();
+  return rv;
+}
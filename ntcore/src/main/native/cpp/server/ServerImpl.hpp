@@ -63,6 +63,11 @@ class ServerImpl final {
                                         SetPeriodicFunc setPeriodic);
   std::shared_ptr<void> RemoveClient(int clientId);
 
+  // Adds a client that publishes all values into a shared memory segment.
+  // Returns false (and logs an error) if the segment cannot be created.
+  bool StartSharedMemory(std::string_view name, size_t size,
+                         unsigned int maxTopics, bool worldReadable);
+
   void ConnectionsChanged(const std::vector<ConnectionInfo>& conns) {
     UpdateMetaClients(conns);
   }
@@ -71,6 +76,7 @@ class ServerImpl final {
   bool PersistentChanged() { return m_storage.PersistentChanged(); }
 
   std::string DumpPersistent();
+  std::string DumpPersistentBinary();
   // returns newline-separated errors
   std::string LoadPersistent(std::string_view in) {
     return m_storage.LoadPersistent(in);
@@ -6,15 +6,20 @@
 
 #include <format>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "Log.hpp"
+#include "Types_internal.hpp"
+#include "net/WireDecoder.hpp"
+#include "net/WireEncoder.hpp"
 #include "server/MessagePackWriter.hpp"
 #include "server/ServerClient.hpp"
 #include "wpi/util/Base64.hpp"
 #include "wpi/util/MessagePack.hpp"
+#include "wpi/util/SpanExtras.hpp"
 #include "wpi/util/json.hpp"
 
 using namespace wpi::nt;
@@ -43,6 +48,7 @@ ServerTopic* ServerStorage::CreateTopic(ServerClient* client,
     topic = m_topics[id].get();
     topic->id = id;
     topic->special = special;
+    m_topicIndex.Add(name, false, topic);
 
     m_sendAnnounce(topic, client);
 
@@ -85,18 +91,33 @@ void ServerStorage::DeleteTopic(ServerTopic* topic) {
   }
 
   // erase the topic
+  m_topicIndex.Remove(topic->name, false, topic);
   m_nameTopics.erase(topic->name);
   m_topics.erase(topic->id);
 }
 
+void ServerStorage::FindTopics(std::span<const std::string> names,
+                               bool prefix,
+                               std::vector<ServerTopic*>& topics) const {
+  for (auto&& name : names) {
+    if (prefix) {
+      m_topicIndex.ForEachStartingWith(
+          name, [&](ServerTopic* topic) { topics.emplace_back(topic); });
+    } else if (auto topic = GetTopic(name)) {
+      topics.emplace_back(topic);
+    }
+  }
+}
+
 void ServerStorage::SetProperties(ServerClient* client, ServerTopic* topic,
                                   const wpi::util::json& update) {
   DEBUG4("SetProperties({}, {}, {})", client ? client->GetId() : -1,
          topic->name, update.to_string());
   bool wasPersistent = topic->persistent;
   if (topic->SetProperties(update)) {
+    topic->persistentRecord.clear();
     // update persistentChanged flag
-    if (topic->persistent != wasPersistent) {
+    if (topic->persistent || topic->persistent != wasPersistent) {
       m_persistentChanged = true;
     }
     PropertiesChanged(client, topic, update);
@@ -107,6 +128,7 @@ void ServerStorage::SetFlags(ServerClient* client, ServerTopic* topic,
                              unsigned int flags) {
   bool wasPersistent = topic->persistent;
   if (topic->SetFlags(flags)) {
+    topic->persistentRecord.clear();
     // update persistentChanged flag
     if (topic->persistent != wasPersistent) {
       m_persistentChanged = true;
@@ -132,6 +154,7 @@ void ServerStorage::SetValue(ServerClient* client, ServerTopic* topic,
            topic->lastValue.time(), value.time());
     topic->lastValue = value;
     topic->lastValueClient = client;
+    topic->persistentRecord.clear();
 
     // if persistent, update flag
     if (topic->persistent) {
@@ -139,10 +162,11 @@ void ServerStorage::SetValue(ServerClient* client, ServerTopic* topic,
     }
   }
 
+  net::SharedValueEncoding encoding{static_cast<int>(topic->id), value};
   for (auto&& tcd : topic->clients) {
     if (tcd.first != client &&
         tcd.second.sendMode != net::ValueSendMode::kDisabled) {
-      tcd.first->SendValue(topic, value, tcd.second.sendMode);
+      tcd.first->SendValue(topic, value, tcd.second.sendMode, encoding);
     }
   }
 }
@@ -361,6 +385,41 @@ void ServerStorage::DumpPersistent(wpi::util::raw_ostream& os) {
   os << "\n]\n";
 }
 
+// The binary persistent format starts with this header (a MessagePack
+// string), so it can't be mistaken for JSON. Each persistent topic follows as
+// a MessagePack array of its name, type string, and properties (as JSON text),
+// then its value encoded as in a binary NT4 message with a topic ID and
+// timestamp of 0.
+static constexpr std::string_view kBinaryPersistentHeader =
+    "\xaa"
+    "NTPersist1";
+
+static void EncodePersistentRecord(ServerTopic* topic) {
+  Writer w;
+  mpack_start_array(&w, 3);
+  mpack_write_str(&w, topic->name);
+  mpack_write_str(&w, topic->typeStr);
+  mpack_write_str(&w, topic->properties.to_string());
+  mpack_finish_array(&w);
+  if (mpack_writer_destroy(&w) == mpack_ok &&
+      net::WireEncodeBinary(w.os, 0, 0, topic->lastValue)) {
+    topic->persistentRecord = std::move(w.bytes);
+  }
+}
+
+void ServerStorage::DumpPersistentBinary(wpi::util::raw_ostream& os) {
+  os << kBinaryPersistentHeader;
+  for (const auto& topic : m_topics) {
+    if (!topic->persistent || !topic->lastValue) {
+      continue;
+    }
+    if (topic->persistentRecord.empty()) {
+      EncodePersistentRecord(topic.get());
+    }
+    os << std::span<const uint8_t>{topic->persistentRecord};
+  }
+}
+
 static std::string* ObjGetString(wpi::util::json& obj, std::string_view key,
                                  std::string* error) {
   auto value = obj.lookup(key);
@@ -375,7 +434,32 @@ static std::string* ObjGetString(wpi::util::json& obj, std::string_view key,
   return &value->get_string();
 }
 
+static bool CheckPersistentProperty(const wpi::util::json& props,
+                                    std::string* error) {
+  auto persistent = props.lookup("persistent");
+  if (!persistent) {
+    *error = "no persistent property";
+    return false;
+  }
+  if (!persistent->is_bool()) {
+    *error = "persistent property is not boolean";
+    return false;
+  }
+  if (!persistent->get_bool()) {
+    *error = "persistent property is false";
+    return false;
+  }
+  return true;
+}
+
 std::string ServerStorage::LoadPersistent(std::string_view in) {
+  if (in.starts_with(kBinaryPersistentHeader)) {
+    return LoadPersistentBinary(in.substr(kBinaryPersistentHeader.size()));
+  }
+  return LoadPersistentJson(in);
+}
+
+std::string ServerStorage::LoadPersistentJson(std::string_view in) {
   if (in.empty()) {
     return {};
   }
@@ -427,18 +511,7 @@ std::string ServerStorage::LoadPersistent(std::string_view in) {
       }
 
       // check to make sure persistent property is set
-      auto persistent = props->lookup("persistent");
-      if (!persistent) {
-        error = "no persistent property";
-        goto err;
-      }
-      if (persistent->is_bool()) {
-        if (!persistent->get_bool()) {
-          error = "persistent property is false";
-          goto err;
-        }
-      } else {
-        error = "persistent property is not boolean";
+      if (!CheckPersistentProperty(*props, &error)) {
         goto err;
       }
 
@@ -582,3 +655,82 @@ std::string ServerStorage::LoadPersistent(std::string_view in) {
 
   return allerrors;
 }
+
+std::string ServerStorage::LoadPersistentBinary(std::string_view in) {
+  bool persistentChanged = m_persistentChanged;
+
+  std::string allerrors;
+  auto time = wpi::nt::Now();
+  std::span<const uint8_t> data{reinterpret_cast<const uint8_t*>(in.data()),
+                                in.size()};
+  for (int i = 0; !data.empty(); ++i) {
+    // name, type, and properties
+    uint32_t maxLen = data.size();
+    std::string name;
+    std::string typeStr;
+    std::string propsStr;
+    mpack_reader_t reader;
+    mpack_reader_init_data(&reader, data);
+    mpack_expect_array_match(&reader, 3);
+    mpack_expect_str(&reader, &name, maxLen);
+    mpack_expect_str(&reader, &typeStr, maxLen);
+    mpack_expect_str(&reader, &propsStr, maxLen);
+    mpack_done_array(&reader);
+    auto remaining = mpack_reader_remaining(&reader, nullptr);
+    if (auto err = mpack_reader_destroy(&reader); err != mpack_ok) {
+      // the next record can't be found, so stop here
+      allerrors += std::format("{}: {}\n", i, mpack_error_to_string(err));
+      break;
+    }
+    data = wpi::util::take_back(data, remaining);
+
+    // value
+    int id;
+    Value value;
+    std::string error;
+    if (!net::WireDecodeBinary(&data, &id, &value, &error, 0)) {
+      allerrors += std::format("{}: {}\n", i, error);
+      break;
+    }
+
+    {
+      auto props = wpi::util::json::parse(propsStr);
+      if (!props) {
+        error = std::format("could not decode properties: {}", props.error());
+        goto err;
+      }
+      if (!props->is_object()) {
+        error = "properties must be an object";
+        goto err;
+      }
+
+      // check to make sure persistent property is set
+      if (!CheckPersistentProperty(*props, &error)) {
+        goto err;
+      }
+
+      // rpc values are encoded as raw
+      auto type = StringToType(typeStr);
+      if (value.type() != (type == NT_RPC ? NT_RAW : type)) {
+        error = std::format("value type mismatch, expected {}", typeStr);
+        goto err;
+      }
+      value.SetTime(time);
+      value.SetServerTime(1);
+
+      // create persistent topic
+      auto topic = CreateTopic(nullptr, name, typeStr, *props);
+
+      // set value
+      SetValue(nullptr, topic, value);
+
+      continue;
+    }
+  err:
+    allerrors += std::format("{}: {}\n", i, error);
+  }
+
+  m_persistentChanged = persistentChanged;  // restore flag
+
+  return allerrors;
+}
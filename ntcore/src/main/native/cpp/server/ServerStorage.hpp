@@ -5,10 +5,13 @@
 #pragma once
 
 #include <concepts>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "PrefixTrie.hpp"
 #include "server/ServerTopic.hpp"
 #include "wpi/util/StringMap.hpp"
 #include "wpi/util/UidVector.hpp"
@@ -68,6 +71,12 @@ class ServerStorage final {
     }
   }
 
+  // Appends the topics named by any of the names, or starting with any of
+  // them if prefix is true. Topics may be appended more than once, and an
+  // empty prefix includes special topics.
+  void FindTopics(std::span<const std::string> names, bool prefix,
+                  std::vector<ServerTopic*>& topics) const;
+
   // update meta topic values from data structures
   void UpdateMetaTopicPub(ServerTopic* topic);
   void UpdateMetaTopicSub(ServerTopic* topic);
@@ -80,15 +89,22 @@ class ServerStorage final {
   }
 
   void DumpPersistent(wpi::util::raw_ostream& os);
-  // returns newline-separated errors
+  // binary (MessagePack) equivalent of DumpPersistent; only the topics
+  // changed since the last call are encoded again
+  void DumpPersistentBinary(wpi::util::raw_ostream& os);
+  // loads either format; returns newline-separated errors
   std::string LoadPersistent(std::string_view in);
 
  private:
+  std::string LoadPersistentJson(std::string_view in);
+  std::string LoadPersistentBinary(std::string_view in);
+
   wpi::util::Logger& m_logger;
   std::function<void(ServerTopic* topic, ServerClient* client)> m_sendAnnounce;
 
   wpi::util::UidVector<std::unique_ptr<ServerTopic>, 16> m_topics;
   wpi::util::StringMap<ServerTopic*> m_nameTopics;
+  PrefixTrie<ServerTopic*> m_topicIndex;
   bool m_persistentChanged{false};
 };
 
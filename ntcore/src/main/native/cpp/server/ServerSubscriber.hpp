@@ -50,6 +50,8 @@ class ServerSubscriber {
 
   bool Matches(std::string_view name, bool special);
 
+  std::span<const std::string> GetTopicNames() const { return m_topicNames; }
+
   const PubSubOptions& GetOptions() const { return m_options; }
   uint32_t GetPeriodMs() const { return m_periodMs; }
 
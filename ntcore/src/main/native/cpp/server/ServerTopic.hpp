@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "net/NetworkOutgoingQueue.hpp"
 #include "server/ServerPublisher.hpp"
@@ -81,6 +84,9 @@ struct ServerTopic {
   bool special{false};
   int localTopic{0};
 
+  // encoded binary persistent record; cleared when it needs to be re-encoded
+  std::vector<uint8_t> persistentRecord;
+
   void AddPublisher(ServerClient* client, ServerPublisher* pub) {
     if (clients[client].publishers.insert(pub).second) {
       ++publisherCount;
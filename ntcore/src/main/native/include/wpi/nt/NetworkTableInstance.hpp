@@ -603,7 +603,9 @@ class NetworkTableInstance final {
    * Starts a server using the specified filename, listening address, and port.
    *
    * @param persist_filename  the name of the persist file to use (UTF-8 string,
-   *                          null terminated)
+   *                          null terminated); if it ends in ".msgpack",
+   *                          values are saved in a compact binary format
+   *                          instead of JSON (either format is loaded)
    * @param listen_address    the address to listen on, or an empty string to
    *                          listen on any address. (UTF-8 string, null
    *                          terminated)
@@ -625,6 +627,30 @@ class NetworkTableInstance final {
    */
   void StopServer() { ::wpi::nt::StopServer(m_handle); }
 
+  /**
+   * Configures the server to also publish all topic values into a POSIX
+   * shared memory segment, which processes on the same host can read with
+   * SharedMemoryReader without a network connection.  Must be called before
+   * StartServer; takes effect the next time the server is started.  Not
+   * supported on Windows.
+   *
+   * The segment is only readable by processes of the same user unless
+   * world_readable is set.  Starting the server fails to create the segment
+   * if one with the same name is in use by another process.
+   *
+   * @param name            segment name, or an empty string to disable
+   * @param size            segment size in bytes
+   * @param max_topics      maximum number of topics in the segment
+   * @param world_readable  allow processes of other users to read the segment
+   */
+  void SetServerSharedMemory(std::string_view name,
+                             size_t size = 4 * 1024 * 1024,
+                             unsigned int max_topics = 4096,
+                             bool world_readable = false) {
+    ::wpi::nt::SetServerSharedMemory(m_handle, name, size, max_topics,
+                                     world_readable);
+  }
+
   /**
    * Starts a client.  Use SetServer, SetServerTeam, SetServerFixed, or
    * SetServerMdns to set the server name and port.
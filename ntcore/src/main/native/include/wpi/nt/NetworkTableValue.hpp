@@ -6,8 +6,10 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <span>
@@ -23,6 +25,8 @@ namespace wpi::nt {
 // Forward declare here to avoid circular dependency on ntcore_cpp.h
 int64_t Now();
 
+class ValueBufferPool;
+
 #if __GNUC__ >= 13
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
@@ -30,12 +34,23 @@ int64_t Now();
 
 /**
  * A network table entry value.
+ *
+ * Short strings and raw values, and arrays of up to kInlineSize bytes, are
+ * stored inline rather than allocated. Longer values share their storage
+ * between copies.
+ *
  * @ingroup ntcore_cpp_api
  */
 class Value final {
   struct private_init {};
 
  public:
+  /**
+   * Maximum size in bytes of array and raw data stored inline in the value.
+   * Strings shorter than this are also stored inline.
+   */
+  static constexpr size_t kInlineSize = 24;
+
   Value() {
     m_val.type = NT_UNASSIGNED;
     m_val.last_change = 0;
@@ -72,6 +87,38 @@ class Value final {
     }
   }
 
+  Value(const Value& rhs)
+      : m_val{rhs.m_val}, m_storage{rhs.m_storage}, m_size{rhs.m_size} {
+    CopyInline(rhs);
+  }
+
+  Value(Value&& rhs) noexcept
+      : m_val{rhs.m_val},
+        m_storage{std::move(rhs.m_storage)},
+        m_size{rhs.m_size} {
+    CopyInline(rhs);
+  }
+
+  Value& operator=(const Value& rhs) {
+    if (this != &rhs) {
+      m_val = rhs.m_val;
+      m_storage = rhs.m_storage;
+      m_size = rhs.m_size;
+      CopyInline(rhs);
+    }
+    return *this;
+  }
+
+  Value& operator=(Value&& rhs) noexcept {
+    if (this != &rhs) {
+      m_val = rhs.m_val;
+      m_storage = std::move(rhs.m_storage);
+      m_size = rhs.m_size;
+      CopyInline(rhs);
+    }
+    return *this;
+  }
+
   explicit operator bool() const { return m_val.type != NT_UNASSIGNED; }
 
   /**
@@ -410,6 +457,13 @@ class Value final {
    * @return The entry value
    */
   static Value MakeString(std::string_view value, int64_t time = 0) {
+    if (value.size() < kInlineSize) {
+      Value val{NT_STRING, 0, time, private_init{}};
+      *std::copy(value.begin(), value.end(), val.m_inline) = '\0';
+      val.m_val.data.v_string.str = val.m_inline;
+      val.m_val.data.v_string.len = value.size();
+      return val;
+    }
     auto data = std::make_shared<std::string>(value);
     Value val{NT_STRING, data->capacity(), time, private_init{}};
     val.m_val.data.v_string.str = const_cast<char*>(data->c_str());
@@ -428,6 +482,9 @@ class Value final {
    */
   template <std::same_as<std::string> T>
   static Value MakeString(T&& value, int64_t time = 0) {
+    if (value.size() < kInlineSize) {
+      return MakeString(std::string_view{value}, time);
+    }
     auto data = std::make_shared<std::string>(std::forward<T>(value));
     Value val{NT_STRING, data->capacity(), time, private_init{}};
     val.m_val.data.v_string.str = const_cast<char*>(data->c_str());
@@ -445,6 +502,13 @@ class Value final {
    * @return The entry value
    */
   static Value MakeRaw(std::span<const uint8_t> value, int64_t time = 0) {
+    if (value.size() <= kInlineSize) {
+      Value val{NT_RAW, 0, time, private_init{}};
+      std::copy(value.begin(), value.end(), val.m_inline);
+      val.m_val.data.v_raw.data = reinterpret_cast<uint8_t*>(val.m_inline);
+      val.m_val.data.v_raw.size = value.size();
+      return val;
+    }
     auto data =
         std::make_shared<std::vector<uint8_t>>(value.begin(), value.end());
     Value val{NT_RAW, data->capacity(), time, private_init{}};
@@ -464,6 +528,9 @@ class Value final {
    */
   template <std::same_as<std::vector<uint8_t>> T>
   static Value MakeRaw(T&& value, int64_t time = 0) {
+    if (value.size() <= kInlineSize) {
+      return MakeRaw(std::span<const uint8_t>{value}, time);
+    }
     auto data = std::make_shared<std::vector<uint8_t>>(std::forward<T>(value));
     Value val{NT_RAW, data->capacity(), time, private_init{}};
     val.m_val.data.v_raw.data = const_cast<uint8_t*>(data->data());
@@ -678,9 +745,56 @@ class Value final {
   friend bool operator==(const Value& lhs, const Value& rhs);
 
  private:
+  friend class ValueBufferPool;
+
+  // Makes a raw (T = uint8_t) or numeric array value from elements of type U.
+  // The data is stored inline if it fits, otherwise in storage allocated from
+  // the pool (if not null).
+  template <typename T, typename U = T>
+  static Value MakeArray(std::span<const U> value, int64_t time,
+                         ValueBufferPool* pool);
+
+  // If rhs's data is stored inline, points this value's data at a copy of it
+  void CopyInline(const Value& rhs) {
+    if (rhs.m_storage) {
+      return;
+    }
+    switch (m_val.type) {
+      case NT_STRING:
+        CopyInline(rhs, m_val.data.v_string.str);
+        break;
+      case NT_RAW:
+        CopyInline(rhs, m_val.data.v_raw.data);
+        break;
+      case NT_BOOLEAN_ARRAY:
+        CopyInline(rhs, m_val.data.arr_boolean.arr);
+        break;
+      case NT_INTEGER_ARRAY:
+        CopyInline(rhs, m_val.data.arr_int.arr);
+        break;
+      case NT_FLOAT_ARRAY:
+        CopyInline(rhs, m_val.data.arr_float.arr);
+        break;
+      case NT_DOUBLE_ARRAY:
+        CopyInline(rhs, m_val.data.arr_double.arr);
+        break;
+      default:
+        break;
+    }
+  }
+
+  template <typename T>
+  void CopyInline(const Value& rhs, T*& data) {
+    if (data == reinterpret_cast<const T*>(rhs.m_inline)) {
+      std::memcpy(m_inline, rhs.m_inline, kInlineSize);
+      data = reinterpret_cast<T*>(m_inline);
+    }
+  }
+
   NT_Value m_val = {};
   std::shared_ptr<void> m_storage;
   size_t m_size = 0;
+  alignas(8) char m_inline[kInlineSize];
 };
 
 #if __GNUC__ >= 13
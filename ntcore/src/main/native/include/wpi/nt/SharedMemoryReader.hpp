@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "wpi/nt/NetworkTableValue.hpp"
+
+namespace wpi::nt {
+
+namespace net::shm {
+class Reader;
+}  // namespace net::shm
+
+/**
+ * Reads topic values from a shared memory segment published by a server on
+ * the same host (see NetworkTableInstance::SetServerSharedMemory).  Reads
+ * never block the server; a read that races with an update is retried.
+ *
+ * Only values are available; use a regular client to publish or to get topic
+ * properties.  If the server is restarted, the reader must be recreated.
+ *
+ * This class is thread safe.
+ */
+class SharedMemoryReader final {
+ public:
+  /**
+   * Opens a shared memory segment.
+   *
+   * @param name segment name
+   */
+  explicit SharedMemoryReader(std::string_view name);
+  ~SharedMemoryReader();
+
+  SharedMemoryReader(SharedMemoryReader&&);
+  SharedMemoryReader& operator=(SharedMemoryReader&&);
+
+  /**
+   * Determines if the segment is open and the server is still writing to it.
+   *
+   * @return True if valid
+   */
+  bool IsValid() const;
+
+  /**
+   * Gets the number of topics in the segment.  Topics are only added, so
+   * indices from 0 to this value are valid until the reader is recreated.
+   *
+   * @return Number of topics
+   */
+  int GetNumTopics() const;
+
+  /**
+   * Finds a topic by name.  This is a linear search; cache the result.
+   *
+   * @param name topic name
+   * @return Topic index, or -1 if not found
+   */
+  int FindTopic(std::string_view name) const;
+
+  /**
+   * Gets the name of a topic.
+   *
+   * @param index topic index
+   * @return Topic name, or empty string if the index is invalid
+   */
+  std::string_view GetTopicName(int index) const;
+
+  /**
+   * Gets the type string of a topic.
+   *
+   * @param index topic index
+   * @return Type string, or empty string if the index is invalid
+   */
+  std::string GetTopicTypeString(int index) const;
+
+  /**
+   * Gets the most recent value of a topic.
+   *
+   * @param index topic index
+   * @return Value, or nullopt if the topic has no value (e.g. is unpublished)
+   */
+  std::optional<Value> GetValue(int index) const;
+
+ private:
+  std::unique_ptr<net::shm::Reader> m_reader;
+};
+
+}  // namespace wpi::nt
@@ -1139,7 +1139,9 @@ void NT_StopLocal(NT_Inst inst);
  *
  * @param inst              instance handle
  * @param persist_filename  the name of the persist file to use (UTF-8 string,
- *                          null terminated)
+ *                          null terminated); if it ends in ".msgpack",
+ *                          values are saved in a compact binary format
+ *                          instead of JSON (either format is loaded)
  * @param listen_address    the address to listen on, or an empty string to
  *                          listen on any address. (UTF-8 string, null
  *                          terminated)
@@ -5,22 +5,31 @@
 #include "LocalStorage.hpp"
 
 #include <algorithm>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "ListenerStorage.hpp"
 #include "MockAssertions.hpp"
 #include "MockListenerStorage.hpp"
 #include "MockLogger.hpp"
 #include "TestPrinters.hpp"
+#include "net/ClientMessageQueue.hpp"
 #include "net/MockMessageHandler.hpp"
 #include "net/MockNetworkInterface.hpp"
+#include "wpi/datalog/DataLogReader.hpp"
+#include "wpi/datalog/DataLogWriter.hpp"
 #include "wpi/nt/ntcore_c.h"
 #include "wpi/nt/ntcore_cpp.hpp"
+#include "wpi/util/MemoryBuffer.hpp"
+#include "wpi/util/StringExtras.hpp"
+#include "wpi/util/raw_ostream.hpp"
 
 namespace wpi::nt {
 
@@ -1202,4 +1211,146 @@ TEST_CASE_METHOD(LocalStorageTest, "LocalStorageTest ReadQueueInitialRemote",
   CheckNetworkCounts(network, 0, 3, 0);
 }
 
+TEST_CASE("LocalStorageTest ConcurrentSetGet", "[ntcore][local-storage]") {
+  // no network, as the mock handler is not thread safe
+  wpi::MockLogger logger;
+  MockListenerStorage listenerStorage;
+  LocalStorage storage{0, listenerStorage, logger};
+
+  constexpr int kNumThreads = 4;
+  constexpr int kNumSets = 1000;
+  std::vector<NT_Publisher> pubs;
+  std::vector<NT_Subscriber> subs;
+  for (int i = 0; i < kNumThreads; ++i) {
+    auto topic = storage.GetTopic(std::string(1, 'a' + i));
+    pubs.emplace_back(storage.Publish(topic, NT_INTEGER, "int",
+                                      wpi::util::json::object(), {}));
+    subs.emplace_back(storage.Subscribe(topic, NT_INTEGER, "int",
+                                        {.pollStorage = kNumSets}));
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    // each thread sets its own topic and reads another one
+    threads.emplace_back([&, i] {
+      for (int j = 1; j <= kNumSets; ++j) {
+        storage.SetEntryValue(pubs[i], Value::MakeInteger(j, j));
+        storage.GetAtomic<int64_t>(subs[(i + 1) % kNumThreads], 0);
+      }
+    });
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < kNumThreads; ++i) {
+    INFO(i);
+    CHECK(storage.GetAtomic<int64_t>(subs[i], 0).value == kNumSets);
+    CHECK(storage.ReadQueue<int64_t>(subs[i]).size() ==
+          static_cast<size_t>(kNumSets));
+  }
+}
+
+TEST_CASE("LocalStorageTest ConcurrentSetListenersNetworkLog",
+          "[ntcore][local-storage]") {
+  // real (thread safe) listener storage and network queue, plus a data log
+  wpi::util::Logger logger;
+  ListenerStorage listenerStorage{0};
+  LocalStorage storage{0, listenerStorage, logger};
+  net::LocalClientMessageQueue network{logger};
+  storage.StartNetwork(&network);
+
+  std::vector<uint8_t> logData;
+  wpi::log::DataLogWriter log{
+      std::make_unique<wpi::util::raw_uvector_ostream>(logData)};
+  storage.StartDataLog(log, "", "NT:");
+
+  // callback listeners need a registered instance, so poll instead
+  auto poller = listenerStorage.CreateListenerPoller();
+  auto listener = listenerStorage.AddListener(poller);
+  std::string_view prefix = "";
+  storage.AddListener(listener, {&prefix, 1}, NT_EVENT_VALUE_ALL);
+
+  constexpr int kNumThreads = 4;
+  constexpr int kNumSets = 500;
+  // each thread sets its own topic and a topic shared by all threads
+  auto shared = storage.GetTopic("shared");
+  std::vector<NT_Publisher> ownPubs;
+  std::vector<NT_Publisher> sharedPubs;
+  for (int i = 0; i < kNumThreads; ++i) {
+    auto topic = storage.GetTopic(std::string(1, 'a' + i));
+    ownPubs.emplace_back(storage.Publish(topic, NT_INTEGER, "int",
+                                         wpi::util::json::object(), {}));
+    sharedPubs.emplace_back(storage.Publish(shared, NT_INTEGER, "int",
+                                            wpi::util::json::object(), {}));
+  }
+  network.ClearQueue();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 1; j <= kNumSets; ++j) {
+        // distinct values with the same timestamp, so no set is dropped as
+        // a duplicate or as older than the last value
+        storage.SetEntryValue(ownPubs[i], Value::MakeInteger(j, 1));
+        storage.SetEntryValue(sharedPubs[i],
+                              Value::MakeInteger(i * kNumSets + j, 1));
+      }
+    });
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  constexpr int kTotalSets = 2 * kNumThreads * kNumSets;
+  CHECK(listenerStorage.ReadListenerQueue(poller).size() ==
+        static_cast<size_t>(kTotalSets));
+
+  for (int i = 0; i < kNumThreads; ++i) {
+    INFO(i);
+    auto entry = storage.GetEntry(std::string(1, 'a' + i));
+    CHECK(storage.GetEntryValue(entry).GetInteger() == kNumSets);
+  }
+
+  // every set is queued for the network
+  int numNetworkSets = 0;
+  std::vector<net::ClientMessage> msgs(64);
+  for (;;) {
+    auto read = network.ReadQueue(msgs);
+    if (read.empty()) {
+      break;
+    }
+    for (auto&& msg : read) {
+      if (std::holds_alternative<net::ClientValueMsg>(msg.contents)) {
+        ++numNetworkSets;
+      }
+    }
+  }
+  CHECK(numNetworkSets == kTotalSets);
+
+  // and logged
+  log.Flush();
+  int numLogged = 0;
+  std::vector<int> logEntries;
+  wpi::log::DataLogReader reader{
+      wpi::util::MemoryBuffer::GetMemBuffer(logData, "concurrent")};
+  for (auto&& record : reader) {
+    wpi::log::StartRecordData start;
+    if (record.GetStartData(&start)) {
+      if (wpi::util::starts_with(start.name, "NT:")) {
+        logEntries.emplace_back(start.entry);
+      }
+    } else if (!record.IsControl() &&
+               std::find(logEntries.begin(), logEntries.end(),
+                         record.GetEntry()) != logEntries.end()) {
+      ++numLogged;
+    }
+  }
+  CHECK(numLogged == kTotalSets);
+
+  storage.RemoveListener(listener, NT_EVENT_VALUE_ALL);
+  storage.ClearNetwork();
+  CHECK(listenerStorage.DestroyListenerPoller(poller).size() == 1u);
+}
+
 }  // namespace wpi::nt
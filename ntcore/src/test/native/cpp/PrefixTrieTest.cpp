@@ -0,0 +1,105 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "PrefixTrie.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace wpi::nt {
+
+namespace {
+
+std::vector<int> Matches(const PrefixTrie<int>& trie, std::string_view name,
+                         bool special = false) {
+  std::vector<int> values;
+  trie.ForEachMatch(name, special, [&](int value) { values.push_back(value); });
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+std::vector<int> StartingWith(const PrefixTrie<int>& trie,
+                              std::string_view prefix) {
+  std::vector<int> values;
+  trie.ForEachStartingWith(prefix,
+                           [&](int value) { values.push_back(value); });
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("PrefixTrieTest Matches", "[ntcore][prefixtrie]") {
+  PrefixTrie<int> trie;
+  trie.Add("/foo/", true, 1);
+  trie.Add("/foo/bar", true, 2);
+  trie.Add("/foo/bar", false, 3);
+  trie.Add("/fob", true, 4);
+  trie.Add("", true, 5);
+
+  CHECK(Matches(trie, "/foo/bar") == std::vector{1, 2, 3, 5});
+  CHECK(Matches(trie, "/foo/barbaz") == std::vector{1, 2, 5});
+  CHECK(Matches(trie, "/foo/ba") == std::vector{1, 5});
+  CHECK(Matches(trie, "/fo") == std::vector{5});
+  CHECK(Matches(trie, "/fob/x") == std::vector{4, 5});
+  CHECK(Matches(trie, "") == std::vector{5});
+}
+
+TEST_CASE("PrefixTrieTest EmptyPrefixSpecial", "[ntcore][prefixtrie]") {
+  PrefixTrie<int> trie;
+  trie.Add("", true, 1);
+  trie.Add("$", true, 2);
+  trie.Add("$sub$foo", false, 3);
+
+  CHECK(Matches(trie, "$sub$foo", true) == std::vector{2, 3});
+  CHECK(Matches(trie, "$sub$foo", false) == std::vector{1, 2, 3});
+}
+
+TEST_CASE("PrefixTrieTest StartingWith", "[ntcore][prefixtrie]") {
+  PrefixTrie<int> trie;
+  trie.Add("/foo/bar", false, 1);
+  trie.Add("/foo/baz", false, 2);
+  trie.Add("/foo", false, 3);
+  trie.Add("/qux", false, 4);
+
+  CHECK(StartingWith(trie, "") == std::vector{1, 2, 3, 4});
+  CHECK(StartingWith(trie, "/foo") == std::vector{1, 2, 3});
+  CHECK(StartingWith(trie, "/foo/") == std::vector{1, 2});
+  // ends partway along an edge
+  CHECK(StartingWith(trie, "/foo/ba") == std::vector{1, 2});
+  CHECK(StartingWith(trie, "/foo/bar") == std::vector{1});
+  CHECK(StartingWith(trie, "/foo/bax").empty());
+  CHECK(StartingWith(trie, "/z").empty());
+}
+
+TEST_CASE("PrefixTrieTest Remove", "[ntcore][prefixtrie]") {
+  PrefixTrie<int> trie;
+  trie.Add("/foo/bar", true, 1);
+  trie.Add("/foo/baz", true, 2);
+  trie.Add("/foo/bar", true, 3);
+
+  // must match the key and prefix flag it was added with
+  CHECK_FALSE(trie.Remove("/foo/bar", false, 1));
+  CHECK_FALSE(trie.Remove("/foo/ba", true, 1));
+  CHECK_FALSE(trie.Remove("/foo/bar", true, 2));
+
+  CHECK(trie.Remove("/foo/bar", true, 1));
+  CHECK(Matches(trie, "/foo/bar") == std::vector{3});
+  CHECK(trie.Remove("/foo/baz", true, 2));
+  CHECK(Matches(trie, "/foo/bar") == std::vector{3});
+  CHECK(Matches(trie, "/foo/baz").empty());
+
+  // re-adding after the edges were merged splits them again
+  trie.Add("/foo/baz", true, 2);
+  CHECK(Matches(trie, "/foo/baz") == std::vector{2});
+
+  CHECK(trie.Remove("/foo/bar", true, 3));
+  CHECK(trie.Remove("/foo/baz", true, 2));
+  CHECK(trie.empty());
+}
+
+}  // namespace wpi::nt
@@ -4,9 +4,16 @@
 
 #include "wpi/nt/Topic.hpp"
 
+#include <stdint.h>
+
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include "wpi/nt/DoubleArrayTopic.hpp"
 #include "wpi/nt/NetworkTableInstance.hpp"
+#include "wpi/nt/RawTopic.hpp"
+#include "wpi/util/AllocationCounter.hpp"
 
 class TopicTest {
  public:
@@ -61,3 +68,38 @@ TEST_CASE_METHOD(TopicTest, "TopicTest UserDataInvalidTopic",
 
   CHECK(nullptr == topic.GetUserData());
 }
+
+TEST_CASE_METHOD(TopicTest, "TopicTest PublisherSetReusesStorage",
+                 "[ntcore][topic]") {
+  auto pub = m_inst.GetDoubleArrayTopic("foo").Publish();
+  auto rawPub = m_inst.GetRawTopic("bar").Publish("raw");
+  std::vector<double> arr(16);
+  std::vector<uint8_t> raw(56);
+  std::vector<double> longer(32);
+
+  // fill the publishers' buffer pools
+  for (int i = 0; i < 3; ++i) {
+    pub.Set(arr);
+    rawPub.Set(raw);
+  }
+
+  size_t count = wpi::util::GetAllocationCount();
+  for (int i = 0; i < 100; ++i) {
+    arr[0] = i;
+    pub.Set(arr);
+    raw[0] = i;
+    rawPub.Set(raw);
+  }
+  CHECK(wpi::util::GetAllocationCount() == count);
+
+  // a different size needs new storage (if allocations are counted)
+  count = wpi::util::GetAllocationCount();
+  pub.Set(longer);
+  CHECK((count == 0 || wpi::util::GetAllocationCount() > count));
+  pub.Set(arr);
+
+  auto sub = m_inst.GetDoubleArrayTopic("foo").Subscribe({});
+  CHECK(sub.Get()[0] == 99);
+  auto rawSub = m_inst.GetRawTopic("bar").Subscribe("raw", {});
+  CHECK(rawSub.Get()[0] == 99);
+}
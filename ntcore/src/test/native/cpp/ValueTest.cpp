@@ -13,6 +13,7 @@
 #include "TestPrinters.hpp"
 #include "Value_internal.hpp"
 #include "wpi/nt/NetworkTableValue.hpp"
+#include "wpi/util/AllocationCounter.hpp"
 #include "wpi/util/string.hpp"
 
 using namespace std::string_view_literals;
@@ -445,4 +446,57 @@ TEST_CASE("ValueTest StringArrayComparison", "[ntcore][value]") {
   REQUIRE(v1 == v2);
 }
 
+TEST_CASE("ValueTest InlineCopy", "[ntcore][value]") {
+  std::vector<double> expectedArr{0.5, 1.5, 2.5};
+  std::vector<uint8_t> expectedRaw{1, 2, 3};
+  auto str = Value::MakeString("short");
+  auto arr = Value::MakeDoubleArray({0.5, 1.5, 2.5});
+  auto raw = Value::MakeRaw(std::vector<uint8_t>{1, 2, 3});
+  CHECK(str.size() == 0u);
+  CHECK(arr.size() == 0u);
+  CHECK(raw.size() == 0u);
+
+  // copies point at their own data
+  std::vector<Value> copies{str, arr, raw};
+  str = Value{};
+  arr = Value::MakeDoubleArray({1.0});
+  raw = Value::MakeRaw(std::vector<uint8_t>{4});
+  copies.reserve(100);
+  CHECK(copies[0].GetString() == "short");
+  CHECK(copies[0].value().data.v_string.str[5] == '\0');
+  CHECK(copies[1].GetDoubleArray() == std::span{expectedArr});
+  CHECK(copies[2].GetRaw() == std::span{expectedRaw});
+
+  Value moved{std::move(copies[1])};
+  copies.clear();
+  CHECK(moved.GetDoubleArray() == std::span{expectedArr});
+  CHECK(moved == Value::MakeDoubleArray({0.5, 1.5, 2.5}));
+}
+
+TEST_CASE("ValueTest InlineDoesNotAllocate", "[ntcore][value]") {
+  std::string_view shortStr = "0123456789";
+  std::vector<double> shortArr{1.0, 2.0, 3.0};
+  std::vector<int> shortBool{1, 0, 1, 0};
+
+  size_t count = wpi::util::GetAllocationCount();
+  {
+    auto str = Value::MakeString(shortStr, 1);
+    auto arr = Value::MakeDoubleArray(shortArr, 1);
+    auto boolArr = Value::MakeBooleanArray(shortBool, 1);
+    Value copy = str;
+    copy = arr;
+  }
+  CHECK(wpi::util::GetAllocationCount() == count);
+
+  // longer values are allocated and shared by copies
+  auto str = Value::MakeString(std::string(Value::kInlineSize, 'x'), 1);
+  auto arr = Value::MakeDoubleArray(std::vector<double>(4), 1);
+  CHECK(str.size() > 0u);
+  CHECK(arr.size() == 4 * sizeof(double));
+  count = wpi::util::GetAllocationCount();
+  Value copy = arr;
+  CHECK(wpi::util::GetAllocationCount() == count);
+  CHECK(copy.GetDoubleArray().data() == arr.GetDoubleArray().data());
+}
+
 }  // namespace wpi::nt
@@ -474,4 +474,49 @@ TEST_CASE("NetworkOutgoingQueueTest LocalQueueSendsImmediately",
   CHECK(wire.binaryWrites.empty());
 }
 
+TEST_CASE("NetworkOutgoingQueueTest SharedEncodingSentToEachQueue",
+          "[ntcore][network-outgoing-queue]") {
+  RecordingWireConnection wire1;
+  RecordingWireConnection wire2;
+  NetworkOutgoingQueue<ServerMessage> queue1{wire1, false};
+  NetworkOutgoingQueue<ServerMessage> queue2{wire2, false};
+
+  auto value = Value::MakeDouble(1.0, 10);
+  SharedValueEncoding encoding{3, value};
+  queue1.SendValue(3, value, ValueSendMode::kNormal, encoding.Get());
+  queue2.SendValue(3, value, ValueSendMode::kImm, encoding.Get());
+  // encoded once, and still referenced by the first queue
+  CHECK(encoding.Get().use_count() == 2);
+
+  queue1.SendOutgoing(5, true);
+
+  REQUIRE(wire1.binaryWrites.size() == 1u);
+  REQUIRE(wire2.binarySends.size() == 1u);
+  CHECK(wire1.binaryWrites[0] == *encoding.Get());
+  CHECK(wire2.binarySends[0] == *encoding.Get());
+  auto [id, decoded] = DecodeBinary(wire1.binaryWrites[0]);
+  CHECK(id == 3);
+  CHECK(decoded.time() == 10);
+  CHECK(decoded.GetDouble() == 1.0);
+}
+
+TEST_CASE("NetworkOutgoingQueueTest NormalValueReplacesSharedEncoding",
+          "[ntcore][network-outgoing-queue]") {
+  RecordingWireConnection wire;
+  NetworkOutgoingQueue<ServerMessage> queue{wire, false};
+
+  auto value = Value::MakeDouble(1.0, 10);
+  SharedValueEncoding encoding{3, value};
+  queue.SendValue(3, value, ValueSendMode::kNormal, encoding.Get());
+  queue.SendValue(3, Value::MakeDouble(2.0, 20), ValueSendMode::kNormal);
+  CHECK(encoding.Get().use_count() == 1);
+
+  queue.SendOutgoing(5, true);
+
+  REQUIRE(wire.binaryWrites.size() == 1u);
+  auto [id, decoded] = DecodeBinary(wire.binaryWrites[0]);
+  CHECK(id == 3);
+  CHECK(decoded.GetDouble() == 2.0);
+}
+
 }  // namespace wpi::nt::net
@@ -0,0 +1,190 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "net/SharedMemory.hpp"
+
+#include <stdint.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+#include <format>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../TestPrinters.hpp"
+#include "wpi/nt/NetworkTableValue.hpp"
+#include "wpi/util/timestamp.hpp"
+
+#ifndef _WIN32
+
+namespace wpi::nt {
+
+static std::string GetTestName() {
+  return std::format("/ntcore_test_{}", wpi::util::Now());
+}
+
+TEST_CASE("SharedMemoryTest RoundTrip", "[ntcore][net]") {
+  std::vector<Value> values{
+      Value::MakeBoolean(true, 1),
+      Value::MakeInteger(-5, 2),
+      Value::MakeFloat(2.5f, 3),
+      Value::MakeDouble(1.25, 4),
+      Value::MakeString("hello", 5),
+      Value::MakeRaw(std::vector<uint8_t>{1, 2, 3}, 6),
+      Value::MakeBooleanArray({true, false, true}, 7),
+      Value::MakeIntegerArray({1, 2, 3}, 8),
+      Value::MakeFloatArray({1.5f, 2.5f}, 9),
+      Value::MakeDoubleArray({0.5, 1.5, 2.5}, 10),
+      Value::MakeStringArray({"a", "", "bcd"}, 11),
+  };
+
+  std::string name = GetTestName();
+  std::error_code ec;
+  auto writer = net::shm::Writer::Create(name, 16384, 16, false, ec);
+  REQUIRE(writer);
+
+  net::shm::Reader reader{name};
+  REQUIRE(reader.IsValid());
+  CHECK(reader.GetNumTopics() == 0);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    int index = writer->Announce(std::format("t{}", i), "type");
+    REQUIRE(index == static_cast<int>(i));
+    CHECK_FALSE(reader.GetValue(index));
+    values[i].SetServerTime(100 + i);
+    CHECK(writer->SetValue(index, values[i]));
+  }
+
+  REQUIRE(reader.GetNumTopics() == static_cast<int>(values.size()));
+  for (size_t i = 0; i < values.size(); ++i) {
+    INFO(i);
+    CHECK(reader.GetTopicName(i) == std::format("t{}", i));
+    CHECK(reader.GetTopicTypeString(i) == "type");
+    auto value = reader.GetValue(i);
+    REQUIRE(value);
+    CHECK(*value == values[i]);
+    CHECK(value->time() == values[i].time());
+    CHECK(value->server_time() == values[i].server_time());
+  }
+
+  writer.reset();
+  CHECK_FALSE(reader.IsValid());
+}
+
+TEST_CASE("SharedMemoryTest Update", "[ntcore][net]") {
+  std::string name = GetTestName();
+  std::error_code ec;
+  auto writer = net::shm::Writer::Create(name, 4096, 4, false, ec);
+  REQUIRE(writer);
+  net::shm::Reader reader{name};
+
+  int index = writer->Announce("str", "string");
+  REQUIRE(index == 0);
+
+  // grows the data block
+  CHECK(writer->SetValue(index, Value::MakeString("a")));
+  CHECK(writer->SetValue(index, Value::MakeString(std::string(100, 'b'))));
+  CHECK(reader.GetValue(index) == Value::MakeString(std::string(100, 'b')));
+
+  // unannounce clears the value; reannounce reuses the slot
+  writer->Unannounce(index);
+  CHECK_FALSE(reader.GetValue(index));
+  CHECK(writer->Announce("str", "raw") == index);
+  CHECK(reader.GetTopicTypeString(index) == "raw");
+
+  // out of heap space
+  CHECK_FALSE(writer->SetValue(index, Value::MakeRaw(std::vector<uint8_t>(
+                                          8192, 0))));
+}
+
+TEST_CASE("SharedMemoryTest TooManyTopics", "[ntcore][net]") {
+  std::string name = GetTestName();
+  std::error_code ec;
+  auto writer = net::shm::Writer::Create(name, 4096, 2, false, ec);
+  REQUIRE(writer);
+  CHECK(writer->Announce("a", "double") == 0);
+  CHECK(writer->Announce("b", "double") == 1);
+  CHECK(writer->Announce("c", "double") == -1);
+  CHECK(writer->Announce("a", "double") == 0);
+}
+
+TEST_CASE("SharedMemoryTest InUse", "[ntcore][net]") {
+  std::string name = GetTestName();
+  std::error_code ec;
+  auto writer = net::shm::Writer::Create(name, 4096, 4, false, ec);
+  REQUIRE(writer);
+
+  // only readable by the same user
+  int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  REQUIRE(fd >= 0);
+  struct stat st;
+  REQUIRE(::fstat(fd, &st) == 0);
+  ::close(fd);
+  CHECK((st.st_mode & 0777) == 0600);
+
+  // a segment with a live writer is not replaced
+  CHECK_FALSE(net::shm::Writer::Create(name, 4096, 4, false, ec));
+  CHECK(ec == std::errc::file_exists);
+  net::shm::Reader reader{name};
+  CHECK(reader.IsValid());
+}
+
+TEST_CASE("SharedMemoryTest Stale", "[ntcore][net]") {
+  // get the ID of a process that no longer exists
+  pid_t pid = ::fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    ::_exit(0);
+  }
+  REQUIRE(::waitpid(pid, nullptr, 0) == pid);
+
+  // segment left behind by a writer that exited without removing it
+  std::string name = GetTestName();
+  int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  REQUIRE(fd >= 0);
+  REQUIRE(::ftruncate(fd, 4096) == 0);
+  void* base =
+      ::mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  REQUIRE(base != MAP_FAILED);
+  auto header = static_cast<net::shm::Header*>(base);
+  std::memcpy(header->magic, net::shm::kMagic, sizeof(net::shm::kMagic));
+  header->version = net::shm::kVersion;
+  header->ownerPid = pid;
+  ::munmap(base, 4096);
+
+  std::error_code ec;
+  auto writer = net::shm::Writer::Create(name, 4096, 4, false, ec);
+  REQUIRE(writer);
+  CHECK(writer->Announce("a", "double") == 0);
+  net::shm::Reader reader{name};
+  CHECK(reader.GetNumTopics() == 1);
+}
+
+TEST_CASE("SharedMemoryTest Invalid", "[ntcore][net]") {
+  net::shm::Reader reader{GetTestName()};
+  CHECK_FALSE(reader.IsValid());
+  CHECK(reader.GetNumTopics() == 0);
+  CHECK_FALSE(reader.GetValue(0));
+
+  std::error_code ec;
+  CHECK_FALSE(net::shm::Writer::Create(GetTestName(), 64, 16, false, ec));
+  CHECK(ec == std::errc::invalid_argument);
+}
+
+}  // namespace wpi::nt
+
+#endif
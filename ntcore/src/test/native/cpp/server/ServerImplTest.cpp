@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <concepts>
+#include <format>
 #include <functional>
 #include <span>
 #include <string>
@@ -26,8 +27,10 @@
 #include "Handle.hpp"
 #include "net/Message.hpp"
 #include "net/WireEncoder.hpp"
+#include "wpi/nt/SharedMemoryReader.hpp"
 #include "wpi/nt/ntcore_c.h"
 #include "wpi/nt/ntcore_cpp.hpp"
+#include "wpi/util/timestamp.hpp"
 
 namespace wpi::nt {
 namespace {
@@ -603,4 +606,49 @@ TEST_CASE_METHOD(ServerImplTest,
   CHECK(wire.writeTextCalls.empty());
 }
 
+#ifndef _WIN32
+TEST_CASE_METHOD(ServerImplTest, "ServerImplTest SharedMemory",
+                 "[ntcore][server]") {
+  server.SetLocal(&local, &queue);
+  constexpr int pubuid = 1;
+
+  // value published before the segment is started
+  queue.msgs.emplace_back(net::ClientMessage{net::PublishMsg{
+      pubuid, "test", "double", wpi::util::json::object(), {}}});
+  queue.msgs.emplace_back(net::ClientMessage{
+      net::ClientValueMsg{pubuid, Value::MakeDouble(1.0, 10)}});
+  CHECK_FALSE(server.ProcessLocalMessages(UINT_MAX));
+
+  std::string name = std::format("/ntcore_server_test_{}", wpi::util::Now());
+  REQUIRE(server.StartSharedMemory(name, 65536, 16, false));
+  SharedMemoryReader reader{name};
+  REQUIRE(reader.IsValid());
+  int index = reader.FindTopic("test");
+  REQUIRE(index != -1);
+  CHECK(reader.GetTopicTypeString(index) == "double");
+  CHECK(reader.GetValue(index) == Value::MakeDouble(1.0));
+
+  // value and topic published after
+  queue.msgs.emplace_back(net::ClientMessage{
+      net::ClientValueMsg{pubuid, Value::MakeDouble(2.0, 20)}});
+  queue.msgs.emplace_back(net::ClientMessage{net::PublishMsg{
+      pubuid + 1, "test2", "string", wpi::util::json::object(), {}}});
+  queue.msgs.emplace_back(net::ClientMessage{
+      net::ClientValueMsg{pubuid + 1, Value::MakeString("hi", 30)}});
+  CHECK_FALSE(server.ProcessLocalMessages(UINT_MAX));
+  auto value = reader.GetValue(index);
+  REQUIRE(value);
+  CHECK(*value == Value::MakeDouble(2.0));
+  CHECK(value->time() == 20);
+  int index2 = reader.FindTopic("test2");
+  REQUIRE(index2 != -1);
+  CHECK(reader.GetValue(index2) == Value::MakeString("hi"));
+
+  // unpublish clears the value
+  queue.msgs.emplace_back(net::ClientMessage{net::UnpublishMsg{pubuid}});
+  CHECK_FALSE(server.ProcessLocalMessages(UINT_MAX));
+  CHECK_FALSE(reader.GetValue(index));
+}
+#endif
+
 }  // namespace wpi::nt
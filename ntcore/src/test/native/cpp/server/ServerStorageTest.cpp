@@ -0,0 +1,141 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "server/ServerStorage.hpp"
+
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../MockLogger.hpp"
+#include "wpi/nt/NetworkTableValue.hpp"
+#include "wpi/util/json.hpp"
+#include "wpi/util/raw_ostream.hpp"
+
+namespace wpi::nt {
+
+namespace {
+
+constexpr std::string_view kPersistentJson = R"([
+  {
+    "name": "/boolean",
+    "type": "boolean",
+    "value": true,
+    "properties": {"persistent": true}
+  },
+  {
+    "name": "/int",
+    "type": "int",
+    "value": 42,
+    "properties": {"persistent": true, "retained": true}
+  },
+  {
+    "name": "/double[]",
+    "type": "double[]",
+    "value": [0.5, 1.5, 2.5],
+    "properties": {"persistent": true}
+  },
+  {
+    "name": "/string[]",
+    "type": "string[]",
+    "value": ["a", "b"],
+    "properties": {"persistent": true}
+  },
+  {
+    "name": "/json",
+    "type": "json",
+    "value": "{}",
+    "properties": {"persistent": true}
+  },
+  {
+    "name": "/raw",
+    "type": "raw",
+    "value": "AQID",
+    "properties": {"persistent": true}
+  }
+])";
+
+class ServerStorageTest {
+ public:
+  server::ServerStorage MakeStorage() {
+    return server::ServerStorage{logger, [](auto, auto) {}};
+  }
+
+  static std::string Dump(server::ServerStorage& storage) {
+    std::string rv;
+    wpi::util::raw_string_ostream os{rv};
+    storage.DumpPersistent(os);
+    os.flush();
+    return rv;
+  }
+
+  static std::string DumpBinary(server::ServerStorage& storage) {
+    std::string rv;
+    wpi::util::raw_string_ostream os{rv};
+    storage.DumpPersistentBinary(os);
+    os.flush();
+    return rv;
+  }
+
+  wpi::MockLogger logger;
+};
+
+}  // namespace
+
+TEST_CASE_METHOD(ServerStorageTest, "ServerStorageTest PersistentBinary",
+                 "[ntcore][server]") {
+  auto storage = MakeStorage();
+  REQUIRE(storage.LoadPersistent(kPersistentJson).empty());
+  auto json = Dump(storage);
+  auto binary = DumpBinary(storage);
+  CHECK(binary.size() < json.size());
+
+  // both formats load to the same topics and values
+  auto fromBinary = MakeStorage();
+  REQUIRE(fromBinary.LoadPersistent(binary).empty());
+  CHECK(Dump(fromBinary) == json);
+  CHECK(DumpBinary(fromBinary) == binary);
+  CHECK_FALSE(fromBinary.PersistentChanged());
+}
+
+TEST_CASE_METHOD(ServerStorageTest,
+                 "ServerStorageTest PersistentBinaryChanged",
+                 "[ntcore][server]") {
+  auto storage = MakeStorage();
+  REQUIRE(storage.LoadPersistent(kPersistentJson).empty());
+  DumpBinary(storage);
+
+  storage.SetValue(nullptr, storage.GetTopic("/int"), Value::MakeInteger(7));
+  storage.SetProperties(nullptr, storage.GetTopic("/boolean"),
+                        wpi::util::json::object("foo", "bar"));
+  CHECK(storage.PersistentChanged());
+
+  auto reloaded = MakeStorage();
+  REQUIRE(reloaded.LoadPersistent(DumpBinary(storage)).empty());
+  CHECK(Dump(reloaded) == Dump(storage));
+  auto topic = reloaded.GetTopic("/int");
+  REQUIRE(topic);
+  CHECK(topic->lastValue.GetInteger() == 7);
+  topic = reloaded.GetTopic("/boolean");
+  REQUIRE(topic);
+  CHECK(topic->properties.lookup("foo"));
+}
+
+TEST_CASE_METHOD(ServerStorageTest,
+                 "ServerStorageTest PersistentBinaryTruncated",
+                 "[ntcore][server]") {
+  auto storage = MakeStorage();
+  REQUIRE(storage.LoadPersistent(kPersistentJson).empty());
+  auto binary = DumpBinary(storage);
+
+  // records before the truncated one are still loaded
+  auto truncated = MakeStorage();
+  auto in = std::string_view{binary}.substr(0, binary.size() - 2);
+  CHECK_FALSE(truncated.LoadPersistent(in).empty());
+  CHECK(truncated.GetTopic("/boolean"));
+  CHECK_FALSE(truncated.GetTopic("/raw"));
+}
+
+}  // namespace wpi::nt
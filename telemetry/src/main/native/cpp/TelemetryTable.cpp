@@ -292,6 +292,142 @@ void TelemetryTable::Log(std::string_view name, std::span<const uint8_t> value,
   entry->LogRaw(value, typeString);
 }
 
+void TelemetryTable::Log(Key& key, bool value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogBoolean(value);
+}
+
+void TelemetryTable::Log(Key& key, int8_t value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogInt8(value);
+}
+
+void TelemetryTable::Log(Key& key, int16_t value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogInt16(value);
+}
+
+void TelemetryTable::Log(Key& key, int32_t value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogInt32(value);
+}
+
+void TelemetryTable::Log(Key& key, int64_t value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogInt64(value);
+}
+
+void TelemetryTable::Log(Key& key, float value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogFloat(value);
+}
+
+void TelemetryTable::Log(Key& key, double value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogDouble(value);
+}
+
+void TelemetryTable::Log(Key& key, std::string_view value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogString(value, "string");
+}
+
+void TelemetryTable::Log(Key& key, std::span<const bool> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogBooleanArray(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const int16_t> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogInt16Array(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const int32_t> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogInt32Array(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const int64_t> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogInt64Array(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const float> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogFloatArray(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const double> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogDoubleArray(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const std::string> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogStringArray(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const std::string_view> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogStringArray(value);
+}
+
+void TelemetryTable::Log(Key& key, std::span<const uint8_t> value) {
+  auto& entry = GetEntry(key);
+  if (entry->IsDiscard()) {
+    return;
+  }
+  entry->LogRaw(value, "raw");
+}
+
 TelemetryTable::EntryHandle TelemetryTable::GetEntry(std::string_view name) {
   return GetEntry(name, nullptr);
 }
@@ -344,6 +480,18 @@ TelemetryTable::EntryHandle TelemetryTable::GetEntry(std::string_view name,
   }
 }
 
+const TelemetryTable::EntryHandle& TelemetryTable::GetEntry(Key& key) {
+  // The cached entry records the reset generation it was created in, so an
+  // entry resolved concurrently with a reset is never mistaken for current.
+  if (key.m_table != this || !key.m_entry ||
+      key.m_entry.m_entry->resetGeneration !=
+          m_resetGeneration.load(std::memory_order_acquire)) {
+    key.m_entry = GetEntry(key.m_name);
+    key.m_table = this;
+  }
+  return key.m_entry;
+}
+
 bool TelemetryTable::ShouldLogTableValue(std::string_view name) {
   auto entry = GetEntry(name);
   if (!entry->IsDiscard()) {
@@ -393,5 +541,5 @@ void TelemetryTable::Reset() {
   m_type.clear();
   m_hasNonDiscardDescendant = false;
   m_hasNonDiscardDescendantCached = false;
-  ++m_resetGeneration;
+  m_resetGeneration.fetch_add(1, std::memory_order_release);
 }
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <exception>
 #include <format>
 #include <initializer_list>
@@ -95,6 +96,8 @@ class TelemetryTable final {
     };
 
    public:
+    EntryHandle() = default;
+
     /** Checks if this handle is non-empty. */
     explicit operator bool() const { return static_cast<bool>(m_entry); }
 
@@ -128,6 +131,38 @@ class TelemetryTable final {
   };
 
  public:
+  /**
+   * Cached reference to a named value in a table.  Logging through a key
+   * skips the name lookup and table lock after the first call; the key is
+   * re-resolved automatically after a TelemetryRegistry reset or backend
+   * change, or if it is used with a different table.
+   *
+   * Keys are not thread safe; each thread should use its own key.
+   */
+  class Key {
+    friend class TelemetryTable;
+
+   public:
+    /**
+     * Constructs a key.
+     *
+     * @param name the name
+     */
+    explicit Key(std::string_view name) : m_name{name} {}
+
+    /**
+     * Gets the name.
+     *
+     * @return name
+     */
+    std::string_view GetName() const { return m_name; }
+
+   private:
+    std::string m_name;
+    const TelemetryTable* m_table = nullptr;
+    EntryHandle m_entry;
+  };
+
   /**
    * Constructs a telemetry table. Only usable internally.
    *
@@ -625,6 +660,154 @@ class TelemetryTable final {
   void Log(std::string_view name, std::span<const uint8_t> value,
            std::string_view typeString);
 
+  /**
+   * Logs an object.
+   *
+   * @param key the key
+   * @param value the value
+   * @param info type parameters for struct serializer (optional)
+   */
+  template <typename T, typename... I>
+  void Log(Key& key, const T& value, I... info) {
+    Log(std::string_view{key.m_name}, value, info...);
+  }
+
+  /**
+   * Logs a boolean.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, bool value);
+
+  /**
+   * Logs a byte.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, int8_t value);
+
+  /**
+   * Logs a short.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, int16_t value);
+
+  /**
+   * Logs an int.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, int32_t value);
+
+  /**
+   * Logs a long.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, int64_t value);
+
+  /**
+   * Logs a float.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, float value);
+
+  /**
+   * Logs a double.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, double value);
+
+  /**
+   * Logs a String.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::string_view value);
+
+  /**
+   * Logs a boolean array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const bool> value);
+
+  /**
+   * Logs a short array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const int16_t> value);
+
+  /**
+   * Logs an int array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const int32_t> value);
+
+  /**
+   * Logs a long array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const int64_t> value);
+
+  /**
+   * Logs a float array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const float> value);
+
+  /**
+   * Logs a double array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const double> value);
+
+  /**
+   * Logs a String array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const std::string> value);
+
+  /**
+   * Logs a String array.
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const std::string_view> value);
+
+  /**
+   * Logs a raw value (byte array).
+   *
+   * @param key the key
+   * @param value the value
+   */
+  void Log(Key& key, std::span<const uint8_t> value);
+
   /**
    * Returns whether a table-valued object should be expanded for logging.
    * Returns false when the entry for name discards data and no registered
@@ -646,6 +829,15 @@ class TelemetryTable final {
 
   EntryHandle GetEntry(std::string_view name, bool* metadataApplied);
 
+  /**
+   * Gets the cached telemetry entry for a key, re-resolving it if the table
+   * has been reset since it was cached.
+   *
+   * @param key key
+   * @return entry
+   */
+  const EntryHandle& GetEntry(Key& key);
+
   bool HasNonDiscardDescendant();
 
   void TypeMismatch(std::string_view expectedType, std::string_view typeString);
@@ -711,7 +903,7 @@ class TelemetryTable final {
   std::string m_type;
   bool m_hasNonDiscardDescendant = false;
   bool m_hasNonDiscardDescendantCached = false;
-  uint64_t m_resetGeneration = 0;
+  std::atomic<uint64_t> m_resetGeneration = 0;
 };
 
 }  // namespace wpi::telemetry
@@ -1031,6 +1031,61 @@ TEST_CASE_METHOD(TelemetryTableTest, "TelemetryTableTest ResetClearsTableTypes",
   REQUIRE(typeValue.value == "TestStructLoggableType");
 }
 
+TEST_CASE_METHOD(TelemetryTableTest, "TelemetryTableTest LogByKey",
+                 "[telemetry]") {
+  auto& table = wpi::telemetry::TelemetryRegistry::GetTable("/keyed/");
+  wpi::telemetry::TelemetryTable::Key speed{"speed"};
+  wpi::telemetry::TelemetryTable::Key name{"name"};
+  wpi::telemetry::TelemetryTable::Key values{"values"};
+  REQUIRE(speed.GetName() == "speed");
+
+  table.Log(speed, 1.5);
+  table.Log(speed, 2.5);
+  table.Log(name, std::string_view{"left"});
+  std::array<int64_t, 2> arr{1, 2};
+  table.Log(values, std::span<const int64_t>{arr});
+  table.Log(values, std::vector<int64_t>{3, 4, 5});
+
+  REQUIRE(mock->GetLastValue<double>("/keyed/speed") == 2.5);
+  REQUIRE(Last<wpi::telemetry::MockTelemetryBackend::LogStringValue>(
+              "/keyed/name")
+              .value == "left");
+  REQUIRE(mock->GetLastValue<std::vector<int64_t>>("/keyed/values") ==
+          std::vector<int64_t>{3, 4, 5});
+
+  // the same key can be used with another table
+  auto& other = wpi::telemetry::TelemetryRegistry::GetTable("/other/");
+  other.Log(speed, 3.5);
+  REQUIRE(mock->GetLastValue<double>("/other/speed") == 3.5);
+  REQUIRE(mock->GetLastValue<double>("/keyed/speed") == 2.5);
+}
+
+TEST_CASE_METHOD(TelemetryTableTest,
+                 "TelemetryTableTest LogByKeyResolvesAfterReset",
+                 "[telemetry]") {
+  auto& table = wpi::telemetry::TelemetryRegistry::GetTable("/keyed/");
+  wpi::telemetry::TelemetryTable::Key speed{"speed"};
+  table.Log(speed, 1.0);
+  REQUIRE(mock->GetLastValue<double>("/keyed/speed") == 1.0);
+
+  // rerouting the entry resets the table, so the key must follow
+  auto replacement = std::make_shared<wpi::telemetry::MockTelemetryBackend>();
+  wpi::telemetry::TelemetryRegistry::RegisterBackend("/keyed", replacement);
+  table.Log(speed, 2.0);
+  REQUIRE(replacement->GetLastValue<double>("/keyed/speed") == 2.0);
+
+  wpi::telemetry::TelemetryRegistry::Reset();
+  wpi::telemetry::TelemetryRegistry::RegisterBackend(
+      "", std::make_shared<wpi::telemetry::DiscardTelemetryBackend>());
+  table.Log(speed, 3.0);
+  REQUIRE(replacement->GetLastValue<double>("/keyed/speed") != 3.0);
+  REQUIRE(mock->GetLastValue<double>("/keyed/speed") != 3.0);
+
+  wpi::telemetry::TelemetryRegistry::RegisterBackend("", mock);
+  table.Log(speed, 4.0);
+  REQUIRE(mock->GetLastValue<double>("/keyed/speed") == 4.0);
+}
+
 TEST_CASE_METHOD(
     TelemetryTableTest,
     "TelemetryTableTest "
@@ -0,0 +1,730 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ColumnarExport.hpp"
+
+#include <stdint.h>
+
+#include <bit>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "wpi/datalog/DataLogReaderThread.hpp"
+#include "wpi/util/DenseMap.hpp"
+#include "wpi/util/Endian.hpp"
+#include "wpi/util/SpanExtras.hpp"
+#include "wpi/util/StringExtras.hpp"
+#include "wpi/util/StringMap.hpp"
+#include "wpi/util/raw_ostream.hpp"
+#include "wpi/util/struct/DynamicStruct.hpp"
+
+using wpi::util::StructDescriptor;
+using wpi::util::StructFieldDescriptor;
+using wpi::util::StructFieldType;
+
+static constexpr std::string_view kMagic = "WPILOGCF";
+static constexpr uint16_t kVersion = 0x0100;
+
+// flush a table once this many bytes of row data are buffered
+static constexpr size_t kBlockSize = 64 * 1024;
+
+namespace {
+
+using ValueType = ColumnarValueType;
+
+enum class BlockKind : uint8_t { kRows = 1, kDictionary = 2 };
+
+struct Column {
+  Column(std::string_view name, ValueType type, bool list)
+      : name{name}, type{type}, list{list} {}
+
+  std::string name;
+  ValueType type;
+  bool list;
+
+  // for struct entries, the fields (and array indices) leading from the
+  // entry's struct to this value
+  std::vector<std::pair<const StructFieldDescriptor*, size_t>> path;
+
+  // buffered data for the current block
+  std::vector<uint8_t> values;
+  std::vector<uint32_t> lengths;
+
+  // string dictionary; pendingDict holds keys not yet written to the file
+  wpi::util::StringMap<uint32_t> dict;
+  std::vector<std::string_view> pendingDict;
+};
+
+struct Table {
+  uint32_t id;
+  std::string name;
+  std::string type;
+  std::string metadata;
+
+  // fixed element size for entries copied directly from record data; 0 for
+  // strings, string arrays, structs, and packed entries
+  size_t elemSize = 0;
+  // true for packed entries, which hold many samples per record
+  bool packed = false;
+  // non-null for struct and struct array entries
+  const StructDescriptor* desc = nullptr;
+
+  std::vector<Column> columns;
+  std::vector<int64_t> timestamps;
+  size_t bufferedSize = 0;
+};
+
+struct BlockInfo {
+  uint64_t offset;
+  BlockKind kind;
+  uint32_t table;
+};
+
+class ColumnarWriter {
+ public:
+  explicit ColumnarWriter(wpi::util::raw_ostream& os);
+
+  Table* AddTable(const wpi::log::StartRecordData& data,
+                  const wpi::util::StructDescriptorDatabase& structDb);
+  void Append(Table& table, const wpi::log::DataLogRecord& record);
+  void Finish();
+
+ private:
+  void AppendPacked(Table& table, const wpi::log::DataLogRecord& record);
+  void EndRow(Table& table, int64_t timestamp);
+
+  void Flush(Table& table);
+  void WriteBlock(BlockKind kind, uint32_t table);
+
+  wpi::util::raw_ostream& m_os;
+  uint64_t m_pos = 0;
+  std::vector<std::unique_ptr<Table>> m_tables;
+  std::vector<BlockInfo> m_blocks;
+  std::vector<uint8_t> m_buf;
+  std::vector<int64_t> m_packedTimestamps;
+  std::vector<int64_t> m_packedIntegers;
+  std::vector<double> m_packedDoubles;
+};
+}  // namespace
+
+template <typename T>
+static void AppendLE(std::vector<uint8_t>& buf, T val) {
+  size_t pos = buf.size();
+  buf.resize(pos + sizeof(T));
+  wpi::util::support::endian::write<T, std::endian::little>(buf.data() + pos,
+                                                           val);
+}
+
+static void AppendStr(std::vector<uint8_t>& buf, std::string_view str) {
+  AppendLE<uint32_t>(buf, str.size());
+  buf.insert(buf.end(), str.begin(), str.end());
+}
+
+static void AppendDictString(Column& column, std::string_view str) {
+  auto [it, inserted] = column.dict.try_emplace(str, column.dict.size());
+  if (inserted) {
+    column.pendingDict.emplace_back(it->first);
+  }
+  AppendLE<uint32_t>(column.values, it->second);
+}
+
+static ValueType GetFieldValueType(const StructFieldDescriptor& field) {
+  switch (field.GetType()) {
+    case StructFieldType::BOOL:
+      return ValueType::kBoolean;
+    case StructFieldType::CHAR:
+      return ValueType::kString;
+    case StructFieldType::INT8:
+      return ValueType::kInt8;
+    case StructFieldType::INT16:
+      return ValueType::kInt16;
+    case StructFieldType::INT32:
+      return ValueType::kInt32;
+    case StructFieldType::INT64:
+      return ValueType::kInt64;
+    case StructFieldType::UINT8:
+      return ValueType::kUint8;
+    case StructFieldType::UINT16:
+      return ValueType::kUint16;
+    case StructFieldType::UINT32:
+      return ValueType::kUint32;
+    case StructFieldType::UINT64:
+      return ValueType::kUint64;
+    case StructFieldType::FLOAT:
+      return ValueType::kFloat;
+    default:
+      return ValueType::kDouble;
+  }
+}
+
+// adds one column per leaf field of desc
+static void AddStructColumns(
+    Table& table, const StructDescriptor& desc, std::string_view prefix,
+    std::vector<std::pair<const StructFieldDescriptor*, size_t>>& path,
+    bool list) {
+  for (auto&& field : desc.GetFields()) {
+    // char arrays are a single string value
+    size_t count = field.GetType() == StructFieldType::CHAR
+                       ? 1
+                       : field.GetArraySize();
+    for (size_t i = 0; i < count; ++i) {
+      std::string name{prefix};
+      name += field.GetName();
+      if (count > 1) {
+        name += '[';
+        name += std::to_string(i);
+        name += ']';
+      }
+      path.emplace_back(&field, i);
+      if (field.GetType() == StructFieldType::STRUCT) {
+        name += '/';
+        AddStructColumns(table, *field.GetStruct(), name, path, list);
+      } else {
+        auto& column =
+            table.columns.emplace_back(name, GetFieldValueType(field), list);
+        column.path = path;
+      }
+      path.pop_back();
+    }
+  }
+}
+
+static void AppendStructValue(Column& column,
+                              const wpi::util::DynamicStruct& root) {
+  wpi::util::DynamicStruct ds = root;
+  for (auto&& [field, index] : wpi::util::drop_back(std::span{column.path})) {
+    ds = ds.GetStructField(field, index);
+  }
+  auto [field, index] = column.path.back();
+  switch (column.type) {
+    case ValueType::kBoolean:
+      AppendLE<uint8_t>(column.values, ds.GetBoolField(field, index) ? 1 : 0);
+      break;
+    case ValueType::kString:
+      AppendDictString(column, ds.GetStringField(field));
+      break;
+    case ValueType::kInt8:
+      AppendLE<int8_t>(column.values, ds.GetIntField(field, index));
+      break;
+    case ValueType::kInt16:
+      AppendLE<int16_t>(column.values, ds.GetIntField(field, index));
+      break;
+    case ValueType::kInt32:
+      AppendLE<int32_t>(column.values, ds.GetIntField(field, index));
+      break;
+    case ValueType::kInt64:
+      AppendLE<int64_t>(column.values, ds.GetIntField(field, index));
+      break;
+    case ValueType::kUint8:
+      AppendLE<uint8_t>(column.values, ds.GetUintField(field, index));
+      break;
+    case ValueType::kUint16:
+      AppendLE<uint16_t>(column.values, ds.GetUintField(field, index));
+      break;
+    case ValueType::kUint32:
+      AppendLE<uint32_t>(column.values, ds.GetUintField(field, index));
+      break;
+    case ValueType::kUint64:
+      AppendLE<uint64_t>(column.values, ds.GetUintField(field, index));
+      break;
+    case ValueType::kFloat:
+      AppendLE<uint32_t>(column.values, std::bit_cast<uint32_t>(
+                                            ds.GetFloatField(field, index)));
+      break;
+    case ValueType::kDouble:
+      AppendLE<uint64_t>(column.values, std::bit_cast<uint64_t>(
+                                            ds.GetDoubleField(field, index)));
+      break;
+  }
+}
+
+ColumnarWriter::ColumnarWriter(wpi::util::raw_ostream& os) : m_os{os} {
+  m_buf.assign(kMagic.begin(), kMagic.end());
+  AppendLE<uint16_t>(m_buf, kVersion);
+  m_os << m_buf;
+  m_pos += m_buf.size();
+}
+
+Table* ColumnarWriter::AddTable(
+    const wpi::log::StartRecordData& data,
+    const wpi::util::StructDescriptorDatabase& structDb) {
+  auto& table = *m_tables.emplace_back(std::make_unique<Table>());
+  table.id = m_tables.size() - 1;
+  table.name = data.name;
+  table.type = data.type;
+  table.metadata = data.metadata;
+
+  auto addValue = [&](ValueType type, size_t elemSize, bool list) {
+    table.elemSize = elemSize;
+    table.columns.emplace_back("value", type, list);
+  };
+
+  std::string_view type = data.type;
+  bool isArray = wpi::util::ends_with(type, "[]");
+  if (isArray) {
+    type.remove_suffix(2);
+  }
+  if (type == "double") {
+    addValue(ValueType::kDouble, 8, isArray);
+  } else if (type == "float") {
+    addValue(ValueType::kFloat, 4, isArray);
+  } else if (type == "int64" || type == "int") {
+    // support "int" for compatibility with old NT4 datalogs
+    addValue(ValueType::kInt64, 8, isArray);
+  } else if (type == "boolean") {
+    addValue(ValueType::kBoolean, 1, isArray);
+  } else if (type == "string" || (type == "json" && !isArray)) {
+    addValue(ValueType::kString, 0, isArray);
+  } else if ((type == "packed:int64" || type == "packed:double") &&
+             !isArray) {
+    table.packed = true;
+    table.columns.emplace_back("value",
+                               type == "packed:int64" ? ValueType::kInt64
+                                                      : ValueType::kDouble,
+                               false);
+  } else if (auto structName = wpi::util::remove_prefix(type, "struct:")) {
+    auto desc = structDb.Find(*structName);
+    if (desc && desc->IsValid() && desc->GetSize() != 0) {
+      table.desc = desc;
+      std::vector<std::pair<const StructFieldDescriptor*, size_t>> path;
+      AddStructColumns(table, *desc, "", path, isArray);
+    }
+  }
+
+  // export anything else as raw bytes
+  if (table.columns.empty()) {
+    addValue(ValueType::kUint8, 1, true);
+  }
+  return &table;
+}
+
+void ColumnarWriter::Append(Table& table,
+                            const wpi::log::DataLogRecord& record) {
+  if (table.packed) {
+    AppendPacked(table, record);
+    return;
+  }
+
+  auto data = record.GetRaw();
+  if (table.elemSize != 0) {
+    // fixed size values are stored in the log in the same layout as here
+    auto& column = table.columns.front();
+    if (column.list) {
+      if (data.size() % table.elemSize != 0) {
+        return;
+      }
+      column.lengths.emplace_back(data.size() / table.elemSize);
+    } else if (data.size() != table.elemSize) {
+      return;
+    }
+    column.values.insert(column.values.end(), data.begin(), data.end());
+    table.bufferedSize += data.size();
+  } else if (table.desc) {
+    size_t structSize = table.desc->GetSize();
+    size_t count = 1;
+    if (table.columns.front().list) {
+      if (data.size() % structSize != 0) {
+        return;
+      }
+      count = data.size() / structSize;
+    } else if (data.size() < structSize) {
+      return;
+    }
+    for (auto&& column : table.columns) {
+      size_t oldSize = column.values.size();
+      if (column.list) {
+        column.lengths.emplace_back(count);
+      }
+      for (size_t i = 0; i < count; ++i) {
+        wpi::util::DynamicStruct ds{table.desc, data.subspan(i * structSize)};
+        AppendStructValue(column, ds);
+      }
+      table.bufferedSize += column.values.size() - oldSize;
+    }
+  } else {
+    auto& column = table.columns.front();
+    size_t oldSize = column.values.size();
+    if (column.list) {
+      std::vector<std::string_view> arr;
+      if (!record.GetStringArray(&arr)) {
+        return;
+      }
+      column.lengths.emplace_back(arr.size());
+      for (auto&& str : arr) {
+        AppendDictString(column, str);
+      }
+    } else {
+      std::string_view str;
+      record.GetString(&str);
+      AppendDictString(column, str);
+    }
+    table.bufferedSize += column.values.size() - oldSize;
+  }
+
+  EndRow(table, record.GetTimestamp());
+}
+
+void ColumnarWriter::AppendPacked(Table& table,
+                                  const wpi::log::DataLogRecord& record) {
+  auto& column = table.columns.front();
+  if (column.type == ValueType::kInt64) {
+    if (!record.GetPackedIntegers(&m_packedTimestamps, &m_packedIntegers)) {
+      return;
+    }
+    for (size_t i = 0; i < m_packedTimestamps.size(); ++i) {
+      AppendLE<int64_t>(column.values, m_packedIntegers[i]);
+      table.bufferedSize += sizeof(int64_t);
+      EndRow(table, m_packedTimestamps[i]);
+    }
+  } else {
+    if (!record.GetPackedDoubles(&m_packedTimestamps, &m_packedDoubles)) {
+      return;
+    }
+    for (size_t i = 0; i < m_packedTimestamps.size(); ++i) {
+      AppendLE<uint64_t>(column.values,
+                         std::bit_cast<uint64_t>(m_packedDoubles[i]));
+      table.bufferedSize += sizeof(double);
+      EndRow(table, m_packedTimestamps[i]);
+    }
+  }
+}
+
+void ColumnarWriter::EndRow(Table& table, int64_t timestamp) {
+  table.timestamps.emplace_back(timestamp);
+  table.bufferedSize += sizeof(int64_t);
+  if (table.bufferedSize >= kBlockSize ||
+      table.timestamps.size() == std::numeric_limits<uint32_t>::max()) {
+    Flush(table);
+  }
+}
+
+void ColumnarWriter::Flush(Table& table) {
+  if (table.timestamps.empty()) {
+    return;
+  }
+
+  // dictionary entries first, so a reader streaming the file has them before
+  // the rows that refer to them
+  for (uint32_t i = 0; i < table.columns.size(); ++i) {
+    auto& column = table.columns[i];
+    if (column.pendingDict.empty()) {
+      continue;
+    }
+    m_buf.clear();
+    AppendLE<uint32_t>(m_buf, i);
+    AppendLE<uint32_t>(m_buf, column.dict.size() - column.pendingDict.size());
+    AppendLE<uint32_t>(m_buf, column.pendingDict.size());
+    for (auto&& str : column.pendingDict) {
+      AppendStr(m_buf, str);
+    }
+    WriteBlock(BlockKind::kDictionary, table.id);
+    column.pendingDict.clear();
+  }
+
+  m_buf.clear();
+  AppendLE<uint32_t>(m_buf, table.timestamps.size());
+  for (auto&& timestamp : table.timestamps) {
+    AppendLE<int64_t>(m_buf, timestamp);
+  }
+  for (auto&& column : table.columns) {
+    for (auto&& length : column.lengths) {
+      AppendLE<uint32_t>(m_buf, length);
+    }
+    m_buf.insert(m_buf.end(), column.values.begin(), column.values.end());
+    column.values.clear();
+    column.lengths.clear();
+  }
+  WriteBlock(BlockKind::kRows, table.id);
+  table.timestamps.clear();
+  table.bufferedSize = 0;
+}
+
+void ColumnarWriter::WriteBlock(BlockKind kind, uint32_t table) {
+  m_blocks.emplace_back(m_pos, kind, table);
+  uint8_t header[13];
+  header[0] = static_cast<uint8_t>(kind);
+  wpi::util::support::endian::write32le(header + 1, table);
+  wpi::util::support::endian::write64le(header + 5, m_buf.size());
+  m_os << std::span<const uint8_t>{header};
+  m_os << m_buf;
+  m_pos += sizeof(header) + m_buf.size();
+}
+
+void ColumnarWriter::Finish() {
+  for (auto&& table : m_tables) {
+    Flush(*table);
+  }
+
+  uint64_t footerPos = m_pos;
+  m_buf.clear();
+  AppendLE<uint32_t>(m_buf, m_tables.size());
+  for (auto&& table : m_tables) {
+    AppendStr(m_buf, table->name);
+    AppendStr(m_buf, table->type);
+    AppendStr(m_buf, table->metadata);
+    AppendLE<uint32_t>(m_buf, table->columns.size());
+    for (auto&& column : table->columns) {
+      AppendStr(m_buf, column.name);
+      AppendLE<uint8_t>(m_buf, static_cast<uint8_t>(column.type));
+      AppendLE<uint8_t>(m_buf, column.list ? 1 : 0);
+    }
+  }
+  AppendLE<uint32_t>(m_buf, m_blocks.size());
+  for (auto&& block : m_blocks) {
+    AppendLE<uint64_t>(m_buf, block.offset);
+    AppendLE<uint8_t>(m_buf, static_cast<uint8_t>(block.kind));
+    AppendLE<uint32_t>(m_buf, block.table);
+  }
+  AppendLE<uint64_t>(m_buf, footerPos);
+  m_buf.insert(m_buf.end(), kMagic.begin(), kMagic.end());
+  m_os << m_buf;
+  m_pos += m_buf.size();
+}
+
+void ExportColumnarFile(
+    wpi::log::DataLogReaderThread& datalog,
+    wpi::util::function_ref<bool(std::string_view name)> selected,
+    wpi::util::raw_ostream& os) {
+  ColumnarWriter writer{os};
+  wpi::util::StringMap<Table*> tables;
+  wpi::util::DenseMap<int, Table*> entryMap;
+  for (auto&& record : datalog.GetReader()) {
+    if (record.IsStart()) {
+      wpi::log::StartRecordData data;
+      if (record.GetStartData(&data) && selected(data.name)) {
+        auto& table = tables[data.name];
+        if (!table) {
+          table = writer.AddTable(data, datalog.GetStructDatabase());
+        }
+        entryMap[data.entry] = table;
+      }
+    } else if (record.IsFinish()) {
+      int entry;
+      if (record.GetFinishEntry(&entry)) {
+        entryMap.erase(entry);
+      }
+    } else if (!record.IsControl()) {
+      auto it = entryMap.find(record.GetEntry());
+      if (it != entryMap.end()) {
+        writer.Append(*it->second, record);
+      }
+    }
+  }
+  writer.Finish();
+}
+
+size_t GetColumnarValueSize(ColumnarValueType type) {
+  switch (type) {
+    case ValueType::kBoolean:
+    case ValueType::kInt8:
+    case ValueType::kUint8:
+      return 1;
+    case ValueType::kInt16:
+    case ValueType::kUint16:
+      return 2;
+    case ValueType::kInt32:
+    case ValueType::kUint32:
+    case ValueType::kFloat:
+    case ValueType::kString:
+      return 4;
+    default:
+      return 8;
+  }
+}
+
+namespace {
+// bounds-checked little endian reads from a byte span
+class ByteReader {
+ public:
+  explicit ByteReader(std::span<const uint8_t> data) : m_data{data} {}
+
+  bool empty() const { return m_data.empty(); }
+
+  template <typename T>
+  bool Read(T* val) {
+    if (m_data.size() < sizeof(T)) {
+      return false;
+    }
+    *val = wpi::util::support::endian::read<T, std::endian::little>(
+        m_data.data());
+    m_data = m_data.subspan(sizeof(T));
+    return true;
+  }
+
+  bool ReadBytes(uint64_t size, std::span<const uint8_t>* bytes) {
+    if (m_data.size() < size) {
+      return false;
+    }
+    *bytes = m_data.subspan(0, size);
+    m_data = m_data.subspan(size);
+    return true;
+  }
+
+  bool ReadStr(std::string* str) {
+    uint32_t size;
+    std::span<const uint8_t> bytes;
+    if (!Read(&size) || !ReadBytes(size, &bytes)) {
+      return false;
+    }
+    str->assign(bytes.begin(), bytes.end());
+    return true;
+  }
+
+ private:
+  std::span<const uint8_t> m_data;
+};
+}  // namespace
+
+static bool ReadDictionaryBlock(ByteReader& in, ColumnarTable& table) {
+  uint32_t index, first, count;
+  if (!in.Read(&index) || !in.Read(&first) || !in.Read(&count) ||
+      index >= table.columns.size()) {
+    return false;
+  }
+  auto& dictionary = table.columns[index].dictionary;
+  if (first != dictionary.size()) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    if (!in.ReadStr(&dictionary.emplace_back())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool ReadRowsBlock(ByteReader& in, ColumnarTable& table) {
+  uint32_t rows;
+  if (!in.Read(&rows)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < rows; ++i) {
+    if (!in.Read(&table.timestamps.emplace_back())) {
+      return false;
+    }
+  }
+  for (auto&& column : table.columns) {
+    uint64_t count = rows;
+    if (column.list) {
+      count = 0;
+      for (uint32_t i = 0; i < rows; ++i) {
+        if (!in.Read(&column.lengths.emplace_back())) {
+          return false;
+        }
+        count += column.lengths.back();
+      }
+    }
+    size_t valueSize = GetColumnarValueSize(column.type);
+    std::span<const uint8_t> values;
+    if (count > std::numeric_limits<uint64_t>::max() / valueSize ||
+        !in.ReadBytes(count * valueSize, &values)) {
+      return false;
+    }
+    if (column.type == ValueType::kString) {
+      // every id must have been defined by a preceding dictionary block
+      for (size_t i = 0; i < values.size(); i += valueSize) {
+        if (wpi::util::support::endian::read32le(values.data() + i) >=
+            column.dictionary.size()) {
+          return false;
+        }
+      }
+    }
+    column.values.insert(column.values.end(), values.begin(), values.end());
+  }
+  return true;
+}
+
+bool ReadColumnarFile(std::span<const uint8_t> data,
+                      std::vector<ColumnarTable>* tables) {
+  tables->clear();
+  size_t headerSize = kMagic.size() + sizeof(uint16_t);
+  size_t trailerSize = sizeof(uint64_t) + kMagic.size();
+  if (data.size() < headerSize + trailerSize ||
+      std::string_view{reinterpret_cast<const char*>(data.data()),
+                       kMagic.size()} != kMagic ||
+      wpi::util::support::endian::read16le(data.data() + kMagic.size()) !=
+          kVersion ||
+      std::string_view{reinterpret_cast<const char*>(data.data() +
+                                                     data.size() -
+                                                     kMagic.size()),
+                       kMagic.size()} != kMagic) {
+    return false;
+  }
+  uint64_t footerPos = wpi::util::support::endian::read64le(
+      data.data() + data.size() - trailerSize);
+  if (footerPos < headerSize || footerPos > data.size() - trailerSize) {
+    return false;
+  }
+
+  ByteReader footer{
+      data.subspan(footerPos, data.size() - trailerSize - footerPos)};
+  uint32_t numTables;
+  if (!footer.Read(&numTables)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numTables; ++i) {
+    auto& table = tables->emplace_back();
+    uint32_t numColumns;
+    if (!footer.ReadStr(&table.name) || !footer.ReadStr(&table.type) ||
+        !footer.ReadStr(&table.metadata) || !footer.Read(&numColumns)) {
+      return false;
+    }
+    for (uint32_t j = 0; j < numColumns; ++j) {
+      auto& column = table.columns.emplace_back();
+      uint8_t type, list;
+      if (!footer.ReadStr(&column.name) || !footer.Read(&type) ||
+          !footer.Read(&list) ||
+          type > static_cast<uint8_t>(ValueType::kString)) {
+        return false;
+      }
+      column.type = static_cast<ValueType>(type);
+      column.list = list != 0;
+    }
+  }
+
+  uint32_t numBlocks;
+  if (!footer.Read(&numBlocks)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numBlocks; ++i) {
+    uint64_t offset;
+    uint8_t kind, kind2;
+    uint32_t table, table2;
+    uint64_t size;
+    if (!footer.Read(&offset) || !footer.Read(&kind) || !footer.Read(&table) ||
+        offset < headerSize || offset > footerPos) {
+      return false;
+    }
+    // blocks may not extend into the footer
+    ByteReader block{data.subspan(offset, footerPos - offset)};
+    std::span<const uint8_t> payload;
+    if (!block.Read(&kind2) || !block.Read(&table2) || !block.Read(&size) ||
+        kind != kind2 || table != table2 || table >= tables->size() ||
+        !block.ReadBytes(size, &payload)) {
+      return false;
+    }
+    ByteReader in{payload};
+    bool ok;
+    switch (static_cast<BlockKind>(kind)) {
+      case BlockKind::kRows:
+        ok = ReadRowsBlock(in, (*tables)[table]);
+        break;
+      case BlockKind::kDictionary:
+        ok = ReadDictionaryBlock(in, (*tables)[table]);
+        break;
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok || !in.empty()) {
+      return false;
+    }
+  }
+  return footer.empty();
+}
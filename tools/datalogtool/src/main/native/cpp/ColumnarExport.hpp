@@ -0,0 +1,134 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "wpi/util/function_ref.hpp"
+
+namespace wpi::log {
+class DataLogReaderThread;
+}  // namespace wpi::log
+
+namespace wpi::util {
+class raw_ostream;
+}  // namespace wpi::util
+
+/**
+ * Exports a data log in a column-oriented binary format. The format is
+ * specified in datalog/doc/columnar.adoc.
+ *
+ * Each selected entry becomes a table with an int64 timestamp column
+ * (integer microseconds) and one typed column per value. Scalar and array
+ * entries have a single "value" column; struct entries are flattened into
+ * one column per leaf field, named by field path (e.g. "rotation/value").
+ * Packed entries are expanded to one row per sample. Strings are dictionary
+ * encoded. Values that fail to decode are skipped.
+ *
+ * The file is written in a single pass. Rows are buffered per table and
+ * flushed as blocks once a table's buffer fills, so memory use is bounded by
+ * the number of tables and the string dictionaries, not by the log size.
+ *
+ * All integers are little endian. Strings (str) are a uint32 length
+ * followed by UTF-8 bytes. The layout is:
+ *
+ * - Header: "WPILOGCF" magic, uint16 version (0x0100)
+ * - Blocks: uint8 kind, uint32 table, uint64 payload length, payload
+ *   - kind 1 (rows): uint32 row count N, int64[N] timestamps, then for each
+ *     column in table order: uint32[N] lengths if the column is a list, then
+ *     the values (N values, or the sum of the lengths for lists)
+ *   - kind 2 (dictionary): uint32 column index within the table, uint32
+ *     first id, uint32 count, then count str; always precedes the first rows
+ *     block that uses them
+ * - Footer: uint32 table count; per table: str name, str type, str metadata,
+ *   uint32 column count, then per column: str name, uint8 value type,
+ *   uint8 list flag. Then uint32 block count; per block: uint64 file offset,
+ *   uint8 kind, uint32 table.
+ * - Trailer: uint64 footer offset, "WPILOGCF" magic
+ *
+ * Value types: 0 bool (1 byte), 1-4 int8/16/32/64, 5-8 uint8/16/32/64,
+ * 9 float, 10 double, 11 string (uint32 dictionary id). Raw and unknown
+ * entry types are exported as a list of uint8.
+ *
+ * @param datalog data log
+ * @param selected returns true if the named entry should be exported
+ * @param os output stream
+ */
+void ExportColumnarFile(
+    wpi::log::DataLogReaderThread& datalog,
+    wpi::util::function_ref<bool(std::string_view name)> selected,
+    wpi::util::raw_ostream& os);
+
+/**
+ * Value types of columnar export file columns.
+ */
+enum class ColumnarValueType : uint8_t {
+  kBoolean = 0,
+  kInt8,
+  kInt16,
+  kInt32,
+  kInt64,
+  kUint8,
+  kUint16,
+  kUint32,
+  kUint64,
+  kFloat,
+  kDouble,
+  kString
+};
+
+/**
+ * Gets the size in bytes of a single value of a type as stored in a columnar
+ * export file. Strings are stored as a uint32 dictionary id.
+ *
+ * @param type value type
+ * @return size in bytes
+ */
+size_t GetColumnarValueSize(ColumnarValueType type);
+
+/**
+ * A column read from a columnar export file.
+ */
+struct ColumnarColumn {
+  std::string name;
+  ColumnarValueType type;
+  bool list;
+
+  /** Values of all rows, little endian, in row order. */
+  std::vector<uint8_t> values;
+
+  /** Number of values in each row; empty if not a list column. */
+  std::vector<uint32_t> lengths;
+
+  /** String dictionary, indexed by the ids stored in values. */
+  std::vector<std::string> dictionary;
+};
+
+/**
+ * A table read from a columnar export file.
+ */
+struct ColumnarTable {
+  std::string name;
+  std::string type;
+  std::string metadata;
+  std::vector<int64_t> timestamps;
+  std::vector<ColumnarColumn> columns;
+};
+
+/**
+ * Reads a file written by ExportColumnarFile(). The blocks listed in the
+ * footer are read in order and concatenated per table.
+ *
+ * @param data file contents
+ * @param tables tables (output)
+ * @return False if the file is truncated or malformed
+ */
+bool ReadColumnarFile(std::span<const uint8_t> data,
+                      std::vector<ColumnarTable>* tables);
@@ -17,6 +17,7 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include <imgui_stdlib.h>
 
 #include "App.hpp"
+#include "ColumnarExport.hpp"
 #include "wpi/datalog/DataLogReaderThread.hpp"
 #include "wpi/glass/Storage.hpp"
 #include "wpi/gui/portable-file-dialogs.h"
@@ -197,8 +199,10 @@ static std::unique_ptr<InputFile> LoadDataLog(std::string_view filename) {
     return std::make_unique<InputFile>(filename, "Not a valid datalog file");
   }
 
+  // scan the log using all cores
   return std::make_unique<InputFile>(
-      std::make_unique<wpi::log::DataLogReaderThread>(std::move(reader)));
+      std::make_unique<wpi::log::DataLogReaderThread>(
+          std::move(reader), std::thread::hardware_concurrency()));
 }
 
 void DisplayInputFiles() {
@@ -561,6 +565,9 @@ static void ExportCsvFile(InputFile& f, wpi::util::raw_ostream& os, int style) {
   }
 
   wpi::util::DenseMap<int, Entry*> nameMap;
+  std::vector<int64_t> packedTimestamps;
+  std::vector<int64_t> packedIntegers;
+  std::vector<double> packedDoubles;
   for (auto&& record : f.datalog->GetReader()) {
     if (record.IsStart()) {
       wpi::log::StartRecordData data;
@@ -581,33 +588,65 @@ static void ExportCsvFile(InputFile& f, wpi::util::raw_ostream& os, int style) {
         continue;
       }
       Entry* entry = entryIt->second;
+      if (style == 1 && entry->column == -1) {
+        continue;
+      }
 
-      if (style == 0) {
-        wpi::util::print(os, "{},\"", record.GetTimestamp() / 1000000.0);
-        PrintEscapedCsvString(os, entry->name);
-        os << '"' << ',';
-        ValueToCsv(os, *entry, record);
-        os << '\n';
-      } else if (style == 1 && entry->column != -1) {
-        wpi::util::print(os, "{},", record.GetTimestamp() / 1000000.0);
-        for (int i = 0; i < entry->column; ++i) {
-          os << ',';
+      auto printRow = [&](int64_t timestamp, auto&& printValue) {
+        if (style == 0) {
+          wpi::util::print(os, "{},\"", timestamp / 1000000.0);
+          PrintEscapedCsvString(os, entry->name);
+          os << '"' << ',';
+        } else {
+          wpi::util::print(os, "{},", timestamp / 1000000.0);
+          for (int i = 0; i < entry->column; ++i) {
+            os << ',';
+          }
         }
-        ValueToCsv(os, *entry, record);
+        printValue();
         os << '\n';
+      };
+
+      // packed records hold many samples; output one row per sample
+      if (entry->type == "packed:int64" &&
+          record.GetPackedIntegers(&packedTimestamps, &packedIntegers)) {
+        for (size_t i = 0; i < packedTimestamps.size(); ++i) {
+          printRow(packedTimestamps[i],
+                   [&] { wpi::util::print(os, "{}", packedIntegers[i]); });
+        }
+      } else if (entry->type == "packed:double" &&
+                 record.GetPackedDoubles(&packedTimestamps, &packedDoubles)) {
+        for (size_t i = 0; i < packedTimestamps.size(); ++i) {
+          printRow(packedTimestamps[i],
+                   [&] { wpi::util::print(os, "{}", packedDoubles[i]); });
+        }
+      } else {
+        printRow(record.GetTimestamp(),
+                 [&] { ValueToCsv(os, *entry, record); });
       }
     }
   }
 }
 
-static void ExportCsv(std::string_view outputFolder, int style) {
+static void Export(std::string_view outputFolder, int format, int style) {
   fs::path outPath{outputFolder};
   for (auto&& f : gInputFiles) {
     if (f.second->datalog) {
+      // the struct schemas used for columnar export are only complete once
+      // the file has been fully read
+      if (format == 1 && !f.second->datalog->IsDone()) {
+        std::scoped_lock lock{gExportMutex};
+        gExportErrors.emplace_back(
+            std::format("{}: still loading, try again", f.first));
+        ++gExportCount;
+        continue;
+      }
+      auto flags = format == 0 ? fs::OF_Text : fs::OF_None;
       std::error_code ec;
       auto of = fs::OpenFileForWrite(
-          outPath / fs::path{f.first}.replace_extension("csv"), ec,
-          fs::CD_CreateNew, fs::OF_Text);
+          outPath / fs::path{f.first}.replace_extension(
+                        format == 0 ? "csv" : "wpicol"),
+          ec, fs::CD_CreateNew, flags);
       if (ec) {
         std::scoped_lock lock{gExportMutex};
         gExportErrors.emplace_back(
@@ -615,8 +654,18 @@ static void ExportCsv(std::string_view outputFolder, int style) {
         ++gExportCount;
         continue;
       }
-      wpi::util::raw_fd_ostream os{fs::FileToFd(of, ec, fs::OF_Text), true};
-      ExportCsvFile(*f.second, os, style);
+      wpi::util::raw_fd_ostream os{fs::FileToFd(of, ec, flags), true};
+      if (format == 0) {
+        ExportCsvFile(*f.second, os, style);
+      } else {
+        ExportColumnarFile(
+            *f.second->datalog,
+            [](std::string_view name) {
+              auto it = gEntries.find(name);
+              return it != gEntries.end() && it->second->selected;
+            },
+            os);
+      }
     }
     ++gExportCount;
   }
@@ -635,20 +684,34 @@ void DisplayOutput(wpi::glass::Storage& storage) {
     }
     ImGui::TextUnformatted(outputFolder.c_str());
 
+    static const char* const formats[] = {"CSV", "Columnar"};
+    static int format = 0;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+    ImGui::Combo("Format", &format, formats,
+                 sizeof(formats) / sizeof(const char*));
+    if (ImGui::IsItemHovered()) {
+      ImGui::SetTooltip(
+          "Columnar writes one typed column per entry (struct fields are\n"
+          "flattened) to a .wpicol binary file for analysis tools");
+    }
+
     static const char* const options[] = {"List", "Table"};
     static int style = 0;
-    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
-    ImGui::Combo("Style", &style, options,
-                 sizeof(options) / sizeof(const char*));
+    if (format == 0) {
+      ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+      ImGui::Combo("Style", &style, options,
+                   sizeof(options) / sizeof(const char*));
+    }
 
     static std::future<void> exporter;
     if (!gInputFiles.empty() && !outputFolder.empty() &&
-        ImGui::Button("Export CSV") &&
+        ImGui::Button(format == 0 ? "Export CSV" : "Export Columnar") &&
         (gExportCount == 0 ||
          gExportCount == static_cast<int>(gInputFiles.size()))) {
       gExportCount = 0;
       gExportErrors.clear();
-      exporter = std::async(std::launch::async, ExportCsv, outputFolder, style);
+      exporter = std::async(std::launch::async, Export, outputFolder, format,
+                            style);
     }
     if (exporter.valid()) {
       ImGui::SameLine();
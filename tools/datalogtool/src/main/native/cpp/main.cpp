@@ -4,6 +4,8 @@
 
 #include <string_view>
 
+#ifndef RUNNING_DATALOGTOOL_TESTS
+
 void Application(std::string_view saveDir);
 
 #ifdef _WIN32
@@ -23,3 +25,5 @@ int main(int argc, char** argv) {
 
   return 0;
 }
+
+#endif
@@ -0,0 +1,233 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ColumnarExport.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "wpi/datalog/DataLogReader.hpp"
+#include "wpi/datalog/DataLogReaderThread.hpp"
+#include "wpi/datalog/DataLogWriter.hpp"
+#include "wpi/util/Endian.hpp"
+#include "wpi/util/MemoryBuffer.hpp"
+#include "wpi/util/raw_ostream.hpp"
+
+namespace {
+
+constexpr int kNumStrings = 12000;
+
+std::vector<uint8_t> MakeLog() {
+  std::vector<uint8_t> output;
+  wpi::log::DataLogWriter writer{
+      std::make_unique<wpi::util::raw_uvector_ostream>(output)};
+  writer.AddSchema("struct:Inner", "structschema",
+                   std::string_view{"double x;double y"}, 1);
+  writer.AddSchema("struct:Outer", "structschema",
+                   std::string_view{"Inner pos;int16 id[2];char name[4];"
+                                    "bool flag"},
+                   1);
+
+  int d = writer.Start("double", "double", "meta", 2);
+  writer.AppendDouble(d, 1.5, 10);
+  writer.AppendDouble(d, -2.0, 20);
+
+  int ia = writer.Start("intarr", "int64[]", {}, 2);
+  writer.AppendIntegerArray(ia, std::vector<int64_t>{1, 2, 3}, 10);
+  writer.AppendIntegerArray(ia, {}, 20);
+
+  int sa = writer.Start("strarr", "string[]", {}, 2);
+  writer.AppendStringArray(sa, std::vector<std::string>{"x", "a"}, 10);
+  writer.AppendStringArray(sa, std::vector<std::string>{"a", "a", "y"}, 20);
+
+  auto makeOuter = [](double x, double y, int16_t id0, int16_t id1,
+                      std::string_view name, bool flag) {
+    uint8_t buf[25] = {};
+    wpi::util::support::endian::write64le(buf, std::bit_cast<uint64_t>(x));
+    wpi::util::support::endian::write64le(buf + 8,
+                                          std::bit_cast<uint64_t>(y));
+    wpi::util::support::endian::write16le(buf + 16, id0);
+    wpi::util::support::endian::write16le(buf + 18, id1);
+    std::copy(name.begin(), name.end(), buf + 20);
+    buf[24] = flag ? 1 : 0;
+    return std::vector<uint8_t>(std::begin(buf), std::end(buf));
+  };
+  int st = writer.Start("struct", "struct:Outer", {}, 2);
+  writer.AppendRaw(st, makeOuter(1.0, 2.0, 3, -4, "ab", true), 10);
+  writer.AppendRaw(st, makeOuter(5.0, 6.0, 7, 8, "cdef", false), 20);
+  int sta = writer.Start("structarr", "struct:Outer[]", {}, 2);
+  auto arr = makeOuter(1.0, 2.0, 3, -4, "ab", true);
+  auto second = makeOuter(5.0, 6.0, 7, 8, "cdef", false);
+  arr.insert(arr.end(), second.begin(), second.end());
+  writer.AppendRaw(sta, arr, 10);
+
+  // enough rows to span several blocks, with new dictionary entries in each
+  int s = writer.Start("string", "string", {}, 2);
+  for (int i = 0; i < kNumStrings; ++i) {
+    writer.AppendString(s, "s" + std::to_string(i % 7000), 100 + i);
+  }
+
+  writer.Flush();
+  return output;
+}
+
+std::vector<uint8_t> Export(std::vector<uint8_t> log) {
+  wpi::log::DataLogReaderThread thread{wpi::log::DataLogReader{
+      wpi::util::MemoryBuffer::GetMemBufferCopy(log, "columnar")}};
+  while (!thread.IsDone()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  std::vector<uint8_t> output;
+  wpi::util::raw_uvector_ostream os{output};
+  ExportColumnarFile(thread, [](auto) { return true; }, os);
+  return output;
+}
+
+const ColumnarTable* FindTable(const std::vector<ColumnarTable>& tables,
+                               std::string_view name) {
+  for (auto&& table : tables) {
+    if (table.name == name) {
+      return &table;
+    }
+  }
+  return nullptr;
+}
+
+template <typename T>
+T GetValue(const ColumnarColumn& column, size_t i) {
+  return wpi::util::support::endian::read<T, std::endian::little>(
+      column.values.data() + i * sizeof(T));
+}
+
+double GetDouble(const ColumnarColumn& column, size_t i) {
+  return std::bit_cast<double>(GetValue<uint64_t>(column, i));
+}
+
+std::string_view GetString(const ColumnarColumn& column, size_t i) {
+  return column.dictionary[GetValue<uint32_t>(column, i)];
+}
+
+}  // namespace
+
+TEST_CASE("ColumnarExportTest RoundTrip", "[datalogtool][columnar]") {
+  auto file = Export(MakeLog());
+  std::vector<ColumnarTable> tables;
+  REQUIRE(ReadColumnarFile(file, &tables));
+
+  SECTION("numeric") {
+    auto table = FindTable(tables, "double");
+    REQUIRE(table);
+    CHECK(table->type == "double");
+    CHECK(table->metadata == "meta");
+    CHECK(table->timestamps == std::vector<int64_t>{10, 20});
+    REQUIRE(table->columns.size() == 1);
+    auto& column = table->columns[0];
+    CHECK(column.name == "value");
+    CHECK(column.type == ColumnarValueType::kDouble);
+    CHECK_FALSE(column.list);
+    REQUIRE(column.values.size() == 16);
+    CHECK(GetDouble(column, 0) == 1.5);
+    CHECK(GetDouble(column, 1) == -2.0);
+  }
+
+  SECTION("numeric array") {
+    auto table = FindTable(tables, "intarr");
+    REQUIRE(table);
+    REQUIRE(table->columns.size() == 1);
+    auto& column = table->columns[0];
+    CHECK(column.type == ColumnarValueType::kInt64);
+    CHECK(column.list);
+    CHECK(column.lengths == std::vector<uint32_t>{3, 0});
+    REQUIRE(column.values.size() == 24);
+    CHECK(GetValue<int64_t>(column, 0) == 1);
+    CHECK(GetValue<int64_t>(column, 2) == 3);
+  }
+
+  SECTION("string dictionary") {
+    auto table = FindTable(tables, "string");
+    REQUIRE(table);
+    REQUIRE(table->timestamps.size() == kNumStrings);
+    REQUIRE(table->columns.size() == 1);
+    auto& column = table->columns[0];
+    CHECK(column.type == ColumnarValueType::kString);
+    CHECK(column.dictionary.size() == 7000u);
+    REQUIRE(column.values.size() == kNumStrings * 4);
+    for (int i = 0; i < kNumStrings; ++i) {
+      CHECK(table->timestamps[i] == 100 + i);
+      CHECK(GetString(column, i) == "s" + std::to_string(i % 7000));
+    }
+    // ids are only assigned to new strings
+    CHECK(GetValue<uint32_t>(column, 7000) == 0u);
+
+    table = FindTable(tables, "strarr");
+    REQUIRE(table);
+    auto& arrColumn = table->columns[0];
+    CHECK(arrColumn.list);
+    CHECK(arrColumn.lengths == std::vector<uint32_t>{2, 3});
+    CHECK(arrColumn.dictionary == std::vector<std::string>{"x", "a", "y"});
+    REQUIRE(arrColumn.values.size() == 20);
+    CHECK(GetString(arrColumn, 1) == "a");
+    CHECK(GetString(arrColumn, 4) == "y");
+  }
+
+  SECTION("struct flattened") {
+    auto table = FindTable(tables, "struct");
+    REQUIRE(table);
+    CHECK(table->timestamps == std::vector<int64_t>{10, 20});
+    REQUIRE(table->columns.size() == 6);
+    auto& columns = table->columns;
+    CHECK(columns[0].name == "pos/x");
+    CHECK(columns[1].name == "pos/y");
+    CHECK(columns[2].name == "id[0]");
+    CHECK(columns[3].name == "id[1]");
+    CHECK(columns[4].name == "name");
+    CHECK(columns[5].name == "flag");
+    CHECK(columns[0].type == ColumnarValueType::kDouble);
+    CHECK(columns[2].type == ColumnarValueType::kInt16);
+    CHECK(columns[4].type == ColumnarValueType::kString);
+    CHECK(columns[5].type == ColumnarValueType::kBoolean);
+    CHECK(GetDouble(columns[0], 0) == 1.0);
+    CHECK(GetDouble(columns[1], 1) == 6.0);
+    CHECK(GetValue<int16_t>(columns[3], 0) == -4);
+    CHECK(GetValue<int16_t>(columns[2], 1) == 7);
+    CHECK(GetString(columns[4], 0) == "ab");
+    CHECK(GetString(columns[4], 1) == "cdef");
+    CHECK(GetValue<uint8_t>(columns[5], 0) == 1);
+    CHECK(GetValue<uint8_t>(columns[5], 1) == 0);
+
+    table = FindTable(tables, "structarr");
+    REQUIRE(table);
+    REQUIRE(table->columns.size() == 6);
+    auto& arrColumn = table->columns[3];
+    CHECK(arrColumn.list);
+    CHECK(arrColumn.lengths == std::vector<uint32_t>{2});
+    CHECK(GetValue<int16_t>(arrColumn, 0) == -4);
+    CHECK(GetValue<int16_t>(arrColumn, 1) == 8);
+  }
+}
+
+TEST_CASE("ColumnarExportTest Truncated", "[datalogtool][columnar]") {
+  auto file = Export(MakeLog());
+  std::vector<ColumnarTable> tables;
+  REQUIRE(ReadColumnarFile(file, &tables));
+  for (size_t size : {file.size() - 1, file.size() / 2, size_t{10}}) {
+    CHECK_FALSE(ReadColumnarFile(std::span{file}.subspan(0, size), &tables));
+  }
+
+  // a footer offset past the end of the file is rejected
+  auto corrupt = file;
+  corrupt[corrupt.size() - 9] ^= 0x40;
+  CHECK_FALSE(ReadColumnarFile(corrupt, &tables));
+}
@@ -9,12 +9,6 @@
 #include <cstddef>
 #include <limits>
 
-#include <Eigen/SparseCore>
-#include <sleipnir/autodiff/gradient.hpp>
-#include <sleipnir/autodiff/hessian.hpp>
-#include <sleipnir/autodiff/variable.hpp>
-#include <sleipnir/autodiff/variable_matrix.hpp>
-
 #include "wpi/math/linalg/EigenCore.hpp"
 #include "wpi/math/system/NumericalIntegration.hpp"
 #include "wpi/units/base.hpp"
@@ -28,8 +22,6 @@ wpi::units::volt_t ArmFeedforward::Calculate(
     wpi::units::unit_t<Angle> currentAngle,
     wpi::units::unit_t<Velocity> currentVelocity,
     wpi::units::unit_t<Velocity> nextVelocity) const {
-  using VarMat = slp::VariableMatrix<double>;
-
   // Small kₐ values make the solver ill-conditioned
   if (kA < wpi::units::unit_t<ka_unit>{1e-1}) {
     auto acceleration = (nextVelocity - currentVelocity) / m_dt;
@@ -38,85 +30,90 @@ wpi::units::volt_t ArmFeedforward::Calculate(
   }
 
   // Arm dynamics
-  Matrixd<2, 2> A{{0.0, 1.0}, {0.0, -kV.value() / kA.value()}};
-  Matrixd<2, 1> B{{0.0}, {1.0 / kA.value()}};
-  const auto& f = [&](const VarMat& x, const VarMat& u) -> VarMat {
-    VarMat c{{0.0},
-             {-(kS / kA).value() * slp::sign(x[1]) -
-              (kG / kA).value() * slp::cos(x[0])}};
-    return A * x + B * u + c;
+  //
+  //   ẋ = Ax + Bu + c(x)
+  //
+  // Column 0 of X is the state x, column 1 is ∂x/∂u, and column 2 is ∂²x/∂u².
+  // RK4 only combines its stages linearly, so integrating all three columns
+  // together also yields the first and second derivatives of the next state
+  // with respect to u without building an autodiff expression graph.
+  const double A = -(kV / kA).value();
+  const double B = 1.0 / kA.value();
+  const double C_s = (kS / kA).value();
+  const double C_g = (kG / kA).value();
+  const auto& f = [&](const Matrixd<2, 3>& X, double u) -> Matrixd<2, 3> {
+    double cosθ = std::cos(X(0, 0));
+    double sinθ = std::sin(X(0, 0));
+    return Matrixd<2, 3>{
+        {X(1, 0), X(1, 1), X(1, 2)},
+        {A * X(1, 0) + B * u - C_s * wpi::util::sgn(X(1, 0)) - C_g * cosθ,
+         A * X(1, 1) + B + C_g * sinθ * X(0, 1),
+         A * X(1, 2) + C_g * (cosθ * X(0, 1) * X(0, 1) + sinθ * X(0, 2))}};
   };
 
-  Vectord<2> r_k{currentAngle.value(), currentVelocity.value()};
-
-  slp::Variable<double> u_k;
+  Matrixd<2, 3> X_k{{currentAngle.value(), 0.0, 0.0},
+                    {currentVelocity.value(), 0.0, 0.0}};
+
+  // Returns the cost and its gradient and Hessian with respect to u
+  const auto& evaluate = [&](double u) -> Vectord<3> {
+    Matrixd<2, 3> X_k1 = RK4(f, X_k, u, m_dt);
+
+    // Minimize difference between desired and actual next velocity
+    //
+    //   J = (r − v)²
+    //   ∂J/∂u = −2(r − v) ∂v/∂u
+    //   ∂²J/∂u² = 2(∂v/∂u)² − 2(r − v) ∂²v/∂u²
+    double error = nextVelocity.value() - X_k1(1, 0);
+    return Vectord<3>{error * error, -2.0 * error * X_k1(1, 1),
+                      2.0 * X_k1(1, 1) * X_k1(1, 1) - 2.0 * error * X_k1(1, 2)};
+  };
 
   // Initial guess
   auto acceleration = (nextVelocity - currentVelocity) / m_dt;
-  u_k.set_value((kS * wpi::util::sgn(currentVelocity.value()) +
-                 kV * currentVelocity + kA * acceleration +
-                 kG * wpi::units::math::cos(currentAngle))
-                    .value());
-
-  auto r_k1 = RK4<decltype(f), VarMat, VarMat>(f, r_k, u_k, m_dt);
-
-  // Minimize difference between desired and actual next velocity
-  auto cost =
-      (nextVelocity.value() - r_k1[1]) * (nextVelocity.value() - r_k1[1]);
+  double x = (kS * wpi::util::sgn(currentVelocity.value()) +
+              kV * currentVelocity + kA * acceleration +
+              kG * wpi::units::math::cos(currentAngle))
+                 .value();
 
   // Refine solution via Newton's method
-  {
-    auto xAD = u_k;
-    double x = xAD.value();
+  Vectord<3> J = evaluate(x);
 
-    slp::Gradient gradientF{cost, xAD};
-    Eigen::SparseVector<double> g = gradientF.value();
+  double error_k = std::numeric_limits<double>::infinity();
+  double error_k1 = std::abs(J(1));
 
-    slp::Hessian hessianF{cost, xAD};
-    Eigen::SparseMatrix<double> H = hessianF.value();
+  // Loop until error stops decreasing or max iterations is reached
+  for (size_t iteration = 0;
+       iteration < 50 && error_k1 < (1.0 - 1e-10) * error_k; ++iteration) {
+    error_k = error_k1;
 
-    double error_k = std::numeric_limits<double>::infinity();
-    double error_k1 = std::abs(g.coeff(0));
+    // Iterate via Newton's method.
+    //
+    //   xₖ₊₁ = xₖ − H⁻¹g
+    //
+    // The Hessian is regularized to at least 1e-4.
+    double p_x = -J(1) / std::max(J(2), 1e-4);
 
-    // Loop until error stops decreasing or max iterations is reached
-    for (size_t iteration = 0;
-         iteration < 50 && error_k1 < (1.0 - 1e-10) * error_k; ++iteration) {
-      error_k = error_k1;
+    // Shrink step until cost goes down
+    {
+      double oldCost = J(0);
 
-      // Iterate via Newton's method.
-      //
-      //   xₖ₊₁ = xₖ − H⁻¹g
-      //
-      // The Hessian is regularized to at least 1e-4.
-      double p_x = -g.coeff(0) / std::max(H.coeff(0, 0), 1e-4);
+      double α = 1.0;
+      double trial_x = x + α * p_x;
 
-      // Shrink step until cost goes down
-      {
-        double oldCost = cost.value();
+      J = evaluate(trial_x);
 
-        double α = 1.0;
-        double trial_x = x + α * p_x;
+      while (J(0) > oldCost) {
+        α *= 0.5;
+        trial_x = x + α * p_x;
 
-        xAD.set_value(trial_x);
-
-        while (cost.value() > oldCost) {
-          α *= 0.5;
-          trial_x = x + α * p_x;
-
-          xAD.set_value(trial_x);
-        }
-
-        x = trial_x;
+        J = evaluate(trial_x);
       }
 
-      xAD.set_value(x);
-
-      g = gradientF.value();
-      H = hessianF.value();
-
-      error_k1 = std::abs(g.coeff(0));
+      x = trial_x;
     }
+
+    error_k1 = std::abs(J(1));
   }
 
-  return wpi::units::volt_t{u_k.value()};
+  return wpi::units::volt_t{x};
 }
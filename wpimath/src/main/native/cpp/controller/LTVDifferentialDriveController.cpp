@@ -5,6 +5,7 @@
 #include "wpi/math/controller/LTVDifferentialDriveController.hpp"
 
 #include <cmath>
+#include <stdexcept>
 
 #include <Eigen/Core>
 
@@ -20,6 +21,35 @@
 
 using namespace wpi::math;
 
+LTVDifferentialDriveController::LTVDifferentialDriveController(
+    const wpi::math::LinearSystem<2, 2, 2>& plant,
+    wpi::units::meter_t trackwidth, const wpi::util::array<double, 5>& Qelems,
+    const wpi::util::array<double, 2>& Relems, wpi::units::second_t dt,
+    wpi::units::meters_per_second_t maxVelocity,
+    wpi::units::meters_per_second_t velocityStep)
+    : LTVDifferentialDriveController{plant, trackwidth, Qelems, Relems, dt} {
+  if (maxVelocity <= 0_mps) {
+    throw std::invalid_argument("Max velocity must be positive.");
+  }
+  if (velocityStep <= 0_mps) {
+    throw std::invalid_argument("Velocity step must be positive.");
+  }
+
+  // The gain for -v is the gain for v with the y error column negated (see
+  // CalculateGain()), and the gain changes sign at v = 0, so only tabulate
+  // nonnegative velocities to avoid interpolating across the discontinuity.
+  //
+  // Index by step count instead of accumulating the velocity so the grid
+  // points don't drift, and always include maxVelocity as an endpoint.
+  m_table.emplace();
+  int steps =
+      static_cast<int>(std::ceil((maxVelocity / velocityStep).value()));
+  for (int i = 0; i <= steps; ++i) {
+    auto velocity = wpi::units::math::min(velocityStep * i, maxVelocity);
+    m_table->insert(velocity, CalculateGain(velocity));
+  }
+}
+
 DifferentialDriveWheelVoltages LTVDifferentialDriveController::Calculate(
     const Pose2d& currentPose, wpi::units::meters_per_second_t leftVelocity,
     wpi::units::meters_per_second_t rightVelocity, const Pose2d& poseRef,
@@ -37,12 +67,6 @@ DifferentialDriveWheelVoltages LTVDifferentialDriveController::Calculate(
   wpi::units::meters_per_second_t velocity{(leftVelocity + rightVelocity) /
                                            2.0};
 
-  // The DARE is ill-conditioned if the velocity is close to zero, so don't
-  // let the system stop.
-  if (wpi::units::math::abs(velocity) < 1e-4_mps) {
-    velocity = 1e-4_mps;
-  }
-
   Eigen::Vector<double, 5> r{poseRef.X().value(), poseRef.Y().value(),
                              poseRef.Rotation().Radians().value(),
                              leftVelocityRef.value(), rightVelocityRef.value()};
@@ -54,6 +78,41 @@ DifferentialDriveWheelVoltages LTVDifferentialDriveController::Calculate(
   m_error(2) =
       wpi::math::AngleModulus(wpi::units::radian_t{m_error(2)}).value();
 
+  Eigen::Matrix<double, 2, 5> K;
+  if (m_table) {
+    K = (*m_table)[wpi::units::math::abs(velocity)];
+    if (velocity < 0_mps) {
+      K.col(1) = -K.col(1);
+    }
+  } else {
+    K = CalculateGain(velocity);
+  }
+
+  Eigen::Matrix<double, 5, 5> inRobotFrame{
+      {std::cos(x(2)), std::sin(x(2)), 0.0, 0.0, 0.0},
+      {-std::sin(x(2)), std::cos(x(2)), 0.0, 0.0, 0.0},
+      {0.0, 0.0, 1.0, 0.0, 0.0},
+      {0.0, 0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 0.0, 0.0, 1.0}};
+
+  Eigen::Vector2d u = K * inRobotFrame * m_error;
+
+  return DifferentialDriveWheelVoltages{wpi::units::volt_t{u(0)},
+                                        wpi::units::volt_t{u(1)}};
+}
+
+Eigen::Matrix<double, 2, 5> LTVDifferentialDriveController::CalculateGain(
+    wpi::units::meters_per_second_t velocity) const {
+  // The DARE is ill-conditioned if the velocity is close to zero, so don't
+  // let the system stop.
+  if (wpi::units::math::abs(velocity) < 1e-4_mps) {
+    velocity = 1e-4_mps;
+  }
+
+  // Negating v is equivalent to negating the y coordinate. With
+  // T = diag(1, −1, 1, 1, 1), A(−v) = TA(v)T and B = TB, so S(−v) = TS(v)T and
+  // K(−v) = K(v)T.
+
   Eigen::Matrix<double, 5, 5> A{
       {0.0, 0.0, 0.0, 0.5, 0.5},
       {0.0, 0.0, velocity.value(), 0.0, 0.0},
@@ -73,19 +132,7 @@ DifferentialDriveWheelVoltages LTVDifferentialDriveController::Calculate(
   auto S = DARE<5, 2>(discA, discB, m_Q, m_R, false).value();
 
   // K = (BᵀSB + R)⁻¹BᵀSA
-  Eigen::Matrix<double, 2, 5> K = (discB.transpose() * S * discB + m_R)
-                                      .llt()
-                                      .solve(discB.transpose() * S * discA);
-
-  Eigen::Matrix<double, 5, 5> inRobotFrame{
-      {std::cos(x(2)), std::sin(x(2)), 0.0, 0.0, 0.0},
-      {-std::sin(x(2)), std::cos(x(2)), 0.0, 0.0, 0.0},
-      {0.0, 0.0, 1.0, 0.0, 0.0},
-      {0.0, 0.0, 0.0, 1.0, 0.0},
-      {0.0, 0.0, 0.0, 0.0, 1.0}};
-
-  Eigen::Vector2d u = K * inRobotFrame * m_error;
-
-  return DifferentialDriveWheelVoltages{wpi::units::volt_t{u(0)},
-                                        wpi::units::volt_t{u(1)}};
+  return (discB.transpose() * S * discB + m_R)
+      .llt()
+      .solve(discB.transpose() * S * discA);
 }
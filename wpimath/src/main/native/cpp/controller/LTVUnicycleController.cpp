@@ -4,6 +4,9 @@
 
 #include "wpi/math/controller/LTVUnicycleController.hpp"
 
+#include <cmath>
+#include <stdexcept>
+
 #include <Eigen/Core>
 
 #include "wpi/math/geometry/Pose2d.hpp"
@@ -16,6 +19,34 @@
 
 using namespace wpi::math;
 
+LTVUnicycleController::LTVUnicycleController(
+    const wpi::util::array<double, 3>& Qelems,
+    const wpi::util::array<double, 2>& Relems, wpi::units::second_t dt,
+    wpi::units::meters_per_second_t maxVelocity,
+    wpi::units::meters_per_second_t velocityStep)
+    : LTVUnicycleController{Qelems, Relems, dt} {
+  if (maxVelocity <= 0_mps) {
+    throw std::invalid_argument("Max velocity must be positive.");
+  }
+  if (velocityStep <= 0_mps) {
+    throw std::invalid_argument("Velocity step must be positive.");
+  }
+
+  // The gain for -v is the gain for v with the y error column negated (see
+  // CalculateGain()), and the gain changes sign at v = 0, so only tabulate
+  // nonnegative velocities to avoid interpolating across the discontinuity.
+  //
+  // Index by step count instead of accumulating the velocity so the grid
+  // points don't drift, and always include maxVelocity as an endpoint.
+  m_table.emplace();
+  int steps =
+      static_cast<int>(std::ceil((maxVelocity / velocityStep).value()));
+  for (int i = 0; i <= steps; ++i) {
+    auto velocity = wpi::units::math::min(velocityStep * i, maxVelocity);
+    m_table->insert(velocity, CalculateGain(velocity));
+  }
+}
+
 ChassisVelocities LTVUnicycleController::Calculate(
     const Pose2d& currentPose, const Pose2d& poseRef,
     wpi::units::meters_per_second_t linearVelocityRef,
@@ -65,8 +96,39 @@ ChassisVelocities LTVUnicycleController::Calculate(
 
   m_poseError = poseRef.RelativeTo(currentPose);
 
+  Eigen::Matrix<double, 2, 3> K;
+  if (m_table) {
+    K = (*m_table)[wpi::units::math::abs(linearVelocityRef)];
+    if (linearVelocityRef < 0_mps) {
+      K.col(1) = -K.col(1);
+    }
+  } else {
+    K = CalculateGain(linearVelocityRef);
+  }
+
+  Eigen::Vector3d e{m_poseError.X().value(), m_poseError.Y().value(),
+                    m_poseError.Rotation().Radians().value()};
+  Eigen::Vector2d u = K * e;
+
+  return ChassisVelocities{
+      linearVelocityRef + wpi::units::meters_per_second_t{u(0)}, 0_mps,
+      angularVelocityRef + wpi::units::radians_per_second_t{u(1)}};
+}
+
+Eigen::Matrix<double, 2, 3> LTVUnicycleController::CalculateGain(
+    wpi::units::meters_per_second_t velocity) const {
+  // The DARE is ill-conditioned if the velocity is close to zero, so don't
+  // let the system stop.
+  if (wpi::units::math::abs(velocity) < 1e-4_mps) {
+    velocity = 1e-4_mps;
+  }
+
+  // Negating v is equivalent to negating the y coordinate. With
+  // T = diag(1, −1, 1), A(−v) = TA(v)T and B = TB, so S(−v) = TS(v)T and
+  // K(−v) = K(v)T.
+
   Eigen::Matrix<double, 3, 3> A{
-      {0.0, 0.0, 0.0}, {0.0, 0.0, linearVelocityRef.value()}, {0.0, 0.0, 0.0}};
+      {0.0, 0.0, 0.0}, {0.0, 0.0, velocity.value()}, {0.0, 0.0, 0.0}};
   constexpr Eigen::Matrix<double, 3, 2> B{{1.0, 0.0}, {0.0, 0.0}, {0.0, 1.0}};
 
   Eigen::Matrix<double, 3, 3> discA;
@@ -76,15 +138,7 @@ ChassisVelocities LTVUnicycleController::Calculate(
   auto S = DARE<3, 2>(discA, discB, m_Q, m_R, false).value();
 
   // K = (BᵀSB + R)⁻¹BᵀSA
-  Eigen::Matrix<double, 2, 3> K = (discB.transpose() * S * discB + m_R)
-                                      .llt()
-                                      .solve(discB.transpose() * S * discA);
-
-  Eigen::Vector3d e{m_poseError.X().value(), m_poseError.Y().value(),
-                    m_poseError.Rotation().Radians().value()};
-  Eigen::Vector2d u = K * e;
-
-  return ChassisVelocities{
-      linearVelocityRef + wpi::units::meters_per_second_t{u(0)}, 0_mps,
-      angularVelocityRef + wpi::units::radians_per_second_t{u(1)}};
+  return (discB.transpose() * S * discB + m_R)
+      .llt()
+      .solve(discB.transpose() * S * discA);
 }
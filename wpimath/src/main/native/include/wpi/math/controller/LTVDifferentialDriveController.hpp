@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cmath>
+#include <optional>
 
 #include <Eigen/Core>
 
@@ -18,6 +19,7 @@
 #include "wpi/units/velocity.hpp"
 #include "wpi/util/SymbolExports.hpp"
 #include "wpi/util/array.hpp"
+#include "wpi/util/interpolating_map.hpp"
 
 namespace wpi::math {
 
@@ -66,6 +68,40 @@ class WPILIB_DLLEXPORT LTVDifferentialDriveController {
         m_R{wpi::math::CostMatrix(Relems)},
         m_dt{dt} {}
 
+  /**
+   * Constructs a linear time-varying differential drive controller that
+   * precomputes the controller gains.
+   *
+   * Computing the gain requires solving a DARE, so this constructor solves it
+   * once for each velocity in [0, maxVelocity] at the given spacing (the gains
+   * for negative velocities follow by symmetry). Calculate() then linearly
+   * interpolates between the two nearest gains instead of solving the DARE,
+   * which trades accuracy (controlled by velocityStep) for a much cheaper
+   * update.
+   *
+   * See
+   * https://docs.wpilib.org/en/stable/docs/software/advanced-controls/state-space/state-space-intro.html#lqr-tuning
+   * for how to select the tolerances.
+   *
+   * @param plant        The differential drive velocity plant.
+   * @param trackwidth   The distance between the differential drive's left and
+   *                     right wheels.
+   * @param Qelems       The maximum desired error tolerance for each state.
+   * @param Relems       The maximum desired control effort for each input.
+   * @param dt           Discretization timestep.
+   * @param maxVelocity  The maximum velocity for the gain table. Gains for
+   *                     faster velocities use the gain at this velocity.
+   * @param velocityStep The velocity spacing of the gain table.
+   * @throws std::invalid_argument If maxVelocity or velocityStep isn't
+   *                               positive.
+   */
+  LTVDifferentialDriveController(
+      const wpi::math::LinearSystem<2, 2, 2>& plant,
+      wpi::units::meter_t trackwidth, const wpi::util::array<double, 5>& Qelems,
+      const wpi::util::array<double, 2>& Relems, wpi::units::second_t dt,
+      wpi::units::meters_per_second_t maxVelocity,
+      wpi::units::meters_per_second_t velocityStep = 0.01_mps);
+
   /**
    * Move constructor.
    */
@@ -146,6 +182,14 @@ class WPILIB_DLLEXPORT LTVDifferentialDriveController {
   }
 
  private:
+  /**
+   * Returns the controller gain for the given velocity.
+   *
+   * @param velocity The average of the left and right wheel velocities.
+   */
+  Eigen::Matrix<double, 2, 5> CalculateGain(
+      wpi::units::meters_per_second_t velocity) const;
+
   wpi::units::meter_t m_trackwidth;
 
   // Continuous velocity dynamics
@@ -158,6 +202,11 @@ class WPILIB_DLLEXPORT LTVDifferentialDriveController {
 
   wpi::units::second_t m_dt;
 
+  // Precomputed gains indexed by velocity, if enabled
+  std::optional<wpi::util::interpolating_map<wpi::units::meters_per_second_t,
+                                             Eigen::Matrix<double, 2, 5>>>
+      m_table;
+
   Eigen::Vector<double, 5> m_error;
   Eigen::Vector<double, 5> m_tolerance;
 };
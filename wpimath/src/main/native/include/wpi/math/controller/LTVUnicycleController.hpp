@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include <Eigen/Core>
 
 #include "wpi/math/geometry/Pose2d.hpp"
@@ -16,6 +18,7 @@
 #include "wpi/units/velocity.hpp"
 #include "wpi/util/SymbolExports.hpp"
 #include "wpi/util/array.hpp"
+#include "wpi/util/interpolating_map.hpp"
 
 namespace wpi::math {
 
@@ -60,6 +63,38 @@ class WPILIB_DLLEXPORT LTVUnicycleController {
         m_R{wpi::math::CostMatrix(Relems)},
         m_dt{dt} {}
 
+  /**
+   * Constructs a linear time-varying unicycle controller that precomputes the
+   * controller gains.
+   *
+   * Computing the gain requires solving a DARE, so this constructor solves it
+   * once for each velocity in [0, maxVelocity] at the given spacing (the gains
+   * for negative velocities follow by symmetry). Calculate() then linearly
+   * interpolates between the two nearest gains instead of solving the DARE,
+   * which trades accuracy (controlled by velocityStep) for a much cheaper
+   * update.
+   *
+   * See
+   * https://docs.wpilib.org/en/stable/docs/software/advanced-controls/state-space/state-space-intro.html#lqr-tuning
+   * for how to select the tolerances.
+   *
+   * @param Qelems       The maximum desired error tolerance for each state (x,
+   *                     y, heading).
+   * @param Relems       The maximum desired control effort for each input
+   *                     (linear velocity, angular velocity).
+   * @param dt           Discretization timestep.
+   * @param maxVelocity  The maximum velocity for the gain table. Gains for
+   *                     faster velocities use the gain at this velocity.
+   * @param velocityStep The velocity spacing of the gain table.
+   * @throws std::invalid_argument If maxVelocity or velocityStep isn't
+   *                               positive.
+   */
+  LTVUnicycleController(
+      const wpi::util::array<double, 3>& Qelems,
+      const wpi::util::array<double, 2>& Relems, wpi::units::second_t dt,
+      wpi::units::meters_per_second_t maxVelocity,
+      wpi::units::meters_per_second_t velocityStep = 0.01_mps);
+
   /**
    * Move constructor.
    */
@@ -137,12 +172,25 @@ class WPILIB_DLLEXPORT LTVUnicycleController {
   void SetEnabled(bool enabled) { m_enabled = enabled; }
 
  private:
+  /**
+   * Returns the controller gain for the given linear velocity.
+   *
+   * @param velocity The linear velocity.
+   */
+  Eigen::Matrix<double, 2, 3> CalculateGain(
+      wpi::units::meters_per_second_t velocity) const;
+
   // LQR cost matrices
   Eigen::Matrix<double, 3, 3> m_Q;
   Eigen::Matrix<double, 2, 2> m_R;
 
   wpi::units::second_t m_dt;
 
+  // Precomputed gains indexed by linear velocity, if enabled
+  std::optional<wpi::util::interpolating_map<wpi::units::meters_per_second_t,
+                                             Eigen::Matrix<double, 2, 3>>>
+      m_table;
+
   Pose2d m_poseError;
   Pose2d m_poseTolerance;
   bool m_enabled = true;
@@ -255,43 +255,56 @@ class UnscentedKalmanFilter {
    * @param dt Timestep for prediction.
    */
   void Predict(const InputVector& u, wpi::units::second_t dt) {
-    m_dt = dt;
-
-    // Discretize Q before projecting mean and covariance forward
-    StateMatrix contA =
-        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
-    StateMatrix discA;
-    StateMatrix discQ;
-    DiscretizeAQ<States>(contA, m_contQ, m_dt, &discA, &discQ);
-    Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(discQ);
-
-    // Generate sigma points around the state mean
-    //
-    // equation (17)
-    Matrixd<States, NumSigmas> sigmas =
-        m_pts.SquareRootSigmaPoints(m_xHat, m_S);
+    PredictSigmas(u, dt, [&](const Matrixd<States, NumSigmas>& sigmas) {
+      // Project each sigma point forward in time according to the
+      // dynamics f(x, u)
+      //
+      //   sigmas  = 𝒳ₖ₋₁
+      //   sigmasF = 𝒳ₖ,ₖ₋₁ or just 𝒳 for readability
+      //
+      // equation (18)
+      for (int i = 0; i < NumSigmas; ++i) {
+        StateVector x = sigmas.template block<States, 1>(0, i);
+        m_sigmasF.template block<States, 1>(0, i) = RK4(m_f, x, u, dt);
+      }
+    });
+  }
 
-    // Project each sigma point forward in time according to the
-    // dynamics f(x, u)
-    //
-    //   sigmas  = 𝒳ₖ₋₁
-    //   sigmasF = 𝒳ₖ,ₖ₋₁ or just 𝒳 for readability
-    //
-    // equation (18)
-    for (int i = 0; i < NumSigmas; ++i) {
-      StateVector x = sigmas.template block<States, 1>(0, i);
-      m_sigmasF.template block<States, 1>(0, i) = RK4(m_f, x, u, dt);
-    }
+  /**
+   * Project the model into the future with a new control input u.
+   *
+   * This evaluates the dynamics for all sigma points with one call to f
+   * instead of one call per sigma point, so f can operate on every column at
+   * once (e.g., with Eigen array expressions) or split the columns across
+   * threads for large state sizes. The f(x, u) passed to the constructor is
+   * still used to linearize the model when discretizing the process noise, so
+   * both must describe the same dynamics.
+   *
+   * @param u  New control input from controller.
+   * @param dt Timestep for prediction.
+   * @param f  A function of a matrix of states (one per column) and u that
+   *           writes the derivative of each state to the corresponding column
+   *           of its third argument.
+   */
+  void Predict(const InputVector& u, wpi::units::second_t dt,
+               std::function<void(const Matrixd<States, NumSigmas>&,
+                                  const InputVector&,
+                                  Matrixd<States, NumSigmas>&)>
+                   f) {
+    auto dynamics = [&](const Matrixd<States, NumSigmas>& x,
+                        const InputVector& input) {
+      Matrixd<States, NumSigmas> xdot;
+      f(x, input, xdot);
+      return xdot;
+    };
 
-    // Pass the predicted sigmas (𝒳) through the Unscented Transform
-    // to compute the prior state mean and covariance
-    //
-    // equations (18) (19) and (20)
-    auto [xHat, S] = SquareRootUnscentedTransform<States, NumSigmas>(
-        m_sigmasF, m_pts.Wm(), m_pts.Wc(), m_meanFuncX, m_residualFuncX,
-        discQ.template triangularView<Eigen::Lower>());
-    m_xHat = xHat;
-    m_S = S;
+    PredictSigmas(u, dt, [&](const Matrixd<States, NumSigmas>& sigmas) {
+      // Project all sigma points forward in time according to the
+      // dynamics f(x, u)
+      //
+      // equation (18)
+      m_sigmasF = RK4(dynamics, sigmas, u, dt);
+    });
   }
 
   /**
@@ -438,6 +451,116 @@ class UnscentedKalmanFilter {
               .transpose();
     }
 
+    ApplyCorrection<Rows>(y, yHat, Sy, Pxy, residualFuncY, addFuncX);
+  }
+
+  /**
+   * Correct the state estimate x-hat using the measurements in y.
+   *
+   * This transforms all sigma points into measurement space with one call to
+   * h instead of one call per sigma point, so h can operate on every column at
+   * once (e.g., with Eigen array expressions) or split the columns across
+   * threads for large state sizes. States and measurements are combined with
+   * ordinary arithmetic.
+   *
+   * @param u Same control input used in the predict step.
+   * @param y Measurement vector.
+   * @param h A function of a matrix of states (one per column) and u that
+   *          writes the measurement vector for each state to the
+   *          corresponding column of its third argument.
+   * @param R Continuous measurement noise covariance matrix.
+   */
+  template <int Rows>
+  void Correct(const InputVector& u, const Vectord<Rows>& y,
+               std::function<void(const Matrixd<States, NumSigmas>&,
+                                  const InputVector&,
+                                  Matrixd<Rows, NumSigmas>&)>
+                   h,
+               const Matrixd<Rows, Rows>& R) {
+    Matrixd<Rows, Rows> discR = DiscretizeR<Rows>(R, m_dt);
+    Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(discR);
+
+    // Generate new sigma points from the prior mean and covariance
+    // and transform them into measurement space using h(x, u)
+    Matrixd<Rows, NumSigmas> sigmasH;
+    h(m_pts.SquareRootSigmaPoints(m_xHat, m_S), u, sigmasH);
+
+    auto residualFuncY = [](const Vectord<Rows>& a,
+                            const Vectord<Rows>& b) -> Vectord<Rows> {
+      return a - b;
+    };
+    auto addFuncX = [](const StateVector& a,
+                       const StateVector& b) -> StateVector { return a + b; };
+
+    // equations (23) (24) and (25)
+    auto [yHat, Sy] = SquareRootUnscentedTransform<Rows, NumSigmas>(
+        sigmasH, m_pts.Wm(), m_pts.Wc(),
+        [](const Matrixd<Rows, NumSigmas>& sigmas,
+           const Vectord<NumSigmas>& Wm) -> Vectord<Rows> {
+          return sigmas * Wm;
+        },
+        residualFuncY, discR.template triangularView<Eigen::Lower>());
+
+    // Compute the cross covariance for all sigma points at once
+    //
+    //   P_{xy} = [𝒳 - x̂] diag(W⁽ᶜ⁾) [𝒴 - ŷ⁻]ᵀ
+    //
+    // equation (26)
+    Matrixd<States, Rows> Pxy = (m_sigmasF.colwise() - m_xHat) *
+                                m_pts.Wc().asDiagonal() *
+                                (sigmasH.colwise() - yHat).transpose();
+
+    ApplyCorrection<Rows>(y, yHat, Sy, Pxy, residualFuncY, addFuncX);
+  }
+
+ private:
+  /**
+   * Projects the model into the future, using propagate to map the sigma
+   * points around the current state estimate to m_sigmasF.
+   */
+  template <typename Propagate>
+  void PredictSigmas(const InputVector& u, wpi::units::second_t dt,
+                     Propagate&& propagate) {
+    m_dt = dt;
+
+    // Discretize Q before projecting mean and covariance forward
+    StateMatrix contA =
+        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+    StateMatrix discA;
+    StateMatrix discQ;
+    DiscretizeAQ<States>(contA, m_contQ, m_dt, &discA, &discQ);
+    Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(discQ);
+
+    // Generate sigma points around the state mean
+    //
+    // equation (17)
+    Matrixd<States, NumSigmas> sigmas =
+        m_pts.SquareRootSigmaPoints(m_xHat, m_S);
+
+    // Project the sigma points forward in time to get m_sigmasF (𝒳)
+    propagate(sigmas);
+
+    // Pass the predicted sigmas (𝒳) through the Unscented Transform
+    // to compute the prior state mean and covariance
+    //
+    // equations (18) (19) and (20)
+    auto [xHat, S] = SquareRootUnscentedTransform<States, NumSigmas>(
+        m_sigmasF, m_pts.Wm(), m_pts.Wc(), m_meanFuncX, m_residualFuncX,
+        discQ.template triangularView<Eigen::Lower>());
+    m_xHat = xHat;
+    m_S = S;
+  }
+
+  /**
+   * Corrects the state estimate given the predicted measurement yHat, its
+   * square-root covariance Sy, and the cross covariance Pxy of the state and
+   * measurement sigma points.
+   */
+  template <int Rows, typename ResidualFuncY, typename AddFuncX>
+  void ApplyCorrection(const Vectord<Rows>& y, const Vectord<Rows>& yHat,
+                       const Matrixd<Rows, Rows>& Sy,
+                       const Matrixd<States, Rows>& Pxy,
+                       ResidualFuncY&& residualFuncY, AddFuncX&& addFuncX) {
     // Compute the Kalman gain (see wpimath/docs/LinalgIdentities.md)
     //
     //   K = (P_{xy} / S_{y}ᵀ) / S_{y}
@@ -474,7 +597,6 @@ class UnscentedKalmanFilter {
     }
   }
 
- private:
   std::function<StateVector(const StateVector&, const InputVector&)> m_f;
   std::function<OutputVector(const StateVector&, const InputVector&)> m_h;
   std::function<StateVector(const Matrixd<States, NumSigmas>&,
@@ -4,11 +4,10 @@
 
 #pragma once
 
-#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <optional>
 #include <utility>
-#include <vector>
 
 #include "wpi/math/geometry/Pose2d.hpp"
 #include "wpi/math/geometry/Pose3d.hpp"
@@ -16,6 +15,7 @@
 #include "wpi/math/geometry/Twist3d.hpp"
 #include "wpi/units/time.hpp"
 #include "wpi/util/MathExtras.hpp"
+#include "wpi/util/circular_buffer.hpp"
 
 namespace wpi::math {
 
@@ -29,6 +29,10 @@ namespace wpi::math {
  * When sampling this buffer, a user-provided function or wpi::util::Lerp can be
  * used. For Pose2ds, we use Twists.
  *
+ * Samples are stored in a circular buffer that grows until it can hold the
+ * history window, so adding samples in order at a steady rate doesn't allocate
+ * once the buffer has filled.
+ *
  * @tparam T The type stored in this buffer.
  */
 template <typename T>
@@ -69,35 +73,42 @@ class TimeInterpolatableBuffer {
    * @param sample The sample object.
    */
   void AddSample(wpi::units::second_t time, T sample) {
-    // Add the new state into the vector
-    if (m_pastSnapshots.size() == 0 || time > m_pastSnapshots.back().first) {
+    // Remove samples that are too old relative to the new one first so their
+    // space can be reused
+    while (!m_pastSnapshots.empty() &&
+           time - m_pastSnapshots.front().first > m_historySize) {
+      m_pastSnapshots.pop_front();
+    }
+
+    // Append if the sample is the newest, which is the common case
+    if (m_pastSnapshots.empty() || time > m_pastSnapshots.back().first) {
+      Reserve();
       m_pastSnapshots.emplace_back(time, sample);
+      return;
+    }
+
+    size_t firstAfter = UpperBound(time);
+    if (firstAfter > 0 && m_pastSnapshots[firstAfter - 1].first == time) {
+      // An entry exists with the same recorded time
+      m_pastSnapshots[firstAfter - 1].second = sample;
+      return;
+    }
+
+    Reserve();
+    if (firstAfter == 0) {
+      // All entries come after the sample
+      m_pastSnapshots.emplace_front(time, sample);
     } else {
-      auto first_after = std::upper_bound(
-          m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-          [](auto t, const auto& pair) { return t < pair.first; });
-
-      if (first_after == m_pastSnapshots.begin()) {
-        // All entries come after the sample
-        m_pastSnapshots.insert(first_after, std::pair{time, sample});
-      } else if (auto last_not_greater_than = first_after - 1;
-                 last_not_greater_than == m_pastSnapshots.begin() ||
-                 last_not_greater_than->first < time) {
-        // Some entries come before the sample, but none are recorded with the
-        // same time
-        m_pastSnapshots.insert(first_after, std::pair{time, sample});
-      } else {
-        // An entry exists with the same recorded time
-        last_not_greater_than->second = sample;
+      // Some entries come before the sample; shift the later ones back
+      m_pastSnapshots.emplace_back(time, sample);
+      for (size_t i = m_pastSnapshots.size() - 1; i > firstAfter; --i) {
+        std::swap(m_pastSnapshots[i], m_pastSnapshots[i - 1]);
       }
     }
-    while (time - m_pastSnapshots[0].first > m_historySize) {
-      m_pastSnapshots.erase(m_pastSnapshots.begin());
-    }
   }
 
   /** Clear all old samples. */
-  void Clear() { m_pastSnapshots.clear(); }
+  void Clear() { m_pastSnapshots.reset(); }
 
   /**
    * Sample the buffer at the given time. If the buffer is empty, an empty
@@ -124,42 +135,94 @@ class TimeInterpolatableBuffer {
       return m_pastSnapshots[0].second;
     }
 
-    // Get the iterator which has a key no less than the requested key.
-    auto upper_bound = std::lower_bound(
-        m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-        [](const auto& pair, auto t) { return t > pair.first; });
+    // Get the index of the first entry with a time no less than the requested
+    // time.
+    size_t upperIndex = LowerBound(time);
 
-    if (upper_bound == m_pastSnapshots.begin()) {
-      return upper_bound->second;
+    if (upperIndex == 0) {
+      return m_pastSnapshots[0].second;
     }
 
-    auto lower_bound = upper_bound - 1;
+    const auto& upper_bound = m_pastSnapshots[upperIndex];
+    const auto& lower_bound = m_pastSnapshots[upperIndex - 1];
 
-    double t = ((time - lower_bound->first) /
-                (upper_bound->first - lower_bound->first));
+    double t = ((time - lower_bound.first) /
+                (upper_bound.first - lower_bound.first));
 
-    return m_interpolatingFunc(lower_bound->second, upper_bound->second, t);
+    return m_interpolatingFunc(lower_bound.second, upper_bound.second, t);
   }
 
   /**
    * Grant access to the internal sample buffer. Used in Pose Estimation to
    * replay odometry inputs stored within this buffer.
    */
-  std::vector<std::pair<wpi::units::second_t, T>>& GetInternalBuffer() {
+  wpi::util::circular_buffer<std::pair<wpi::units::second_t, T>>&
+  GetInternalBuffer() {
     return m_pastSnapshots;
   }
 
   /**
    * Grant access to the internal sample buffer.
    */
-  const std::vector<std::pair<wpi::units::second_t, T>>& GetInternalBuffer()
-      const {
+  const wpi::util::circular_buffer<std::pair<wpi::units::second_t, T>>&
+  GetInternalBuffer() const {
     return m_pastSnapshots;
   }
 
  private:
+  static constexpr size_t kInitialCapacity = 16;
+
+  /**
+   * Doubles the capacity if the buffer is full. Old samples are removed
+   * before new ones are added, so the capacity stops growing once it can hold
+   * the history window.
+   */
+  void Reserve() {
+    if (m_pastSnapshots.size() == m_pastSnapshots.capacity()) {
+      m_pastSnapshots.resize(2 * m_pastSnapshots.capacity());
+    }
+  }
+
+  /**
+   * Returns the index of the first sample with a time greater than the given
+   * time, or the number of samples if there is none.
+   */
+  size_t UpperBound(wpi::units::second_t time) const {
+    // The buffer's iterators aren't random access, so search by index
+    size_t low = 0;
+    size_t high = m_pastSnapshots.size();
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (m_pastSnapshots[mid].first <= time) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  /**
+   * Returns the index of the first sample with a time no less than the given
+   * time, or the number of samples if there is none.
+   */
+  size_t LowerBound(wpi::units::second_t time) const {
+    size_t low = 0;
+    size_t high = m_pastSnapshots.size();
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (m_pastSnapshots[mid].first < time) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
   wpi::units::second_t m_historySize;
-  std::vector<std::pair<wpi::units::second_t, T>> m_pastSnapshots;
+  wpi::util::circular_buffer<std::pair<wpi::units::second_t, T>>
+      m_pastSnapshots{kInitialCapacity};
   std::function<T(const T&, const T&, double)> m_interpolatingFunc;
 };
 
@@ -4,10 +4,17 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <functional>
 #include <limits>
 #include <random>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace wpi::math {
 
@@ -44,9 +51,34 @@ class SimulatedAnnealing {
                                std::function<State(const State&)> neighbor,
                                std::function<double(const State&)> cost)
       : m_initialTemperature{initialTemperature},
-        m_neighbor{neighbor},
+        m_neighbor{[neighbor = std::move(neighbor)](
+                       const State& state, std::mt19937&) {
+          return neighbor(state);
+        }},
         m_cost{cost} {}
 
+  /**
+   * Constructor for Simulated Annealing that can be used for the same functions
+   * but with different initial states.
+   *
+   * The neighbor function draws its random numbers from the generator of the
+   * chain calling it, so seeded solves are reproducible.
+   *
+   * @param initialTemperature The initial temperature. Higher temperatures make
+   *     it more likely a worse state will be accepted during iteration, helping
+   *     to avoid local minima. The temperature is decreased over time.
+   * @param neighbor Function that generates a random neighbor of the current
+   *     state using the given random number generator.
+   * @param cost Function that returns the scalar cost of a state.
+   */
+  constexpr SimulatedAnnealing(
+      double initialTemperature,
+      std::function<State(const State&, std::mt19937&)> neighbor,
+      std::function<double(const State&)> cost)
+      : m_initialTemperature{initialTemperature},
+        m_neighbor{std::move(neighbor)},
+        m_cost{std::move(cost)} {}
+
   /**
    * Runs the Simulated Annealing algorithm.
    *
@@ -55,11 +87,85 @@ class SimulatedAnnealing {
    * @return The optimized state.
    */
   State Solve(const State& initialGuess, int iterations) {
+    std::random_device rd;
+    std::mt19937 gen{rd()};
+    return RunChain(initialGuess, iterations, gen).first;
+  }
+
+  /**
+   * Runs several independent chains of the Simulated Annealing algorithm in
+   * parallel and returns the best state found by any of them.
+   *
+   * Each chain starts from the initial guess with its own random number
+   * generator seeded from the seed and the chain index. The result only
+   * depends on the seed if the neighbor function only draws random numbers
+   * from the generator it's given. Ties between chains go to the lowest chain
+   * index.
+   *
+   * The neighbor and cost functions are called from multiple threads at once,
+   * so they must be thread-safe.
+   *
+   * @param initialGuess The initial state.
+   * @param iterations Number of iterations to run each chain.
+   * @param chains Number of chains to run.
+   * @param seed Seed for the chains' random number generators.
+   * @return The optimized state.
+   */
+  State Solve(const State& initialGuess, int iterations, int chains,
+              uint32_t seed) {
+    if (chains <= 1) {
+      std::seed_seq seq{seed, uint32_t{0}};
+      std::mt19937 gen{seq};
+      return RunChain(initialGuess, iterations, gen).first;
+    }
+
+    std::vector<State> minStates(chains, initialGuess);
+    std::vector<double> minCosts(chains,
+                                 std::numeric_limits<double>::infinity());
+
+    // Workers take chains in order until none are left
+    std::atomic<int> nextChain{0};
+    auto worker = [&] {
+      for (int chain = nextChain++; chain < chains; chain = nextChain++) {
+        std::seed_seq seq{seed, static_cast<uint32_t>(chain)};
+        std::mt19937 gen{seq};
+        auto [minState, minCost] = RunChain(initialGuess, iterations, gen);
+        minStates[chain] = std::move(minState);
+        minCosts[chain] = minCost;
+      }
+    };
+
+    unsigned int numThreads =
+        std::min(static_cast<unsigned int>(chains),
+                 std::max(std::thread::hardware_concurrency(), 1u));
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (unsigned int i = 0; i < numThreads - 1; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    auto best = std::min_element(minCosts.begin(), minCosts.end());
+    return minStates[best - minCosts.begin()];
+  }
+
+ private:
+  /**
+   * Runs one chain of the Simulated Annealing algorithm.
+   *
+   * @param initialGuess The initial state.
+   * @param iterations Number of iterations to run the solver.
+   * @param gen Random number generator for the chain.
+   * @return The optimized state and its cost.
+   */
+  std::pair<State, double> RunChain(const State& initialGuess, int iterations,
+                                    std::mt19937& gen) const {
     State minState = initialGuess;
     double minCost = std::numeric_limits<double>::infinity();
 
-    std::random_device rd;
-    std::mt19937 gen{rd()};
     std::uniform_real_distribution<> distr{0.0, 1.0};
 
     State state = initialGuess;
@@ -68,7 +174,7 @@ class SimulatedAnnealing {
     for (int i = 0; i < iterations; ++i) {
       double temperature = m_initialTemperature / i;
 
-      State proposedState = m_neighbor(state);
+      State proposedState = m_neighbor(state, gen);
       double proposedCost = m_cost(proposedState);
       double deltaCost = proposedCost - cost;
 
@@ -89,12 +195,11 @@ class SimulatedAnnealing {
       }
     }
 
-    return minState;
+    return {minState, minCost};
   }
 
- private:
   double m_initialTemperature;
-  std::function<State(const State&)> m_neighbor;
+  std::function<State(const State&, std::mt19937&)> m_neighbor;
   std::function<double(const State&)> m_cost;
 };
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <algorithm>
 #include <cstddef>
 #include <functional>
@@ -62,8 +64,106 @@ class TravelingSalesman {
   template <size_t Poses>
   wpi::util::array<Pose2d, Poses> Solve(
       const wpi::util::array<Pose2d, Poses>& poses, int iterations) {
-    SimulatedAnnealing<Vectord<Poses>> solver{
-        1, &Neighbor<Poses>, [&](const Vectord<Poses>& state) {
+    return ToPath(poses, SolveIndices<Poses>(
+                             poses, [&](auto& solver, const auto& initial) {
+                               return solver.Solve(initial, iterations);
+                             }));
+  }
+
+  /**
+   * Finds the path through every pose that minimizes the cost. The first pose
+   * in the returned array is the first pose that was passed in.
+   *
+   * This overload supports a statically-sized list of poses. It runs several
+   * independent solver chains in parallel and returns the best path any of
+   * them found. The result is the same for the same seed. The cost function
+   * is called from multiple threads at once, so it must be thread-safe.
+   *
+   * @tparam Poses The length of the path and the number of poses.
+   * @param poses An array of Pose2ds the path must pass through.
+   * @param iterations The number of times each solver chain attempts to find a
+   *     better random neighbor.
+   * @param chains The number of solver chains to run.
+   * @param seed Seed for the solver chains' random number generators.
+   * @return The optimized path as an array of Pose2ds.
+   */
+  template <size_t Poses>
+  wpi::util::array<Pose2d, Poses> Solve(
+      const wpi::util::array<Pose2d, Poses>& poses, int iterations, int chains,
+      uint32_t seed) {
+    return ToPath(poses, SolveIndices<Poses>(
+                             poses, [&](auto& solver, const auto& initial) {
+                               return solver.Solve(initial, iterations, chains,
+                                                   seed);
+                             }));
+  }
+
+  /**
+   * Finds the path through every pose that minimizes the cost. The first pose
+   * in the returned array is the first pose that was passed in.
+   *
+   * This overload supports a dynamically-sized list of poses for Python to use.
+   *
+   * @param poses An array of Pose2ds the path must pass through.
+   * @param iterations The number of times the solver attempts to find a better
+   *     random neighbor.
+   * @return The optimized path as an array of Pose2ds.
+   */
+  std::vector<Pose2d> Solve(std::span<const Pose2d> poses, int iterations) {
+    return ToPath(poses, SolveIndices<Eigen::Dynamic>(
+                             poses, [&](auto& solver, const auto& initial) {
+                               return solver.Solve(initial, iterations);
+                             }));
+  }
+
+  /**
+   * Finds the path through every pose that minimizes the cost. The first pose
+   * in the returned array is the first pose that was passed in.
+   *
+   * This overload supports a dynamically-sized list of poses. It runs several
+   * independent solver chains in parallel and returns the best path any of
+   * them found. The result is the same for the same seed. The cost function
+   * is called from multiple threads at once, so it must be thread-safe.
+   *
+   * @param poses An array of Pose2ds the path must pass through.
+   * @param iterations The number of times each solver chain attempts to find a
+   *     better random neighbor.
+   * @param chains The number of solver chains to run.
+   * @param seed Seed for the solver chains' random number generators.
+   * @return The optimized path as an array of Pose2ds.
+   */
+  std::vector<Pose2d> Solve(std::span<const Pose2d> poses, int iterations,
+                            int chains, uint32_t seed) {
+    return ToPath(poses, SolveIndices<Eigen::Dynamic>(
+                             poses, [&](auto& solver, const auto& initial) {
+                               return solver.Solve(initial, iterations, chains,
+                                                   seed);
+                             }));
+  }
+
+ private:
+  // Default cost is distance between poses
+  std::function<double(const Pose2d&, const Pose2d&)> m_cost =
+      [](const Pose2d& a, const Pose2d& b) -> double {
+    return wpi::units::math::hypot(a.X() - b.X(), a.Y() - b.Y()).value();
+  };
+
+  /**
+   * Finds the order of poses that minimizes the cost.
+   *
+   * @tparam Poses The length of the path and the number of poses, or
+   *     Eigen::Dynamic.
+   * @param poses The poses the path must pass through.
+   * @param solve Function that runs the given solver from the given initial
+   *     state.
+   * @return A vector of indices into poses that defines the path.
+   */
+  template <int Poses, typename Solve>
+  Eigen::Vector<double, Poses> SolveIndices(std::span<const Pose2d> poses,
+                                            Solve&& solve) {
+    SimulatedAnnealing<Eigen::Vector<double, Poses>> solver{
+        1.0, &Neighbor<Poses>,
+        [&](const Eigen::Vector<double, Poses>& state) {
           // Total cost is sum of all costs between adjacent pairs in path
           double sum = 0.0;
           for (int i = 0; i < state.rows(); ++i) {
@@ -75,12 +175,27 @@ class TravelingSalesman {
         }};
 
     Eigen::Vector<double, Poses> initial;
+    initial.resize(poses.size());
     for (int i = 0; i < initial.rows(); ++i) {
       initial(i) = i;
     }
 
-    auto indices = solver.Solve(initial, iterations);
+    return solve(solver, initial);
+  }
 
+  /**
+   * Returns the poses in the order given by indices, rotated so the path
+   * starts at the first pose.
+   *
+   * @tparam Poses The length of the path and the number of poses.
+   * @param poses The poses the path passes through.
+   * @param indices A vector of indices into poses that defines the path.
+   * @return The path as an array of Pose2ds.
+   */
+  template <size_t Poses>
+  static wpi::util::array<Pose2d, Poses> ToPath(
+      const wpi::util::array<Pose2d, Poses>& poses,
+      const Eigen::Vector<double, static_cast<int>(Poses)>& indices) {
     wpi::util::array<Pose2d, Poses> solution{wpi::util::empty_array};
     for (size_t i = 0; i < poses.size(); ++i) {
       solution[i] = poses[static_cast<int>(indices[i])];
@@ -95,36 +210,15 @@ class TravelingSalesman {
   }
 
   /**
-   * Finds the path through every pose that minimizes the cost. The first pose
-   * in the returned array is the first pose that was passed in.
+   * Returns the poses in the order given by indices, rotated so the path
+   * starts at the first pose.
    *
-   * This overload supports a dynamically-sized list of poses for Python to use.
-   *
-   * @param poses An array of Pose2ds the path must pass through.
-   * @param iterations The number of times the solver attempts to find a better
-   *     random neighbor.
-   * @return The optimized path as an array of Pose2ds.
+   * @param poses The poses the path passes through.
+   * @param indices A vector of indices into poses that defines the path.
+   * @return The path as a vector of Pose2ds.
    */
-  std::vector<Pose2d> Solve(std::span<const Pose2d> poses, int iterations) {
-    SimulatedAnnealing<Eigen::VectorXd> solver{
-        1.0, &Neighbor<Eigen::Dynamic>, [&](const Eigen::VectorXd& state) {
-          // Total cost is sum of all costs between adjacent pairs in path
-          double sum = 0.0;
-          for (int i = 0; i < state.rows(); ++i) {
-            sum +=
-                m_cost(poses[static_cast<int>(state(i))],
-                       poses[static_cast<int>(state((i + 1) % poses.size()))]);
-          }
-          return sum;
-        }};
-
-    Eigen::VectorXd initial{poses.size()};
-    for (int i = 0; i < initial.rows(); ++i) {
-      initial(i) = i;
-    }
-
-    auto indices = solver.Solve(initial, iterations);
-
+  static std::vector<Pose2d> ToPath(std::span<const Pose2d> poses,
+                                    const Eigen::VectorXd& indices) {
     std::vector<Pose2d> solution;
     for (size_t i = 0; i < poses.size(); ++i) {
       solution.emplace_back(poses[static_cast<int>(indices[i])]);
@@ -138,29 +232,21 @@ class TravelingSalesman {
     return solution;
   }
 
- private:
-  // Default cost is distance between poses
-  std::function<double(const Pose2d&, const Pose2d&)> m_cost =
-      [](const Pose2d& a, const Pose2d& b) -> double {
-    return wpi::units::math::hypot(a.X() - b.X(), a.Y() - b.Y()).value();
-  };
-
   /**
    * A random neighbor is generated to try to replace the current one.
    *
    * @tparam Poses The length of the path and the number of poses.
    * @param state A vector that is a list of indices that defines the path
    *     through the path array.
+   * @param gen Random number generator.
    * @return Generates a random neighbor of the current state by flipping a
    *     random range in the path array.
    */
   template <int Poses>
   static Eigen::Vector<double, Poses> Neighbor(
-      const Eigen::Vector<double, Poses>& state) {
+      const Eigen::Vector<double, Poses>& state, std::mt19937& gen) {
     Eigen::Vector<double, Poses> proposedState = state;
 
-    std::random_device rd;
-    std::mt19937 gen{rd()};
     std::uniform_int_distribution<> distr{0,
                                           static_cast<int>(state.rows()) - 1};
 
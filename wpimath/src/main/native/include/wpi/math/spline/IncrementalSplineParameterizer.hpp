@@ -0,0 +1,178 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "wpi/math/spline/Spline.hpp"
+#include "wpi/math/spline/SplineParameterizer.hpp"
+
+namespace wpi::math {
+
+/**
+ * Parameterizes a path made of splines, reusing the points from the previous
+ * call for splines whose control vectors haven't changed. This is useful for
+ * regenerating a trajectory on the fly when only some of its waypoints move.
+ *
+ * The points of each spline are kept in buffers owned by this object, and the
+ * path is copied into a caller-provided vector. Once the buffers have grown to
+ * fit the path, regenerating it on the calling thread doesn't allocate.
+ *
+ * @tparam Degree The degree of the splines.
+ */
+template <int Degree>
+class IncrementalSplineParameterizer {
+ public:
+  using PoseWithCurvature = SplineParameterizer::PoseWithCurvature;
+
+  /**
+   * Constructs an IncrementalSplineParameterizer.
+   *
+   * @param maxThreads The maximum number of threads used to parameterize the
+   *     splines that changed. One parameterizes them on the calling thread.
+   */
+  explicit IncrementalSplineParameterizer(int maxThreads = 1)
+      : m_maxThreads{std::max(maxThreads, 1)} {}
+
+  /**
+   * Generate spline points from a vector of splines by parameterizing the
+   * splines that changed since the last call. Any points already in the given
+   * vector are removed, but its storage is reused.
+   *
+   * The result is the same as
+   * DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines().
+   *
+   * @param splines The splines to parameterize.
+   * @param splinePoints The vector to fill with the spline points for use in
+   *     time parameterization of a trajectory.
+   * @throws SplineParameterizer::MalformedSplineException if a spline is
+   *     malformed.
+   */
+  template <typename SplineType>
+    requires std::derived_from<SplineType, Spline<Degree>>
+  void SplinePointsFromSplines(const std::vector<SplineType>& splines,
+                               std::vector<PoseWithCurvature>& splinePoints) {
+    if (m_entries.size() != splines.size()) {
+      m_entries.resize(splines.size());
+    }
+
+    m_changed.clear();
+    for (size_t i = 0; i < splines.size(); ++i) {
+      auto& entry = m_entries[i];
+      if (!entry.controlVectors ||
+          !Equals(entry.controlVectors->first,
+                  splines[i].GetInitialControlVector()) ||
+          !Equals(entry.controlVectors->second,
+                  splines[i].GetFinalControlVector())) {
+        // Invalidate the entry until it's parameterized in case that throws
+        entry.controlVectors.reset();
+        m_changed.push_back(i);
+      }
+    }
+
+    ParameterizeChanged(splines);
+
+    splinePoints.clear();
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+      const auto& points = m_entries[i].points;
+
+      // Every spline after the first starts with a duplicate of the last point
+      // from the previous spline, so skip it.
+      splinePoints.insert(splinePoints.end(), points.begin() + (i > 0 ? 1 : 0),
+                          points.end());
+    }
+  }
+
+  /**
+   * Forgets the splines from previous calls, so the next call parameterizes
+   * every spline. The point buffers are kept for reuse.
+   */
+  void Reset() {
+    for (auto& entry : m_entries) {
+      entry.controlVectors.reset();
+    }
+  }
+
+ private:
+  using ControlVector = typename Spline<Degree>::ControlVector;
+
+  struct Entry {
+    // The initial and final control vectors of the spline the points came
+    // from, or empty if the points are stale
+    std::optional<std::pair<ControlVector, ControlVector>> controlVectors;
+    std::vector<PoseWithCurvature> points;
+  };
+
+  int m_maxThreads;
+  std::vector<Entry> m_entries;
+
+  // Indices of the splines that need to be parameterized
+  std::vector<size_t> m_changed;
+
+  static bool Equals(const ControlVector& a, const ControlVector& b) {
+    return a.x == b.x && a.y == b.y;
+  }
+
+  template <typename SplineType>
+  void Parameterize(const SplineType& spline, Entry& entry) {
+    entry.points.clear();
+    SplineParameterizer::Parameterize(spline, entry.points);
+    entry.controlVectors.emplace(spline.GetInitialControlVector(),
+                                 spline.GetFinalControlVector());
+  }
+
+  template <typename SplineType>
+  void ParameterizeChanged(const std::vector<SplineType>& splines) {
+    size_t numThreads =
+        std::min(static_cast<size_t>(m_maxThreads), m_changed.size());
+    if (numThreads <= 1) {
+      for (size_t i : m_changed) {
+        Parameterize(splines[i], m_entries[i]);
+      }
+      return;
+    }
+
+    // Workers take splines in order until none are left. Each spline writes
+    // only to its own entry, so the workers don't need to synchronize.
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto worker = [&](size_t thread) {
+      try {
+        for (size_t j = next++; j < m_changed.size(); j = next++) {
+          size_t i = m_changed[j];
+          Parameterize(splines[i], m_entries[i]);
+        }
+      } catch (...) {
+        errors[thread] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (size_t thread = 1; thread < numThreads; ++thread) {
+      threads.emplace_back(worker, thread);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (auto& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+};
+
+}  // namespace wpi::math
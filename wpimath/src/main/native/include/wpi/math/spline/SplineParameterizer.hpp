@@ -28,7 +28,6 @@
 
 #pragma once
 
-#include <stack>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -39,6 +38,7 @@
 #include "wpi/units/curvature.hpp"
 #include "wpi/units/length.hpp"
 #include "wpi/units/math.hpp"
+#include "wpi/util/SmallVector.hpp"
 #include "wpi/util/SymbolExports.hpp"
 
 namespace wpi::math {
@@ -72,11 +72,35 @@ class WPILIB_DLLEXPORT SplineParameterizer {
   static std::vector<PoseWithCurvature> Parameterize(const Spline<Dim>& spline,
                                                      double t0 = 0.0,
                                                      double t1 = 1.0) {
+    std::vector<PoseWithCurvature> splinePoints;
+    Parameterize(spline, splinePoints, t0, t1);
+    return splinePoints;
+  }
+
+  /**
+   * Parametrizes the spline into the given vector. This method breaks up the
+   * spline into various arcs until their dx, dy, and dtheta are within
+   * specific tolerances.
+   *
+   * The points are appended to the vector, so reusing a vector across calls
+   * avoids reallocating it.
+   *
+   * @param spline The spline to parameterize.
+   * @param splinePoints The vector to which the poses and curvatures that
+   * represent various points on the spline are appended.
+   * @param t0 Starting internal spline parameter. It is recommended to leave
+   * this as default.
+   * @param t1 Ending internal spline parameter. It is recommended to leave this
+   * as default.
+   */
+  template <int Dim>
+  static void Parameterize(const Spline<Dim>& spline,
+                           std::vector<PoseWithCurvature>& splinePoints,
+                           double t0 = 0.0, double t1 = 1.0) {
     constexpr const char* kMalformedSplineExceptionMsg =
         "Could not parameterize a malformed spline. This means that you "
         "probably had two or more adjacent waypoints that were very close "
         "together with headings in opposing directions.";
-    std::vector<PoseWithCurvature> splinePoints;
 
     // The parameterization does not add the initial point. Let's add that.
     if (auto point = spline.GetPoint(t0)) {
@@ -86,15 +110,16 @@ class WPILIB_DLLEXPORT SplineParameterizer {
     }
 
     // We use an "explicit stack" to simulate recursion, instead of a recursive
-    // function call This give us greater control, instead of a stack overflow
-    std::stack<StackContents> stack;
-    stack.emplace(StackContents{t0, t1});
+    // function call This give us greater control, instead of a stack overflow.
+    // The stack stays shallow, so it normally doesn't leave inline storage.
+    wpi::util::SmallVector<StackContents, 64> stack;
+    stack.emplace_back(StackContents{t0, t1});
 
     int iterations = 0;
 
     while (!stack.empty()) {
-      auto current = stack.top();
-      stack.pop();
+      auto current = stack.back();
+      stack.pop_back();
 
       auto start = spline.GetPoint(current.t0);
       if (!start) {
@@ -111,8 +136,10 @@ class WPILIB_DLLEXPORT SplineParameterizer {
       if (wpi::units::math::abs(twist.dy) > kMaxDy ||
           wpi::units::math::abs(twist.dx) > kMaxDx ||
           wpi::units::math::abs(twist.dtheta) > kMaxDtheta) {
-        stack.emplace(StackContents{(current.t0 + current.t1) / 2, current.t1});
-        stack.emplace(StackContents{current.t0, (current.t0 + current.t1) / 2});
+        stack.emplace_back(
+            StackContents{(current.t0 + current.t1) / 2, current.t1});
+        stack.emplace_back(
+            StackContents{current.t0, (current.t0 + current.t1) / 2});
       } else {
         splinePoints.push_back(end.value());
       }
@@ -121,8 +148,6 @@ class WPILIB_DLLEXPORT SplineParameterizer {
         throw MalformedSplineException(kMalformedSplineExceptionMsg);
       }
     }
-
-    return splinePoints;
   }
 
  private:
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -98,21 +99,43 @@ class WPILIB_DLLEXPORT DrivetrainSplineTrajectoryGenerator {
       const std::vector<Spline>& splines) {
     // Create the vector of spline points.
     std::vector<PoseWithCurvature> splinePoints;
+    SplinePointsFromSplines(splines, splinePoints);
+    return splinePoints;
+  }
 
-    // Add the first point to the vector.
-    splinePoints.push_back(splines.front().GetPoint(0.0).value());
+  /**
+   * Generate spline points from a vector of splines by parameterizing the
+   * splines into the given vector. Any points already in the vector are
+   * removed, but its storage is reused.
+   *
+   * @param splines The splines to parameterize.
+   * @param splinePoints The vector to fill with the spline points for use in
+   * time parameterization of a trajectory.
+   */
+  template <typename Spline>
+  static void SplinePointsFromSplines(
+      const std::vector<Spline>& splines,
+      std::vector<PoseWithCurvature>& splinePoints) {
+    splinePoints.clear();
 
     // Iterate through the vector and parameterize each spline, adding the
     // parameterized points to the final vector.
-    for (auto&& spline : splines) {
-      auto points = SplineParameterizer::Parameterize(spline);
-      // Append the array of poses to the vector. We are removing the first
-      // point because it's a duplicate of the last point from the previous
-      // spline.
-      splinePoints.insert(std::end(splinePoints), std::begin(points) + 1,
-                          std::end(points));
+    for (size_t i = 0; i < splines.size(); ++i) {
+      if (i == 0) {
+        SplineParameterizer::Parameterize(splines[i], splinePoints);
+        continue;
+      }
+
+      // The first point of every spline after the first is a duplicate of the
+      // last point from the previous spline. Keep the previous spline's point
+      // by writing it over the duplicate, rather than erasing the duplicate
+      // and shifting the rest of the spline's points down.
+      PoseWithCurvature last = splinePoints.back();
+      splinePoints.pop_back();
+      size_t start = splinePoints.size();
+      SplineParameterizer::Parameterize(splines[i], splinePoints);
+      splinePoints[start] = last;
     }
-    return splinePoints;
   }
 
   /**
@@ -4,9 +4,11 @@
 
 #include "wpi/math/controller/LTVDifferentialDriveController.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <numbers>
+#include <stdexcept>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -117,3 +119,100 @@ TEST_CASE("LTVDifferentialDriveControllerTest ReachesReference", "[wpimath]") {
                                            robotPose.Rotation().Radians()),
                    0_rad, kAngularTolerance);
 }
+
+TEST_CASE("LTVDifferentialDriveControllerTest ReachesReferenceWithGainTable",
+          "[wpimath]") {
+  constexpr wpi::units::second_t kDt = 20_ms;
+
+  wpi::math::LTVDifferentialDriveController controller{
+      plant, kTrackwidth, {0.0625, 0.125, 2.5, 0.95, 0.95}, {12.0, 12.0}, kDt,
+      9_mps};
+  wpi::math::Pose2d robotPose{2.7_m, 23_m, 0_deg};
+  wpi::math::DifferentialDriveKinematics kinematics{kTrackwidth};
+
+  auto waypoints = std::vector{wpi::math::Pose2d{2.75_m, 22.521_m, 0_rad},
+                               wpi::math::Pose2d{24.73_m, 19.68_m, 5.846_rad}};
+  auto trajectory = wpi::math::DrivetrainSplineTrajectoryGenerator::Generate(
+      waypoints, {8.8_mps, 0.1_mps_sq});
+
+  wpi::math::Vectord<5> x = wpi::math::Vectord<5>::Zero();
+  x(State::kX) = robotPose.X().value();
+  x(State::kY) = robotPose.Y().value();
+  x(State::kHeading) = robotPose.Rotation().Radians().value();
+
+  auto duration = trajectory.Duration();
+  for (size_t i = 0; i < (duration / kDt).value(); ++i) {
+    wpi::math::DifferentialSample state{trajectory.SampleAt(kDt * i),
+                                        kinematics};
+    robotPose = wpi::math::Pose2d{wpi::units::meter_t{x(State::kX)},
+                                  wpi::units::meter_t{x(State::kY)},
+                                  wpi::units::radian_t{x(State::kHeading)}};
+    auto [leftVoltage, rightVoltage] = controller.Calculate(
+        robotPose, wpi::units::meters_per_second_t{x(State::kLeftVelocity)},
+        wpi::units::meters_per_second_t{x(State::kRightVelocity)}, state);
+
+    x = wpi::math::RKDP(
+        &Dynamics, x,
+        wpi::math::Vectord<2>{leftVoltage.value(), rightVoltage.value()}, kDt);
+  }
+
+  auto& endPose = trajectory.Samples().back().pose;
+  CHECK_NEAR_UNITS(endPose.X(), robotPose.X(), kTolerance);
+  CHECK_NEAR_UNITS(endPose.Y(), robotPose.Y(), kTolerance);
+  CHECK_NEAR_UNITS(wpi::math::AngleModulus(endPose.Rotation().Radians() -
+                                           robotPose.Rotation().Radians()),
+                   0_rad, kAngularTolerance);
+}
+
+// Returns the largest output difference between a gain table controller with
+// the given velocity step and a controller that solves the DARE every call
+static double MaxGainTableError(wpi::units::meters_per_second_t velocityStep) {
+  constexpr wpi::units::second_t kDt = 20_ms;
+  wpi::math::LTVDifferentialDriveController exact{
+      plant, kTrackwidth, {0.0625, 0.125, 2.5, 0.95, 0.95}, {12.0, 12.0}, kDt};
+  wpi::math::LTVDifferentialDriveController table{
+      plant, kTrackwidth, {0.0625, 0.125, 2.5, 0.95, 0.95}, {12.0, 12.0}, kDt,
+      4_mps, velocityStep};
+
+  const wpi::math::Pose2d poseRef{1_m, 2_m, 30_deg};
+  const wpi::math::Pose2d currentPose{0.9_m, 2.1_m, 25_deg};
+
+  double maxError = 0.0;
+  // Use velocities that fall between grid points
+  for (double v = -3.999; v < 4.0; v += 0.0371) {
+    wpi::units::meters_per_second_t left{v - 0.1};
+    wpi::units::meters_per_second_t right{v + 0.1};
+    auto expected =
+        exact.Calculate(currentPose, left, right, poseRef, left, right);
+    auto actual =
+        table.Calculate(currentPose, left, right, poseRef, left, right);
+    maxError =
+        std::max({maxError, std::abs((actual.left - expected.left).value()),
+                  std::abs((actual.right - expected.right).value())});
+  }
+  return maxError;
+}
+
+TEST_CASE("LTVDifferentialDriveControllerTest GainTableMatchesDARE",
+          "[wpimath]") {
+  double coarseError = MaxGainTableError(0.5_mps);
+  double defaultError = MaxGainTableError(0.01_mps);
+
+  CHECK(coarseError < 0.25);
+  CHECK(defaultError < 1e-3);
+  // A denser grid is more accurate
+  CHECK(defaultError < coarseError);
+}
+
+TEST_CASE(
+    "LTVDifferentialDriveControllerTest GainTableRejectsInvalidArguments",
+    "[wpimath]") {
+  CHECK_THROWS_AS((wpi::math::LTVDifferentialDriveController{
+                      plant, kTrackwidth, {0.0625, 0.125, 2.5, 0.95, 0.95},
+                      {12.0, 12.0}, 20_ms, 0_mps}),
+                  std::invalid_argument);
+  CHECK_THROWS_AS((wpi::math::LTVDifferentialDriveController{
+                      plant, kTrackwidth, {0.0625, 0.125, 2.5, 0.95, 0.95},
+                      {12.0, 12.0}, 20_ms, 4_mps, 0_mps}),
+                  std::invalid_argument);
+}
@@ -4,8 +4,11 @@
 
 #include "wpi/math/controller/LTVUnicycleController.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <numbers>
+#include <stdexcept>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -16,6 +19,7 @@
 #include "wpi/math/util/MathUtil.hpp"
 #include "wpi/units/acceleration.hpp"
 #include "wpi/units/angle.hpp"
+#include "wpi/units/angular_velocity.hpp"
 #include "wpi/units/length.hpp"
 #include "wpi/units/math.hpp"
 #include "wpi/units/time.hpp"
@@ -57,3 +61,80 @@ TEST_CASE("LTVUnicycleControllerTest ReachesReference", "[wpimath]") {
                                            robotPose.Rotation().Radians()),
                    0_rad, kAngularTolerance);
 }
+
+TEST_CASE("LTVUnicycleControllerTest ReachesReferenceWithGainTable",
+          "[wpimath]") {
+  constexpr wpi::units::second_t kDt = 20_ms;
+
+  wpi::math::LTVUnicycleController controller{
+      {0.0625, 0.125, 2.5}, {4.0, 4.0}, kDt, 9_mps};
+  wpi::math::Pose2d robotPose{2.7_m, 23_m, 0_deg};
+
+  auto waypoints = std::vector{wpi::math::Pose2d{2.75_m, 22.521_m, 0_rad},
+                               wpi::math::Pose2d{24.73_m, 19.68_m, 5.846_rad}};
+  auto trajectory = wpi::math::DrivetrainSplineTrajectoryGenerator::Generate(
+      waypoints, {8.8_mps, 0.1_mps_sq});
+
+  auto duration = trajectory.Duration();
+  for (size_t i = 0; i < (duration / kDt).value(); ++i) {
+    auto state = trajectory.SampleAt(kDt * i);
+    auto [vx, vy, omega] = controller.Calculate(robotPose, state);
+    static_cast<void>(vy);
+
+    robotPose =
+        robotPose + wpi::math::Twist2d{vx * kDt, 0_m, omega * kDt}.Exp();
+  }
+
+  auto& endPose = trajectory.Samples().back().pose;
+  CHECK_NEAR_UNITS(endPose.X(), robotPose.X(), kTolerance);
+  CHECK_NEAR_UNITS(endPose.Y(), robotPose.Y(), kTolerance);
+  CHECK_NEAR_UNITS(wpi::math::AngleModulus(endPose.Rotation().Radians() -
+                                           robotPose.Rotation().Radians()),
+                   0_rad, kAngularTolerance);
+}
+
+// Returns the largest output difference between a gain table controller with
+// the given velocity step and a controller that solves the DARE every call
+static double MaxGainTableError(wpi::units::meters_per_second_t velocityStep) {
+  constexpr wpi::units::second_t kDt = 20_ms;
+  wpi::math::LTVUnicycleController exact{
+      {0.0625, 0.125, 2.0}, {1.0, 2.0}, kDt};
+  wpi::math::LTVUnicycleController table{
+      {0.0625, 0.125, 2.0}, {1.0, 2.0}, kDt, 4_mps, velocityStep};
+
+  const wpi::math::Pose2d poseRef{1_m, 2_m, 30_deg};
+  const wpi::math::Pose2d currentPose{0.9_m, 2.1_m, 25_deg};
+
+  double maxError = 0.0;
+  // Use velocities that fall between grid points
+  for (double v = -3.999; v < 4.0; v += 0.0371) {
+    wpi::units::meters_per_second_t velocity{v};
+    auto expected =
+        exact.Calculate(currentPose, poseRef, velocity, 0.5_rad_per_s);
+    auto actual =
+        table.Calculate(currentPose, poseRef, velocity, 0.5_rad_per_s);
+    maxError = std::max({maxError, std::abs((actual.vx - expected.vx).value()),
+                         std::abs((actual.omega - expected.omega).value())});
+  }
+  return maxError;
+}
+
+TEST_CASE("LTVUnicycleControllerTest GainTableMatchesDARE", "[wpimath]") {
+  double coarseError = MaxGainTableError(0.5_mps);
+  double defaultError = MaxGainTableError(0.01_mps);
+
+  CHECK(coarseError < 1e-1);
+  CHECK(defaultError < 1e-3);
+  // A denser grid is more accurate
+  CHECK(defaultError < coarseError);
+}
+
+TEST_CASE("LTVUnicycleControllerTest GainTableRejectsInvalidArguments",
+          "[wpimath]") {
+  CHECK_THROWS_AS((wpi::math::LTVUnicycleController{
+                      {0.0625, 0.125, 2.0}, {1.0, 2.0}, 20_ms, 0_mps}),
+                  std::invalid_argument);
+  CHECK_THROWS_AS((wpi::math::LTVUnicycleController{
+                      {0.0625, 0.125, 2.0}, {1.0, 2.0}, 20_ms, 4_mps, 0_mps}),
+                  std::invalid_argument);
+}
@@ -252,6 +252,60 @@ TEST_CASE("MerweUKFTest RoundTripP", "[wpimath]") {
   REQUIRE(observer.P().isApprox(P));
 }
 
+template <int Cols>
+void DriveDynamicsBatch(const wpi::math::Matrixd<5, Cols>& x,
+                        const wpi::math::Vectord<2>& u,
+                        wpi::math::Matrixd<5, Cols>& xdot) {
+  for (int i = 0; i < Cols; ++i) {
+    xdot.col(i) = DriveDynamics(x.col(i), u);
+  }
+}
+
+template <int Cols>
+void DriveLocalMeasurementModelBatch(
+    const wpi::math::Matrixd<5, Cols>& x,
+    [[maybe_unused]] const wpi::math::Vectord<2>& u,
+    wpi::math::Matrixd<3, Cols>& y) {
+  y = x.template bottomRows<3>();
+}
+
+TEST_CASE("MerweUKFTest BatchedMatchesScalar", "[wpimath]") {
+  constexpr wpi::units::second_t dt = 5_ms;
+  using Observer = wpi::math::MerweUKF<5, 2, 3>;
+  constexpr int NumSigmas = Observer::NumSigmas;
+
+  Observer scalar{DriveDynamics, DriveLocalMeasurementModel,
+                  wpi::util::array{0.5, 0.5, 10.0, 1.0, 1.0},
+                  wpi::util::array{0.0001, 0.01, 0.01}, dt};
+  Observer batched{DriveDynamics, DriveLocalMeasurementModel,
+                   wpi::util::array{0.5, 0.5, 10.0, 1.0, 1.0},
+                   wpi::util::array{0.0001, 0.01, 0.01}, dt};
+
+  wpi::math::Vectord<5> x{1.0, 2.0, 0.5, 0.0, 0.0};
+  wpi::math::Matrixd<5, 5> P =
+      wpi::math::Vectord<5>{0.01, 0.01, 0.01, 0.1, 0.1}.asDiagonal();
+  scalar.SetXhat(x);
+  scalar.SetP(P);
+  batched.SetXhat(x);
+  batched.SetP(P);
+
+  wpi::math::Vectord<2> u{12.0, 11.0};
+  auto R = wpi::math::CovarianceMatrix(0.0001, 0.01, 0.01);
+  for (int i = 0; i < 100; ++i) {
+    x = wpi::math::RK4(DriveDynamics, x, u, dt);
+    wpi::math::Vectord<3> y = DriveLocalMeasurementModel(x, u) +
+                              wpi::math::Vectord<3>{0.0, 0.1, -0.1};
+
+    scalar.Predict(u, dt);
+    batched.Predict(u, dt, DriveDynamicsBatch<NumSigmas>);
+    scalar.Correct<3>(u, y, DriveLocalMeasurementModel, R);
+    batched.Correct<3>(u, y, DriveLocalMeasurementModelBatch<NumSigmas>, R);
+  }
+
+  CHECK(scalar.Xhat().isApprox(batched.Xhat(), 1e-9));
+  CHECK(scalar.S().isApprox(batched.S(), 1e-9));
+}
+
 // Second system, single motor feedforward estimator
 wpi::math::Vectord<4> MotorDynamics(const wpi::math::Vectord<4>& x,
                                     const wpi::math::Vectord<1>& u) {
@@ -61,3 +61,56 @@ TEST_CASE("TimeInterpolatableBufferTest Pose2d", "[wpimath]") {
   CHECK(std::abs(sample.Y().value() - (1.0 / std::sqrt(2.0))) < 0.01);
   CHECK(std::abs(sample.Rotation().Degrees().value() - 45.0) < 0.01);
 }
+
+TEST_CASE("TimeInterpolatableBufferTest RemovesOldSamples", "[wpimath]") {
+  wpi::math::TimeInterpolatableBuffer<double> buffer{1_s};
+
+  // Add enough samples to grow the buffer and then wrap around it
+  for (int i = 0; i <= 1000; ++i) {
+    buffer.AddSample(i * 10_ms, i);
+  }
+
+  const auto& samples = buffer.GetInternalBuffer();
+  CHECK(samples.size() == 101u);
+  CHECK(samples.front().first == 9_s);
+  CHECK(samples.back().first == 10_s);
+  CHECK(buffer.Sample(8_s).value() == 900.0);
+  CHECK(std::abs(buffer.Sample(9.505_s).value() - 950.5) < 1e-6);
+
+  // Capacity stays fixed once the history window fits
+  size_t capacity = samples.capacity();
+  for (int i = 1001; i <= 2000; ++i) {
+    buffer.AddSample(i * 10_ms, i);
+  }
+  CHECK(samples.capacity() == capacity);
+  CHECK(samples.front().first == 19_s);
+}
+
+TEST_CASE("TimeInterpolatableBufferTest OutOfOrderAfterWraparound",
+          "[wpimath]") {
+  wpi::math::TimeInterpolatableBuffer<double> buffer{1_s};
+
+  for (int i = 0; i <= 500; ++i) {
+    buffer.AddSample(i * 10_ms, i);
+  }
+
+  // New entry in middle of container
+  buffer.AddSample(4.555_s, -1.0);
+  CHECK(buffer.Sample(4.555_s).value() == -1.0);
+  CHECK(buffer.Sample(4.55_s).value() == 455.0);
+  CHECK(buffer.Sample(4.56_s).value() == 456.0);
+
+  // New entry at start of container
+  buffer.AddSample(3.995_s, -2.0);
+  CHECK(buffer.GetInternalBuffer().front().first == 3.995_s);
+  CHECK(buffer.Sample(3.995_s).value() == -2.0);
+
+  // Override sample at start of container
+  buffer.AddSample(3.995_s, -3.0);
+  CHECK(buffer.Sample(3.995_s).value() == -3.0);
+
+  const auto& samples = buffer.GetInternalBuffer();
+  for (size_t i = 1; i < samples.size(); ++i) {
+    CHECK(samples[i - 1].first < samples[i].first);
+  }
+}
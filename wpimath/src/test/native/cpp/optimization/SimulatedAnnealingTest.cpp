@@ -59,3 +59,27 @@ TEST_CASE("SimulatedAnnealingTest DoubleFunctionOptimizationMultimodal",
 
   CHECK_NEAR(5.146, solution, 1e-1);
 }
+
+TEST_CASE("SimulatedAnnealingTest DoubleFunctionOptimizationParallelChains",
+          "[wpimath]") {
+  auto function = [](double x) {
+    return std::sin(x) + std::sin((10.0 / 3.0) * x);
+  };
+
+  constexpr double stepSize = 10.0;
+
+  wpi::math::SimulatedAnnealing<double> simulatedAnnealing{
+      2.0,
+      [&](const double& x, std::mt19937& gen) {
+        std::uniform_real_distribution<> distr{0.0, 1.0};
+        return std::clamp(x + (distr(gen) - 0.5) * stepSize, 0.0, 7.0);
+      },
+      [&](const double& x) { return function(x); }};
+
+  double solution = simulatedAnnealing.Solve(-1.0, 5000, 4, 42);
+
+  CHECK_NEAR(5.146, solution, 1e-1);
+
+  // The same seed gives the same solution
+  CHECK(solution == simulatedAnnealing.Solve(-1.0, 5000, 4, 42));
+}
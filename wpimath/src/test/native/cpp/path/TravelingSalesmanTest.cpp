@@ -151,3 +151,63 @@ TEST_CASE("TravelingSalesmanTest TenLengthDynamicPathWithDistanceCost",
 
   CHECK(IsMatchingCycle(expected, solution));
 }
+
+TEST_CASE("TravelingSalesmanTest TenLengthStaticPathWithParallelChains",
+          "[wpimath]") {
+  // ....6.3..1.2.......
+  // ..4................
+  // .............9.....
+  // .0.................
+  // .....7..5...8......
+  // ...................
+  wpi::util::array<wpi::math::Pose2d, 10> poses{
+      wpi::math::Pose2d{2_m, 4_m, 0_rad},  wpi::math::Pose2d{10_m, 1_m, 0_rad},
+      wpi::math::Pose2d{12_m, 1_m, 0_rad}, wpi::math::Pose2d{7_m, 1_m, 0_rad},
+      wpi::math::Pose2d{3_m, 2_m, 0_rad},  wpi::math::Pose2d{9_m, 5_m, 0_rad},
+      wpi::math::Pose2d{5_m, 1_m, 0_rad},  wpi::math::Pose2d{6_m, 5_m, 0_rad},
+      wpi::math::Pose2d{13_m, 5_m, 0_rad}, wpi::math::Pose2d{14_m, 3_m, 0_rad}};
+
+  wpi::math::TravelingSalesman traveler;
+  wpi::util::array<wpi::math::Pose2d, 10> solution =
+      traveler.Solve(poses, 500, 4, 1234);
+
+  wpi::util::array<wpi::math::Pose2d, 10> expected{
+      poses[0], poses[4], poses[6], poses[3], poses[1],
+      poses[2], poses[9], poses[8], poses[5], poses[7]};
+
+  CHECK(IsMatchingCycle(expected, solution));
+
+  // The same seed gives the same path
+  CHECK(solution == traveler.Solve(poses, 500, 4, 1234));
+}
+
+TEST_CASE("TravelingSalesmanTest TenLengthDynamicPathWithParallelChains",
+          "[wpimath]") {
+  // ....6.3..1.2.......
+  // ..4................
+  // .............9.....
+  // .0.................
+  // .....7..5...8......
+  // ...................
+  wpi::util::array<wpi::math::Pose2d, 10> poses{
+      wpi::math::Pose2d{2_m, 4_m, 0_rad},  wpi::math::Pose2d{10_m, 1_m, 0_rad},
+      wpi::math::Pose2d{12_m, 1_m, 0_rad}, wpi::math::Pose2d{7_m, 1_m, 0_rad},
+      wpi::math::Pose2d{3_m, 2_m, 0_rad},  wpi::math::Pose2d{9_m, 5_m, 0_rad},
+      wpi::math::Pose2d{5_m, 1_m, 0_rad},  wpi::math::Pose2d{6_m, 5_m, 0_rad},
+      wpi::math::Pose2d{13_m, 5_m, 0_rad}, wpi::math::Pose2d{14_m, 3_m, 0_rad}};
+
+  wpi::math::TravelingSalesman traveler;
+  std::vector<wpi::math::Pose2d> solution =
+      traveler.Solve(std::span<const wpi::math::Pose2d>{poses}, 500, 4, 1234);
+
+  REQUIRE(10u == solution.size());
+  wpi::util::array<wpi::math::Pose2d, 10> expected{
+      poses[0], poses[4], poses[6], poses[3], poses[1],
+      poses[2], poses[9], poses[8], poses[5], poses[7]};
+
+  CHECK(IsMatchingCycle(expected, solution));
+
+  // The same seed gives the same path
+  CHECK(solution == traveler.Solve(std::span<const wpi::math::Pose2d>{poses},
+                                   500, 4, 1234));
+}
@@ -0,0 +1,102 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/math/spline/IncrementalSplineParameterizer.hpp"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "wpi/math/geometry/Pose2d.hpp"
+#include "wpi/math/geometry/Translation2d.hpp"
+#include "wpi/math/spline/SplineHelper.hpp"
+#include "wpi/math/spline/SplineParameterizer.hpp"
+#include "wpi/math/trajectory/DrivetrainSplineTrajectoryGenerator.hpp"
+#include "wpi/units/angle.hpp"
+#include "wpi/units/length.hpp"
+
+using namespace wpi::math;
+
+namespace {
+
+std::vector<Pose2d> Waypoints() {
+  return {Pose2d{0_m, 0_m, 0_deg}, Pose2d{2_m, 1_m, 45_deg},
+          Pose2d{4_m, 3_m, 0_deg}, Pose2d{6_m, 2_m, -45_deg},
+          Pose2d{8_m, 0_m, 0_deg}};
+}
+
+}  // namespace
+
+TEST_CASE("IncrementalSplineParameterizerTest MatchesGenerator",
+          "[wpimath]") {
+  IncrementalSplineParameterizer<5> parameterizer;
+  std::vector<SplineParameterizer::PoseWithCurvature> points;
+
+  auto waypoints = Waypoints();
+  auto splines = SplineHelper::QuinticSplinesFromWaypoints(waypoints);
+  parameterizer.SplinePointsFromSplines(splines, points);
+  CHECK(points ==
+        DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(splines));
+
+  // Moving one waypoint only changes its two adjacent splines
+  waypoints[2] = Pose2d{4_m, 4_m, 10_deg};
+  splines = SplineHelper::QuinticSplinesFromWaypoints(waypoints);
+  parameterizer.SplinePointsFromSplines(splines, points);
+  CHECK(points ==
+        DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(splines));
+
+  // Removing a waypoint changes the number of splines
+  waypoints.pop_back();
+  splines = SplineHelper::QuinticSplinesFromWaypoints(waypoints);
+  parameterizer.SplinePointsFromSplines(splines, points);
+  CHECK(points ==
+        DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(splines));
+}
+
+TEST_CASE("IncrementalSplineParameterizerTest CubicSplines", "[wpimath]") {
+  IncrementalSplineParameterizer<3> parameterizer;
+  std::vector<SplineParameterizer::PoseWithCurvature> points;
+
+  std::vector<Translation2d> interiorWaypoints{Translation2d{2_m, 1_m},
+                                               Translation2d{4_m, 3_m}};
+  auto [start, end] = SplineHelper::CubicControlVectorsFromWaypoints(
+      Pose2d{0_m, 0_m, 0_deg}, interiorWaypoints, Pose2d{6_m, 2_m, 0_deg});
+  auto splines = SplineHelper::CubicSplinesFromControlVectors(
+      start, interiorWaypoints, end);
+
+  parameterizer.SplinePointsFromSplines(splines, points);
+  CHECK(points ==
+        DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(splines));
+}
+
+TEST_CASE("IncrementalSplineParameterizerTest ParallelMatchesSerial",
+          "[wpimath]") {
+  IncrementalSplineParameterizer<5> serial;
+  IncrementalSplineParameterizer<5> parallel{4};
+  std::vector<SplineParameterizer::PoseWithCurvature> serialPoints;
+  std::vector<SplineParameterizer::PoseWithCurvature> parallelPoints;
+
+  auto splines = SplineHelper::QuinticSplinesFromWaypoints(Waypoints());
+  serial.SplinePointsFromSplines(splines, serialPoints);
+  parallel.SplinePointsFromSplines(splines, parallelPoints);
+  CHECK(serialPoints == parallelPoints);
+}
+
+TEST_CASE("IncrementalSplineParameterizerTest RecoversFromMalformed",
+          "[wpimath]") {
+  IncrementalSplineParameterizer<5> parameterizer{2};
+  std::vector<SplineParameterizer::PoseWithCurvature> points;
+
+  auto waypoints = Waypoints();
+  waypoints[1] = Pose2d{1_m, 0_m, 180_deg};
+  auto splines = SplineHelper::QuinticSplinesFromWaypoints(waypoints);
+  CHECK_THROWS_AS(parameterizer.SplinePointsFromSplines(splines, points),
+                  SplineParameterizer::MalformedSplineException);
+
+  // Splines that failed are parameterized again on the next call
+  splines = SplineHelper::QuinticSplinesFromWaypoints(Waypoints());
+  parameterizer.SplinePointsFromSplines(splines, points);
+  CHECK(points ==
+        DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(splines));
+}
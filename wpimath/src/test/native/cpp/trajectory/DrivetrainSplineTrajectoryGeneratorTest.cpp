@@ -10,6 +10,8 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "wpi/math/geometry/Pose2d.hpp"
+#include "wpi/math/spline/SplineHelper.hpp"
+#include "wpi/math/spline/SplineParameterizer.hpp"
 #include "wpi/math/trajectory/TestDrivetrainSplineTrajectory.hpp"
 #include "wpi/math/trajectory/TrajectoryConfig.hpp"
 #include "wpi/units/acceleration.hpp"
@@ -61,3 +63,28 @@ TEST_CASE("DrivetrainSplineTrajectoryGeneratorTest CurvatureOptimization",
     CHECK(0 != t.Samples()[i].curvature.value());
   }
 }
+
+TEST_CASE("DrivetrainSplineTrajectoryGeneratorTest SplinePointsJoinSplines",
+          "[wpimath]") {
+  auto splines = SplineHelper::QuinticSplinesFromWaypoints(
+      {Pose2d{0_m, 0_m, 0_deg}, Pose2d{2_m, 1_m, 45_deg},
+       Pose2d{4_m, 4_m, 90_deg}, Pose2d{3_m, 6_m, 180_deg}});
+
+  // each spline's points, without the first point of every spline after the
+  // first, since it duplicates the last point of the previous spline
+  std::vector<SplineParameterizer::PoseWithCurvature> expected;
+  for (size_t i = 0; i < splines.size(); ++i) {
+    std::vector<SplineParameterizer::PoseWithCurvature> points;
+    SplineParameterizer::Parameterize(splines[i], points);
+    expected.insert(expected.end(), points.begin() + (i > 0 ? 1 : 0),
+                    points.end());
+  }
+
+  CHECK(DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(
+            splines) == expected);
+
+  // existing points are replaced
+  std::vector<SplineParameterizer::PoseWithCurvature> points(3);
+  DrivetrainSplineTrajectoryGenerator::SplinePointsFromSplines(splines, points);
+  CHECK(points == expected);
+}
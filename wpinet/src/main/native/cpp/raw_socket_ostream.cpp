@@ -5,6 +5,7 @@
 #include "wpi/net/raw_socket_ostream.hpp"
 
 #include "wpi/net/NetworkStream.hpp"
+#include "wpi/util/SmallVector.hpp"
 
 using namespace wpi::net;
 
@@ -29,6 +30,33 @@ void raw_socket_ostream::write_impl(const char* data, size_t len) {
   }
 }
 
+void raw_socket_ostream::writev(std::span<const std::string_view> bufs) {
+  flush();
+
+  wpi::util::SmallVector<std::string_view, 4> remaining{bufs.begin(),
+                                                        bufs.end()};
+  std::span<std::string_view> rest{remaining};
+  size_t count = 0;
+  for (;;) {
+    // skip past what has been sent, along with any empty buffers
+    while (!rest.empty() && count >= rest.front().size()) {
+      count -= rest.front().size();
+      rest = rest.subspan(1);
+    }
+    if (rest.empty()) {
+      return;
+    }
+    rest.front().remove_prefix(count);
+
+    NetworkStream::Error err;
+    count = m_stream.sendv(rest, &err);
+    if (count == 0) {
+      error_detected();
+      return;
+    }
+  }
+}
+
 uint64_t raw_socket_ostream::current_pos() const {
   return 0;
 }
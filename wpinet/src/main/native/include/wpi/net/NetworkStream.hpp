@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 #include <string_view>
 
 namespace wpi::net {
@@ -22,6 +23,25 @@ class NetworkStream {
   };
 
   virtual size_t send(const char* buffer, size_t len, Error* err) = 0;
+
+  // Sends the buffers in order, with a single system call where supported.
+  // Returns the total number of bytes sent, which may be less than the total
+  // size of the buffers.
+  virtual size_t sendv(std::span<const std::string_view> bufs, Error* err) {
+    size_t total = 0;
+    for (auto buf : bufs) {
+      if (buf.empty()) {
+        continue;
+      }
+      size_t count = send(buf.data(), buf.size(), err);
+      total += count;
+      if (count < buf.size()) {
+        break;
+      }
+    }
+    return total;
+  }
+
   virtual size_t receive(char* buffer, size_t len, Error* err,
                          int timeout = 0) = 0;
   virtual void close() = 0;
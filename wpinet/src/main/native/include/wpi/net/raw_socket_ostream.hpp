@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <span>
+#include <string_view>
+
 #include "wpi/util/raw_ostream.hpp"
 
 namespace wpi::net {
@@ -18,6 +21,10 @@ class raw_socket_ostream : public wpi::util::raw_ostream {
 
   void close();
 
+  // Flushes any buffered data, then writes the buffers in order without
+  // copying them, sending them together where the stream supports it.
+  void writev(std::span<const std::string_view> bufs);
+
   bool has_error() const { return m_error; }
   void clear_error() { m_error = false; }
 
@@ -31,11 +31,14 @@
 #else
 #include <arpa/inet.h>
 #include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 
 #include <cerrno>
 
+#include "wpi/util/SmallVector.hpp"
 #include "wpi/util/StringExtras.hpp"
 
 using namespace wpi::net;
@@ -64,17 +67,26 @@ TCPStream::~TCPStream() {
 }
 
 size_t TCPStream::send(const char* buffer, size_t len, Error* err) {
+  std::string_view buf{buffer, len};
+  return sendv({&buf, 1}, err);
+}
+
+size_t TCPStream::sendv(std::span<const std::string_view> bufs, Error* err) {
   if (m_sd < 0) {
     *err = Error::CONNECTION_CLOSED;
     return 0;
   }
 #ifdef _WIN32
-  WSABUF wsaBuf;
-  wsaBuf.buf = const_cast<char*>(buffer);
-  wsaBuf.len = (ULONG)len;
+  wpi::util::SmallVector<WSABUF, 4> wsaBufs;
+  for (auto buf : bufs) {
+    WSABUF& wsaBuf = wsaBufs.emplace_back();
+    wsaBuf.buf = const_cast<char*>(buf.data());
+    wsaBuf.len = (ULONG)buf.size();
+  }
   DWORD rv;
   bool result = true;
-  while (WSASend(m_sd, &wsaBuf, 1, &rv, 0, nullptr, nullptr) == SOCKET_ERROR) {
+  while (WSASend(m_sd, wsaBufs.data(), (DWORD)wsaBufs.size(), &rv, 0, nullptr,
+                 nullptr) == SOCKET_ERROR) {
     if (WSAGetLastError() != WSAEWOULDBLOCK) {
       result = false;
       break;
@@ -95,11 +107,18 @@ size_t TCPStream::send(const char* buffer, size_t len, Error* err) {
     return 0;
   }
 #else
+  wpi::util::SmallVector<iovec, 4> iovs;
+  for (auto buf : bufs) {
+    iovs.push_back({const_cast<char*>(buf.data()), buf.size()});
+  }
+  msghdr msg{};
+  msg.msg_iov = iovs.data();
+  msg.msg_iovlen = iovs.size();
 #ifdef MSG_NOSIGNAL
   // disable SIGPIPE on Linux
-  ssize_t rv = ::send(m_sd, buffer, len, MSG_NOSIGNAL);
+  ssize_t rv = ::sendmsg(m_sd, &msg, MSG_NOSIGNAL);
 #else
-  ssize_t rv = ::send(m_sd, buffer, len, 0);
+  ssize_t rv = ::sendmsg(m_sd, &msg, 0);
 #endif
   if (rv < 0) {
     if (!m_blocking && (errno == EAGAIN || errno == EWOULDBLOCK)) {
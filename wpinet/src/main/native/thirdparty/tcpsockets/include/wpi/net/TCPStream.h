@@ -25,6 +25,7 @@
 #define WPINET_TCPSTREAM_H_
 
 #include <cstddef>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -47,6 +48,7 @@ class TCPStream : public NetworkStream {
   ~TCPStream() override;
 
   size_t send(const char* buffer, size_t len, Error* err) override;
+  size_t sendv(std::span<const std::string_view> bufs, Error* err) override;
   size_t receive(char* buffer, size_t len, Error* err,
                  int timeout = 0) override;
   void close() final;
@@ -0,0 +1,163 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/net/raw_socket_ostream.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "wpi/net/NetworkStream.hpp"
+#include "wpi/net/TCPAcceptor.h"
+#include "wpi/net/TCPConnector.h"
+#include "wpi/util/Logger.hpp"
+
+namespace wpi::net {
+
+namespace {
+
+// Accepts at most maxSend bytes per send call
+class MockStream : public NetworkStream {
+ public:
+  explicit MockStream(size_t maxSend) : m_maxSend{maxSend} {}
+
+  size_t send(const char* buffer, size_t len, Error* err) override {
+    ++sends;
+    len = std::min(len, m_maxSend);
+    if (len == 0) {
+      *err = Error::CONNECTION_RESET;
+    }
+    data.append(buffer, len);
+    return len;
+  }
+  size_t receive(char* buffer, size_t len, Error* err, int timeout) override {
+    return 0;
+  }
+  void close() override {}
+  std::string_view getPeerIP() const override { return {}; }
+  int getPeerPort() const override { return 0; }
+  void setNoDelay() override {}
+  bool setBlocking(bool enabled) override { return true; }
+  int getNativeHandle() const override { return -1; }
+
+  std::string data;
+  int sends = 0;
+
+ private:
+  size_t m_maxSend;
+};
+
+// Like MockStream, but sends across buffers in one call like TCPStream
+class MockVectorStream : public MockStream {
+ public:
+  using MockStream::MockStream;
+
+  size_t sendv(std::span<const std::string_view> bufs, Error* err) override {
+    ++sendvs;
+    std::string joined;
+    for (auto buf : bufs) {
+      joined += buf;
+    }
+    return send(joined.data(), joined.size(), err);
+  }
+
+  int sendvs = 0;
+};
+
+}  // namespace
+
+TEST_CASE("RawSocketOstreamTest Writev", "[net][ostream]") {
+  MockVectorStream stream{1024};
+  raw_socket_ostream os{stream, false};
+  os << "ab";
+  std::string_view bufs[] = {"cd", "", "efg"};
+  os.writev(bufs);
+  CHECK(stream.data == "abcdefg");
+  CHECK(stream.sendvs == 1);
+  CHECK_FALSE(os.has_error());
+}
+
+TEST_CASE("RawSocketOstreamTest WritevPartial", "[net][ostream]") {
+  std::string_view bufs[] = {"abc", "", "defgh", "i"};
+  for (size_t maxSend = 1; maxSend <= 9; ++maxSend) {
+    INFO("maxSend " << maxSend);
+    MockVectorStream vectorStream{maxSend};
+    raw_socket_ostream{vectorStream, false}.writev(bufs);
+    CHECK(vectorStream.data == "abcdefghi");
+    CHECK(vectorStream.sendvs ==
+          static_cast<int>((9 + maxSend - 1) / maxSend));
+
+    // the default sendv sends one buffer at a time
+    MockStream stream{maxSend};
+    raw_socket_ostream{stream, false}.writev(bufs);
+    CHECK(stream.data == "abcdefghi");
+  }
+}
+
+TEST_CASE("RawSocketOstreamTest WritevError", "[net][ostream]") {
+  MockVectorStream stream{0};
+  raw_socket_ostream os{stream, false};
+  std::string_view bufs[] = {"abc"};
+  os.writev(bufs);
+  CHECK(os.has_error());
+
+  // nothing to send isn't an error
+  MockVectorStream emptyStream{0};
+  raw_socket_ostream emptyOs{emptyStream, false};
+  std::string_view emptyBufs[] = {"", ""};
+  emptyOs.writev(emptyBufs);
+  CHECK_FALSE(emptyOs.has_error());
+  CHECK(emptyStream.sendvs == 0);
+}
+
+TEST_CASE("RawSocketOstreamTest TCPWritev", "[net][ostream]") {
+  wpi::util::Logger logger;
+  std::unique_ptr<TCPAcceptor> acceptor;
+  int port = 0;
+  for (int i = 0; i < 20; ++i) {
+    port = 35000 + i * 97;
+    acceptor = std::make_unique<TCPAcceptor>(port, "127.0.0.1", logger);
+    if (acceptor->start() == 0) {
+      break;
+    }
+    acceptor.reset();
+  }
+  REQUIRE(acceptor);
+
+  auto client = TCPConnector::connect("127.0.0.1", port, logger, 1);
+  REQUIRE(client);
+  auto server = acceptor->accept();
+  REQUIRE(server);
+
+  // write from another thread in case it doesn't fit in the socket buffers
+  std::string large(100000, 'x');
+  bool error = true;
+  std::thread writer{[&] {
+    std::string_view bufs[] = {"head", large, "tail"};
+    raw_socket_ostream os{*client, true};
+    os.writev(bufs);
+    error = os.has_error();
+  }};
+
+  std::string received;
+  char buf[4096];
+  for (;;) {
+    NetworkStream::Error err;
+    size_t count = server->receive(buf, sizeof(buf), &err, 1);
+    if (count == 0) {
+      break;
+    }
+    received.append(buf, count);
+  }
+  writer.join();
+  CHECK_FALSE(error);
+  CHECK(received == "head" + large + "tail");
+}
+
+}  // namespace wpi::net
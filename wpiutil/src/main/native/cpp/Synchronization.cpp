@@ -4,10 +4,24 @@
 
 #include "wpi/util/Synchronization.hpp"
 
+#include <stdint.h>
+
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <mutex>
+#include <optional>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <ctime>
+#endif
 
 #include "wpi/util/DenseMap.hpp"
 #include "wpi/util/SmallVector.hpp"
@@ -31,22 +45,105 @@ static std::atomic_int gActive{0};
 
 namespace {
 
+using Deadline = std::optional<std::chrono::steady_clock::time_point>;
+
+// A waiting thread. A thread waiting on several objects registers the same
+// waiter with each of them, so it can be woken by any of them while only
+// sleeping on its own state. The sequence number is bumped on each
+// notification; read it before checking the objects, and wait on that value,
+// so notifications in between aren't lost.
+class Waiter {
+ public:
+  uint32_t GetSequence() const { return m_seq.load(std::memory_order_acquire); }
+
+#ifdef __linux__
+  // The sequence number is used directly as a futex word.
+  void Notify() {
+    m_seq.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, FutexWord(), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr,
+            0);
+  }
+
+  // Returns false on timeout. May return true spuriously.
+  bool Wait(uint32_t seq, const Deadline& deadline) {
+    timespec ts;
+    timespec* tsp = nullptr;
+    if (deadline) {
+      auto remaining = *deadline - std::chrono::steady_clock::now();
+      if (remaining <= std::chrono::steady_clock::duration::zero()) {
+        return GetSequence() != seq;
+      }
+      auto sec = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+      ts.tv_sec = sec.count();
+      ts.tv_nsec =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - sec)
+              .count();
+      tsp = &ts;
+    }
+    return syscall(SYS_futex, FutexWord(), FUTEX_WAIT_PRIVATE, seq, tsp,
+                   nullptr, 0) == 0 ||
+           errno != ETIMEDOUT;
+  }
+
+ private:
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                std::atomic<uint32_t>::is_always_lock_free);
+
+  uint32_t* FutexWord() { return reinterpret_cast<uint32_t*>(&m_seq); }
+#else
+  void Notify() {
+    {
+      std::scoped_lock lock{m_mutex};
+      m_seq.fetch_add(1, std::memory_order_release);
+    }
+    m_cv.notify_one();
+  }
+
+  // Returns false on timeout.
+  bool Wait(uint32_t seq, const Deadline& deadline) {
+    std::unique_lock lock{m_mutex};
+    auto notified = [&] { return GetSequence() != seq; };
+    if (!deadline) {
+      m_cv.wait(lock, notified);
+      return true;
+    }
+    return m_cv.wait_until(lock, *deadline, notified);
+  }
+
+ private:
+  wpi::util::mutex m_mutex;
+  wpi::util::condition_variable m_cv;
+#endif
+
+  std::atomic<uint32_t> m_seq{0};
+};
+
 struct State {
   int signaled{0};
+  int maxCount{INT_MAX};
   bool autoReset{false};
-  wpi::util::SmallVector<wpi::util::condition_variable*, 2> waiters;
+  wpi::util::SmallVector<Waiter*, 2> waiters;
+};
+
+// The handle to state map is split into shards, each with its own lock, so
+// operations on different handles rarely contend with each other.
+struct alignas(64) Shard {
+  wpi::util::mutex mutex;
+  wpi::util::DenseMap<WPI_Handle, State> states;
 };
 
 struct HandleManager {
+  static constexpr size_t kNumShards = 16;
+
   ~HandleManager() {
     gActive.fetch_add(INT_MIN / 2);
 
     // wake up all waiters
-    {
-      std::scoped_lock lock{mutex};
-      for (auto&& [handle, state] : states) {
+    for (auto&& shard : shards) {
+      std::scoped_lock lock{shard.mutex};
+      for (auto&& [handle, state] : shard.states) {
         for (auto&& waiter : state.waiters) {
-          waiter->notify_all();
+          waiter->Notify();
         }
       }
     }
@@ -67,10 +164,16 @@ struct HandleManager {
     }
 #endif
   }
+
+  Shard& GetShard(WPI_Handle handle) {
+    return shards[DenseMapInfo<WPI_Handle>::getHashValue(handle) % kNumShards];
+  }
+
+  // protects eventIds and semaphoreIds
   wpi::util::mutex mutex;
   wpi::util::UidVector<int, 8> eventIds;
   wpi::util::UidVector<int, 8> semaphoreIds;
-  wpi::util::DenseMap<WPI_Handle, State> states;
+  std::array<Shard, kNumShards> shards;
 };
 
 class ManagerGuard {
@@ -103,13 +206,17 @@ WPI_EventHandle wpi::util::MakeEvent(bool manualReset, bool initialState) {
     return {};
   }
   auto& manager = guard.GetManager();
-  std::scoped_lock lock{manager.mutex};
-
-  auto index = manager.eventIds.emplace_back(0);
-  WPI_EventHandle handle = (HANDLE_TYPE_EVENT << 24) | (index & 0xffffff);
+  WPI_EventHandle handle;
+  {
+    std::scoped_lock lock{manager.mutex};
+    auto index = manager.eventIds.emplace_back(0);
+    handle = (HANDLE_TYPE_EVENT << 24) | (index & 0xffffff);
+  }
 
   // configure state data
-  auto& state = manager.states[handle];
+  auto& shard = manager.GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto& state = shard.states[handle];
   state.signaled = initialState ? 1 : 0;
   state.autoReset = !manualReset;
   return handle;
@@ -154,14 +261,19 @@ WPI_SemaphoreHandle wpi::util::MakeSemaphore(int initialCount,
     return {};
   }
   auto& manager = guard.GetManager();
-  std::scoped_lock lock{manager.mutex};
-
-  auto index = manager.semaphoreIds.emplace_back(maximumCount);
-  WPI_EventHandle handle = (HANDLE_TYPE_SEMAPHORE << 24) | (index & 0xffffff);
+  WPI_SemaphoreHandle handle;
+  {
+    std::scoped_lock lock{manager.mutex};
+    auto index = manager.semaphoreIds.emplace_back(maximumCount);
+    handle = (HANDLE_TYPE_SEMAPHORE << 24) | (index & 0xffffff);
+  }
 
   // configure state data
-  auto& state = manager.states[handle];
+  auto& shard = manager.GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto& state = shard.states[handle];
   state.signaled = initialCount;
+  state.maxCount = maximumCount;
   state.autoReset = true;
 
   return handle;
@@ -191,29 +303,27 @@ bool wpi::util::ReleaseSemaphore(WPI_SemaphoreHandle handle, int releaseCount,
   if (releaseCount <= 0) {
     return false;
   }
-  int index = handle & 0xffffff;
 
   ManagerGuard guard;
   if (!guard) {
     return true;
   }
-  auto& manager = guard.GetManager();
-  std::scoped_lock lock{manager.mutex};
-  auto it = manager.states.find(handle);
-  if (it == manager.states.end()) {
+  auto& shard = guard.GetManager().GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto it = shard.states.find(handle);
+  if (it == shard.states.end()) {
     return false;
   }
   auto& state = it->second;
-  int maxCount = manager.semaphoreIds[index];
   if (prevCount) {
     *prevCount = state.signaled;
   }
-  if ((maxCount - state.signaled) < releaseCount) {
+  if ((state.maxCount - state.signaled) < releaseCount) {
     return false;
   }
   state.signaled += releaseCount;
   for (auto& waiter : state.waiters) {
-    waiter->notify_all();
+    waiter->Notify();
   }
   return true;
 }
@@ -249,16 +359,25 @@ std::span<WPI_Handle> wpi::util::WaitForObjects(
     return {};
   }
   auto& manager = guard.GetManager();
-  std::unique_lock lock{manager.mutex};
-  wpi::util::condition_variable cv;
+  Waiter waiter;
+  Deadline deadline;
+  if (timeout > 0) {
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                   std::chrono::duration<double>(timeout));
+  }
   bool addedWaiters = false;
   bool timedOutVal = false;
   size_t count = 0;
 
   for (;;) {
+    uint32_t seq = waiter.GetSequence();
+
     for (auto handle : handles) {
-      auto it = manager.states.find(handle);
-      if (it == manager.states.end()) {
+      auto& shard = manager.GetShard(handle);
+      std::scoped_lock lock{shard.mutex};
+      auto it = shard.states.find(handle);
+      if (it == shard.states.end()) {
         if (count < signaled.size()) {
           // treat a non-existent handle as signaled, but set the error bit
           signaled[count++] = handle | 0x80000000ul;
@@ -291,9 +410,16 @@ std::span<WPI_Handle> wpi::util::WaitForObjects(
     if (!addedWaiters) {
       addedWaiters = true;
       for (auto handle : handles) {
-        auto& state = manager.states[handle];
-        state.waiters.emplace_back(&cv);
+        auto& shard = manager.GetShard(handle);
+        std::scoped_lock lock{shard.mutex};
+        auto it = shard.states.find(handle);
+        if (it != shard.states.end()) {
+          it->second.waiters.emplace_back(&waiter);
+        }
       }
+      // each handle is locked separately, so check again for anything
+      // signaled or destroyed before the waiter was added
+      continue;
     }
 
     if (gActive.load(std::memory_order_acquire) < 0) {
@@ -303,14 +429,8 @@ std::span<WPI_Handle> wpi::util::WaitForObjects(
       break;
     }
 
-    if (timeout < 0) {
-      cv.wait(lock);
-    } else {
-      auto timeoutTime = std::chrono::steady_clock::now() +
-                         std::chrono::duration<double>(timeout);
-      if (cv.wait_until(lock, timeoutTime) == std::cv_status::timeout) {
-        timedOutVal = true;
-      }
+    if (!waiter.Wait(seq, deadline)) {
+      timedOutVal = true;
     }
 
     if (gActive.load(std::memory_order_acquire) < 0) {
@@ -323,11 +443,27 @@ std::span<WPI_Handle> wpi::util::WaitForObjects(
 
   if (addedWaiters) {
     for (auto handle : handles) {
-      auto& state = manager.states[handle];
-      auto it = std::find(state.waiters.begin(), state.waiters.end(), &cv);
+      auto& shard = manager.GetShard(handle);
+      std::scoped_lock lock{shard.mutex};
+      auto stateIt = shard.states.find(handle);
+      if (stateIt == shard.states.end()) {
+        continue;
+      }
+      auto& state = stateIt->second;
+      auto it = std::find(state.waiters.begin(), state.waiters.end(), &waiter);
       if (it != state.waiters.end()) {
         state.waiters.erase(it);
       }
+      // SetSignalObject only wakes the first waiter on an auto-reset object;
+      // if this waiter leaves it signaled (e.g. it timed out or consumed a
+      // different handle), pass the wakeup on so it isn't lost
+      if (state.autoReset) {
+        int toWake = state.signaled;
+        for (auto w = state.waiters.begin();
+             toWake > 0 && w != state.waiters.end(); ++w, --toWake) {
+          (*w)->Notify();
+        }
+      }
     }
   }
 
@@ -344,9 +480,9 @@ void wpi::util::CreateSignalObject(WPI_Handle handle, bool manualReset,
   if (!guard) {
     return;
   }
-  auto& manager = guard.GetManager();
-  std::scoped_lock lock{manager.mutex};
-  auto& state = manager.states[handle];
+  auto& shard = guard.GetManager().GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto& state = shard.states[handle];
   state.signaled = initialState ? 1 : 0;
   state.autoReset = !manualReset;
 }
@@ -356,16 +492,16 @@ void wpi::util::SetSignalObject(WPI_Handle handle) {
   if (!guard) {
     return;
   }
-  auto& manager = guard.GetManager();
-  std::scoped_lock lock{manager.mutex};
-  auto it = manager.states.find(handle);
-  if (it == manager.states.end()) {
+  auto& shard = guard.GetManager().GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto it = shard.states.find(handle);
+  if (it == shard.states.end()) {
     return;
   }
   auto& state = it->second;
   state.signaled = 1;
   for (auto& waiter : state.waiters) {
-    waiter->notify_all();
+    waiter->Notify();
     if (state.autoReset) {
       // expect the first waiter to reset it
       break;
@@ -378,10 +514,10 @@ void wpi::util::ResetSignalObject(WPI_Handle handle) {
   if (!guard) {
     return;
   }
-  auto& manager = guard.GetManager();
-  std::scoped_lock lock{manager.mutex};
-  auto it = manager.states.find(handle);
-  if (it != manager.states.end()) {
+  auto& shard = guard.GetManager().GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto it = shard.states.find(handle);
+  if (it != shard.states.end()) {
     it->second.signaled = 0;
   }
 }
@@ -391,16 +527,16 @@ void wpi::util::DestroySignalObject(WPI_Handle handle) {
   if (!guard) {
     return;
   }
-  auto& manager = guard.GetManager();
-  std::scoped_lock lock{manager.mutex};
+  auto& shard = guard.GetManager().GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
 
-  auto it = manager.states.find(handle);
-  if (it != manager.states.end()) {
+  auto it = shard.states.find(handle);
+  if (it != shard.states.end()) {
     // wake up any waiters
     for (auto& waiter : it->second.waiters) {
-      waiter->notify_all();
+      waiter->Notify();
     }
-    manager.states.erase(it);
+    shard.states.erase(it);
   }
 }
 
@@ -4,7 +4,10 @@
 
 #include "wpi/util/Synchronization.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -22,6 +25,72 @@ TEST_CASE("EventTest AutoReset", "[wpiutil]") {
   REQUIRE(timedOut == true);
 }
 
+TEST_CASE("EventTest AutoResetWakesEachWaiter", "[wpiutil]") {
+  auto event = wpi::util::MakeEvent(false, false);
+  std::atomic<int> count{0};
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < 4; ++i) {
+    waiters.emplace_back([&] {
+      if (wpi::util::WaitForObject(event, 5, nullptr)) {
+        ++count;
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // each set releases exactly one waiter
+  for (int i = 1; i <= 4; ++i) {
+    wpi::util::SetEvent(event);
+    while (count < i) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    REQUIRE(count == i);
+  }
+  for (auto& thr : waiters) {
+    thr.join();
+  }
+  wpi::util::DestroyEvent(event);
+}
+
+TEST_CASE("EventTest AutoResetTimeoutRace", "[wpiutil]") {
+  // a waiter timing out just as the event is set must not swallow the wakeup
+  // meant for the other waiters
+  for (int i = 0; i < 200; ++i) {
+    auto event = wpi::util::MakeEvent(false, false);
+    std::atomic<int> count{0};
+    bool shortSignaled = false;
+    std::thread shortWaiter([&] {
+      if (wpi::util::WaitForObject(event, 0.001, nullptr)) {
+        shortSignaled = true;
+        ++count;
+      }
+    });
+    std::thread longWaiter([&] {
+      if (wpi::util::WaitForObject(event, 5, nullptr)) {
+        ++count;
+      }
+    });
+    std::this_thread::sleep_for(std::chrono::microseconds(500 + 5 * i));
+    wpi::util::SetEvent(event);
+    shortWaiter.join();
+
+    // exactly one waiter gets the signal
+    while (count < 1) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    REQUIRE(count == 1);
+
+    // if the short waiter got it, the long waiter is still waiting; release it
+    if (shortSignaled) {
+      wpi::util::SetEvent(event);
+    }
+    longWaiter.join();
+    REQUIRE(count == (shortSignaled ? 2 : 1));
+    wpi::util::DestroyEvent(event);
+  }
+}
+
 TEST_CASE("EventTest ManualReset", "[wpiutil]") {
   auto event = wpi::util::MakeEvent(true, false);
   int done = 0;
@@ -59,3 +128,41 @@ TEST_CASE("EventTest WaitMultiple", "[wpiutil]") {
   REQUIRE(timedOut == true);
   REQUIRE(result2.size() == 0u);
 }
+
+TEST_CASE("EventTest WaitTimeout", "[wpiutil]") {
+  auto event = wpi::util::MakeEvent(false, false);
+  bool timedOut;
+  REQUIRE_FALSE(wpi::util::WaitForObject(event, 0.01, &timedOut));
+  REQUIRE(timedOut == true);
+  wpi::util::DestroyEvent(event);
+}
+
+TEST_CASE("EventTest DestroyWakesWaiter", "[wpiutil]") {
+  auto event = wpi::util::MakeEvent(false, false);
+  std::thread thr([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    wpi::util::DestroyEvent(event);
+  });
+  bool timedOut;
+  // a destroyed handle is signaled with an error
+  REQUIRE_FALSE(wpi::util::WaitForObject(event, 10, &timedOut));
+  REQUIRE(timedOut == false);
+  thr.join();
+}
+
+TEST_CASE("SemaphoreTest Release", "[wpiutil]") {
+  auto semaphore = wpi::util::MakeSemaphore(0, 2);
+  std::thread thr([&] { wpi::util::ReleaseSemaphore(semaphore, 2); });
+  REQUIRE(wpi::util::WaitForObject(semaphore));
+  thr.join();
+  REQUIRE(wpi::util::WaitForObject(semaphore));
+  bool timedOut;
+  REQUIRE_FALSE(wpi::util::WaitForObject(semaphore, 0, &timedOut));
+  REQUIRE(timedOut == true);
+  int prevCount;
+  REQUIRE(wpi::util::ReleaseSemaphore(semaphore, 2, &prevCount));
+  REQUIRE(prevCount == 0);
+  REQUIRE_FALSE(wpi::util::ReleaseSemaphore(semaphore, 1, &prevCount));
+  REQUIRE(prevCount == 2);
+  wpi::util::DestroySemaphore(semaphore);
+}
@@ -5,6 +5,7 @@
 #include "wpi/util/circular_buffer.hpp"
 
 #include <array>
+#include <utility>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -123,6 +124,8 @@ TEST_CASE("CircularBufferTest Reset", "[wpiutil]") {
   queue.reset();
 
   CHECK(queue.size() == size_t{0});
+  CHECK(queue.empty());
+  CHECK(queue.capacity() == size_t{5});
 }
 
 TEST_CASE("CircularBufferTest Resize", "[wpiutil]") {
@@ -231,6 +234,27 @@ TEST_CASE("CircularBufferTest Resize", "[wpiutil]") {
   CHECK(3.0 == queue[3]);
 }
 
+TEST_CASE("CircularBufferTest ResizeFullNonArithmetic", "[wpiutil]") {
+  wpi::util::circular_buffer<std::pair<int, double>> queue(3);
+
+  for (int i = 0; i < 5; ++i) {
+    queue.emplace_back(i, i * 0.5);
+  }
+  REQUIRE(queue.size() == size_t{3});
+
+  // Growing a full buffer whose front isn't at index 0 keeps element order
+  queue.resize(6);
+  CHECK(queue.capacity() == size_t{6});
+  REQUIRE(queue.size() == size_t{3});
+  for (size_t i = 0; i < queue.size(); ++i) {
+    CHECK(queue[i].first == static_cast<int>(i) + 2);
+  }
+
+  queue.emplace_back(5, 2.5);
+  CHECK(queue.size() == size_t{4});
+  CHECK(queue.back().first == 5);
+}
+
 TEST_CASE("CircularBufferTest Iterator", "[wpiutil]") {
   wpi::util::circular_buffer<double> queue(3);
 
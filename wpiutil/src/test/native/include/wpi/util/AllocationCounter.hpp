@@ -0,0 +1,19 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+namespace wpi::util {
+
+/**
+ * Returns the number of times operator new has been called in this process.
+ * Memory that libraries allocate with malloc() directly (e.g., Eigen's
+ * dynamic-size matrices) isn't counted. Always returns 0 in address and thread
+ * sanitizer builds, as the sanitizers replace operator new themselves.
+ */
+size_t GetAllocationCount();
+
+}  // namespace wpi::util
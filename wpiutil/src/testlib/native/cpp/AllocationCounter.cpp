@@ -0,0 +1,95 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/util/AllocationCounter.hpp"
+
+#include <stddef.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define NO_ALLOCATION_COUNT
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define NO_ALLOCATION_COUNT
+#endif
+#endif
+
+#ifdef NO_ALLOCATION_COUNT
+
+size_t wpi::util::GetAllocationCount() {
+  return 0;
+}
+
+#else
+
+namespace {
+std::atomic<size_t> gAllocationCount{0};
+
+void* AlignedAlloc(size_t size, size_t alignment) {
+#ifdef _WIN32
+  return _aligned_malloc(size, alignment);
+#else
+  // aligned_alloc() requires the size to be a multiple of the alignment
+  size = (size + alignment - 1) / alignment * alignment;
+  return std::aligned_alloc(alignment, size);
+#endif
+}
+
+void AlignedFree(void* ptr) {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+}  // namespace
+
+size_t wpi::util::GetAllocationCount() {
+  return gAllocationCount.load(std::memory_order_relaxed);
+}
+
+// Replace the global allocation functions so tests and benchmarks can count
+// the heap allocations they make. The array and nothrow forms forward to these
+// by default.
+void* operator new(size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  auto align = static_cast<size_t>(alignment);
+  if (void* ptr = AlignedAlloc(size == 0 ? align : size, align)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+
+#endif  // NO_ALLOCATION_COUNT